@@ -0,0 +1,716 @@
+// Native microbenchmark for the decimal core. Doesn't need Godot, so the numbers
+// aren't buried under Callable/interpreter overhead like in tests/bm.gd.
+//
+// Every op runs over a fixed, seeded batch of inputs for each distribution. One
+// sample is one pass over the batch, and the reported figures are ns/op
+// percentiles over all samples.
+//
+// usage: decimal_bench [--json FILE] [--samples N] [--batch N] [--seed N]
+//                      [--filter TEXT] [--kernel scalar|sse4.2|avx2|avx512]
+
+#include "decimal_compact.hpp"
+#include "decimal_core.hpp"
+#include "decimal_curves.hpp"
+#include "decimal_fastmath.hpp"
+#include "decimal_format.hpp"
+#include "decimal_formula.hpp"
+#include "decimal_parallel.hpp"
+#include "decimal_precision.hpp"
+#include "decimal_price_table.hpp"
+#include "decimal_simd.hpp"
+#include "decimal_sort.hpp"
+#include "decimal_stat_graph.hpp"
+#include "decimal_string.hpp"
+#include "decimal_sum.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace core = decimal_core;
+namespace precision = decimal_precision;
+
+using Decimal32 = BasicDecimal<float>;
+using Decimal128 = BasicDecimal<precision::DoubleDouble>;
+
+namespace {
+
+// Keeps the compiler from throwing away results we never read.
+template <typename T>
+inline auto keep(const T &value) -> void {
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "g"(&value) : "memory");
+#else
+	static volatile char sink;
+	sink = *reinterpret_cast<const volatile char *>(&value);
+#endif
+}
+
+// splitmix64, so the inputs are the same on every platform and standard library
+struct Rng {
+	uint64_t state;
+
+	auto next() -> uint64_t {
+		uint64_t z = (state += 0x9e3779b97f4a7c15);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+		return z ^ (z >> 31);
+	}
+
+	// [0, 1)
+	auto unit() -> double {
+		return static_cast<double>(next() >> 11) * 0x1.0p-53;
+	}
+
+	// [lo, hi]
+	auto range(const int64_t lo, const int64_t hi) -> int64_t {
+		return lo + static_cast<int64_t>(next() % static_cast<uint64_t>(hi - lo + 1));
+	}
+
+	auto mantissa() -> double {
+		return 1.0 + unit() * 9.0;
+	}
+};
+
+struct Inputs {
+	std::vector<DecimalData> a;
+	std::vector<DecimalData> b;
+	std::vector<double> n;
+	std::vector<int64_t> k;
+
+	// `a` and `b` in the other mantissa types
+	std::vector<Decimal32> a32;
+	std::vector<Decimal32> b32;
+	std::vector<Decimal128> a128;
+	std::vector<Decimal128> b128;
+
+	// `a` in the compact layouts, and the output for their batch ops
+	std::vector<Compact8> a8;
+	std::vector<Compact12> a12;
+	std::vector<Compact8> out8;
+	std::vector<Compact12> out12;
+
+	// scratch output for the batch kernels
+	std::vector<DecimalData> out;
+};
+
+enum class Distribution {
+	CLOSE,
+	FAR,
+	NEGATIVE,
+	NEAR_ZERO,
+};
+
+constexpr const Distribution DISTRIBUTIONS[] = {
+	Distribution::CLOSE,
+	Distribution::FAR,
+	Distribution::NEGATIVE,
+	Distribution::NEAR_ZERO,
+};
+
+auto distribution_name(const Distribution dist) -> const char * {
+	switch (dist) {
+		case Distribution::CLOSE: return "close";
+		case Distribution::FAR: return "far";
+		case Distribution::NEGATIVE: return "negative";
+		case Distribution::NEAR_ZERO: return "near_zero";
+	}
+	return "?";
+}
+
+auto generate(const Distribution dist, const size_t batch, const uint64_t seed) -> Inputs {
+	// every distribution gets its own stream, so filtering doesn't shift the inputs
+	Rng rng { seed ^ (0x5851f42d4c957f2d * (static_cast<uint64_t>(dist) + 1)) };
+
+	Inputs in;
+	in.a.resize(batch);
+	in.b.resize(batch);
+	in.n.resize(batch);
+	in.k.resize(batch);
+	in.out.resize(batch);
+	in.a8.resize(batch);
+	in.a12.resize(batch);
+	in.out8.resize(batch);
+	in.out12.resize(batch);
+
+	for (size_t i = 0; i < batch; i++) {
+		auto &a = in.a[i];
+		auto &b = in.b[i];
+
+		switch (dist) {
+			// exponents within MAX_SIGNIFICANT_DIGITS of each other, so addition
+			// has to actually line the mantissas up
+			case Distribution::CLOSE: {
+				const auto e = rng.range(-1000000, 1000000);
+				a = DecimalData(rng.mantissa(), e);
+				b = DecimalData(rng.mantissa(), e + rng.range(-8, 8));
+				in.n[i] = 0.5 + rng.unit() * 7.5;
+			} break;
+
+			// far enough apart that the smaller one gets discarded
+			case Distribution::FAR: {
+				const auto e = rng.range(-1000000, 1000000);
+				const auto gap = rng.range(MAX_SIGNIFICANT_DIGITS, 100000);
+				a = DecimalData(rng.mantissa(), e);
+				b = DecimalData(rng.mantissa(), (rng.next() & 1) ? e + gap : e - gap);
+				in.n[i] = 0.5 + rng.unit() * 7.5;
+			} break;
+
+			// close exponents with random signs, so about half the additions cancel
+			case Distribution::NEGATIVE: {
+				const auto e = rng.range(-1000000, 1000000);
+				const double s1 = (rng.next() & 1) ? 1.0 : -1.0;
+				const double s2 = (rng.next() & 1) ? 1.0 : -1.0;
+				a = DecimalData(s1 * rng.mantissa(), e);
+				b = DecimalData(s2 * rng.mantissa(), e + rng.range(-8, 8));
+				in.n[i] = -(0.5 + rng.unit() * 7.5);
+			} break;
+
+			// tiny magnitudes around where doubles go subnormal, with some exact
+			// zeros and near-cancelling pairs mixed in
+			case Distribution::NEAR_ZERO: {
+				const auto roll = rng.range(0, 7);
+				a = DecimalData(rng.mantissa(), rng.range(-330, -290));
+				if (roll == 0) {
+					a = core::DECIMAL_ZERO;
+					b = DecimalData(rng.mantissa(), rng.range(-330, -290));
+				} else if (roll == 1) {
+					b = core::DECIMAL_ZERO;
+				} else if (roll < 4) {
+					b = DecimalData(-a.mantissa * (1.0 + rng.unit() * 1e-12), a.exponent);
+				} else {
+					b = DecimalData(rng.mantissa(), rng.range(-330, -290));
+				}
+				in.n[i] = rng.mantissa() * core::pow10(rng.range(-320, -300));
+			} break;
+		}
+
+		in.k[i] = rng.range(0, 1000);
+	}
+
+	for (size_t i = 0; i < batch; i++) {
+		in.a32.push_back(precision::from_decimal<float>(in.a[i]));
+		in.b32.push_back(precision::from_decimal<float>(in.b[i]));
+		in.a128.push_back(precision::from_decimal<precision::DoubleDouble>(in.a[i]));
+		in.b128.push_back(precision::from_decimal<precision::DoubleDouble>(in.b[i]));
+	}
+	decimal_compact::from_decimals(in.a.data(), static_cast<int64_t>(batch), in.a8.data());
+	decimal_compact::from_decimals(in.a.data(), static_cast<int64_t>(batch), in.a12.data());
+
+	return in;
+}
+
+struct Case {
+	const char *name;
+	void (*run)(Inputs &in);
+};
+
+// The op gets inlined into the loop, with `a`, `b`, `n` and `k` in scope.
+#define BENCH_OP(_name, _expr) \
+	Case { _name, [](Inputs &in) { \
+		const auto count = in.a.size(); \
+		for (size_t i = 0; i < count; i++) { \
+			const auto &a = in.a[i]; \
+			const auto &b = in.b[i]; \
+			const auto n = in.n[i]; \
+			const auto k = in.k[i]; \
+			(void)a; (void)b; (void)n; (void)k; \
+			keep(_expr); \
+		} \
+	} }
+
+// BENCH_OP, but `a` and `b` come from the inputs converted to another mantissa
+// type, a32/b32 or a128/b128.
+#define BENCH_PRECISION(_name, _bits, _expr) \
+	Case { _name, [](Inputs &in) { \
+		const auto count = in.a##_bits.size(); \
+		for (size_t i = 0; i < count; i++) { \
+			const auto &a = in.a##_bits[i]; \
+			const auto &b = in.b##_bits[i]; \
+			const auto n = in.n[i]; \
+			(void)a; (void)b; (void)n; \
+			keep(_expr); \
+		} \
+	} }
+
+// The batch kernels take the whole array in one call.
+#define BENCH_BATCH(_name, _call) \
+	Case { _name, [](Inputs &in) { \
+		const auto count = static_cast<int64_t>(in.a.size()); \
+		const auto *a = in.a.data(); \
+		const auto *b = in.b.data(); \
+		auto *out = in.out.data(); \
+		(void)a; (void)b; \
+		_call; \
+		keep(out[count - 1]); \
+	} }
+
+const DecimalData RATIO = core::from_float(1.15);
+const DecimalData PRICE_ADD = core::from_float(5.0);
+const auto GEOMETRIC_CURVE = decimal_curves::make_geometric(core::from_float(10.0), RATIO);
+const auto ARITHMETIC_CURVE = decimal_curves::make_arithmetic(core::from_float(10.0), PRICE_ADD);
+
+// the geometric curve with its costs written down (k only goes up to 1000)
+auto GEOMETRIC_TABLE = [] {
+	auto t = decimal_price_table::make(GEOMETRIC_CURVE, 2048);
+	decimal_price_table::fill(t, 2048);
+	return t;
+}();
+
+// a * b + a / 2 - b, with the multiply-add fused
+const auto FORMULA = [] {
+	const char text[] = "a * b + a / 2 - b";
+	decimal_formula::Program p;
+	decimal_formula::compile(text, sizeof(text) - 1, { "a", "b" }, p);
+	return p;
+}();
+std::vector<DecimalData> FORMULA_STACK;
+
+auto formula_one(const DecimalData &a, const DecimalData &b) -> DecimalData {
+	const DecimalData values[] = { a, b };
+	return decimal_formula::run_one(FORMULA, values, FORMULA_STACK);
+}
+
+auto formula_batch(const DecimalData *a, const DecimalData *b, DecimalData *out, const int64_t count) -> void {
+	const DecimalData *columns[] = { a, b };
+	decimal_formula::run(FORMULA, columns, 0, count, out, FORMULA_STACK);
+}
+
+// One source per element with a derived "s * 1.5 + 2" on each, where 1% of
+// the sources change every pass. Updating only recomputes what they feed,
+// recompute_all is what a plain per-frame pipeline does.
+decimal_stat_graph::Graph STAT_GRAPH;
+int64_t STAT_GRAPH_NEXT = 0;
+
+auto stat_graph_set(const DecimalData *a, const int64_t count) -> void {
+	namespace stat_graph = decimal_stat_graph;
+	if (static_cast<int64_t>(STAT_GRAPH.nodes.size()) != 2 * count) {
+		const char text[] = "s * 1.5 + 2";
+		decimal_formula::Program p;
+		decimal_formula::compile(text, sizeof(text) - 1, { "s" }, p);
+		stat_graph::clear(STAT_GRAPH);
+		for (int64_t i = 0; i < count; i++) {
+			stat_graph::add_source(STAT_GRAPH, a[i]);
+		}
+		for (int64_t i = 0; i < count; i++) {
+			stat_graph::add_derived(STAT_GRAPH, p, { i });
+		}
+		stat_graph::update_all(STAT_GRAPH);
+	}
+
+	const auto changed = std::max<int64_t>(1, count / 100);
+	for (int64_t i = 0; i < changed; i++) {
+		const auto idx = STAT_GRAPH_NEXT++ % count;
+		stat_graph::set_value(STAT_GRAPH, idx, core::neg(STAT_GRAPH.values[idx]));
+	}
+}
+
+auto stat_graph_update(const DecimalData *a, DecimalData *out, const int64_t count) -> void {
+	stat_graph_set(a, count);
+	decimal_stat_graph::update_all(STAT_GRAPH);
+	out[count - 1] = STAT_GRAPH.values.back();
+}
+
+auto stat_graph_recompute_all(const DecimalData *a, DecimalData *out, const int64_t count) -> void {
+	stat_graph_set(a, count);
+	STAT_GRAPH.pending.clear();
+	for (auto i = count; i < 2 * count; i++) {
+		STAT_GRAPH.pending.push_back(i);
+	}
+	decimal_stat_graph::evaluate_pending(STAT_GRAPH);
+	STAT_GRAPH.dirty.clear();
+	out[count - 1] = STAT_GRAPH.values.back();
+}
+
+// summing a whole array, with the accumulator and with plain add() for comparison
+auto sum_accumulator(const DecimalData *a, DecimalData *out, const int64_t count) -> void {
+	decimal_sum::Accumulator acc;
+	acc.add_many(a, count);
+	out[count - 1] = acc.read();
+}
+
+auto sum_add(const DecimalData *a, DecimalData *out, const int64_t count) -> void {
+	auto total = core::DECIMAL_ZERO;
+	for (int64_t i = 0; i < count; i++) {
+		total = core::add(total, a[i]);
+	}
+	out[count - 1] = total;
+}
+
+// the same batch split over every hardware thread, no matter the batch size
+// (run with a larger --batch to see it scale)
+decimal_parallel::ThreadPool THREADS;
+
+auto threaded_pow_num(const DecimalData *a, DecimalData *out, const int64_t count) -> void {
+	decimal_parallel::for_each_chunk(THREADS, count, [&](const int64_t begin, const int64_t end) {
+		for (auto i = begin; i < end; i++) {
+			out[i] = core::pow_num(a[i], 1.5);
+		}
+	}, 0);
+}
+
+auto threaded_add(const DecimalData *a, const DecimalData *b, DecimalData *out, const int64_t count) -> void {
+	decimal_parallel::for_each_chunk(THREADS, count, [&](const int64_t begin, const int64_t end) {
+		decimal_simd::add(a + begin, b + begin, out + begin, end - begin);
+	}, 0);
+}
+
+// comparison masks, and the same thing with a ge() per element
+auto ge_mask(const DecimalData *a, const DecimalData *b, DecimalData *out, const int64_t count) -> void {
+	decimal_simd::ge_mask(a, b, reinterpret_cast<uint8_t *>(out), count);
+}
+
+auto ge_loop(const DecimalData *a, const DecimalData *b, DecimalData *out, const int64_t count) -> void {
+	auto *mask = reinterpret_cast<uint8_t *>(out);
+	for (int64_t i = 0; i < count; i += 8) {
+		uint8_t bits = 0;
+		for (int64_t j = i; j < std::min(i + 8, count); j++) {
+			bits |= static_cast<uint8_t>(core::ge(a[j], b[j]) << (j - i));
+		}
+		mask[i / 8] = bits;
+	}
+}
+
+// radix sort over the integer keys, and a comparison sort through cmp() for
+// comparison
+auto sort_radix(const DecimalData *a, DecimalData *out, const int64_t count) -> void {
+	decimal_sort::sort(a, count, out);
+}
+
+auto sort_compare(const DecimalData *a, DecimalData *out, const int64_t count) -> void {
+	std::copy(a, a + count, out);
+	std::stable_sort(out, out + count, [](const DecimalData &x, const DecimalData &y) { return core::cmp(x, y) < 0; });
+}
+
+std::vector<int64_t> TOP_K(100);
+
+auto top_k(const DecimalData *a, DecimalData *out, const int64_t count) -> void {
+	decimal_sort::top_k(a, count, static_cast<int64_t>(TOP_K.size()), TOP_K.data());
+	out[0] = a[TOP_K[0]];
+}
+
+// scans over the compact layouts, next to the same scan over DecimalData
+const DecimalData SCAN_THRESHOLD(5.0, 0);
+
+auto ge_scalar_mask(const DecimalData *a, DecimalData *out, const int64_t count) -> void {
+	decimal_simd::ge_scalar_mask(a, SCAN_THRESHOLD, reinterpret_cast<uint8_t *>(out), count);
+}
+
+template <typename C>
+auto compact_ge_scalar_mask(const std::vector<C> &a, DecimalData *out, const int64_t count) -> void {
+	decimal_compact::ge_scalar_mask(a.data(), SCAN_THRESHOLD, reinterpret_cast<uint8_t *>(out), count);
+}
+
+template <typename C>
+auto compact_sum(const std::vector<C> &a, DecimalData *out, const int64_t count) -> void {
+	out[count - 1] = decimal_compact::sum(a.data(), count);
+}
+
+template <typename C>
+auto compact_mul_num(const std::vector<C> &a, std::vector<C> &dst, DecimalData *out, const int64_t count) -> void {
+	decimal_compact::mul_num(a.data(), 1.5, dst.data(), count);
+	out[count - 1] = decimal_compact::to_decimal(dst[count - 1]);
+}
+
+char STRING_BUF[decimal_string::BUF_SIZE];
+const decimal_format::Settings SUFFIX_FORMAT;
+
+const Case CASES[] = {
+	BENCH_OP("from_float", core::from_float(n)),
+	BENCH_OP("from_parts_normalize", core::from_parts_normalize(a.mantissa * 123.0, a.exponent)),
+	BENCH_OP("into_float", core::into_float(a)),
+	BENCH_OP("normalize", core::normalize(DecimalData(a.mantissa * n, a.exponent))),
+	BENCH_OP("is_finite", core::is_finite(a)),
+
+	BENCH_OP("abs", core::abs(a)),
+	BENCH_OP("neg", core::neg(a)),
+	BENCH_OP("sign", core::sign(a)),
+
+	BENCH_OP("add", core::add(a, b)),
+	BENCH_OP("add_num", core::add_num(a, n)),
+	BENCH_OP("sub", core::sub(a, b)),
+	BENCH_OP("sub_num", core::sub_num(a, n)),
+	BENCH_OP("mul", core::mul(a, b)),
+	BENCH_OP("mul_num", core::mul_num(a, n)),
+	BENCH_OP("div", core::div(a, b)),
+	BENCH_OP("div_num", core::div_num(a, n)),
+	BENCH_OP("recip", core::recip(a)),
+
+	BENCH_OP("cmp", core::cmp(a, b)),
+	BENCH_OP("lt", core::lt(a, b)),
+	BENCH_OP("eq", core::eq(a, b)),
+	BENCH_OP("sort_key", decimal_sort::sort_key(a).lo),
+	BENCH_OP("min", core::min(a, b)),
+	BENCH_OP("max", core::max(a, b)),
+	BENCH_OP("clamp", core::clamp(a, core::min(b, core::DECIMAL_ZERO), core::max(b, core::DECIMAL_ZERO))),
+	BENCH_OP("eq_tolerance_abs", core::eq_tolerance_abs(a, b, core::DECIMAL_ONE)),
+	BENCH_OP("eq_tolerance_rel", core::eq_tolerance_rel(a, b, DecimalData(1.0, -9))),
+
+	BENCH_OP("floor", core::floor(DecimalData(a.mantissa, k % 20 - 2))),
+	BENCH_OP("ceil", core::ceil(DecimalData(a.mantissa, k % 20 - 2))),
+	BENCH_OP("trunc", core::trunc(DecimalData(a.mantissa, k % 20 - 2))),
+
+	BENCH_OP("log10", core::log10(a)),
+	BENCH_OP("abs_log10", core::abs_log10(a)),
+	BENCH_OP("log2", core::log2(a)),
+	BENCH_OP("ln", core::ln(a)),
+	BENCH_OP("log", core::log(a, 3.0)),
+
+	BENCH_OP("pow10_num", core::pow10_num(n * 1000.0)),
+	BENCH_OP("pow10_frac_libm", std::pow(10.0, a.mantissa * 0.1)),
+	BENCH_OP("pow10_frac_fast", decimal_fastmath::pow10_frac(a.mantissa * 0.1)),
+	BENCH_OP("log10_mantissa_libm", std::log10(1.0 + std::abs(a.mantissa) * 0.8)),
+	BENCH_OP("log10_mantissa_fast", decimal_fastmath::log10_mantissa(1.0 + std::abs(a.mantissa) * 0.8)),
+	BENCH_OP("pow_num", core::pow_num(a, n)),
+	BENCH_OP("pow", core::pow(a, DecimalData(n, 0))),
+	BENCH_OP("pow_int", core::pow(a, DecimalData(static_cast<double>(k % 1000), 0))),
+	BENCH_OP("exp", core::exp(DecimalData(n, 3))),
+	BENCH_OP("sqrt", core::sqrt(a)),
+	BENCH_OP("cbrt", core::cbrt(a)),
+	BENCH_OP("dp", core::dp(a)),
+
+	BENCH_OP("afford_geometric_series", core::afford_geometric_series(a, b, RATIO, k)),
+	BENCH_OP("sum_geometric_series", core::sum_geometric_series(k, a, RATIO, k)),
+	BENCH_OP("afford_arithmetic_series", core::afford_arithmetic_series(a, b, PRICE_ADD, core::from_float(static_cast<double>(k)))),
+	BENCH_OP("sum_arithmetic_series", core::sum_arithmetic_series(core::from_float(static_cast<double>(k)), a, PRICE_ADD, core::DECIMAL_ZERO)),
+	BENCH_OP("efficiency_of_purchase", core::efficiency_of_purchase(a, b, core::abs(a))),
+	BENCH_OP("curve_afford_geometric", decimal_curves::afford(GEOMETRIC_CURVE, a, k)),
+	BENCH_OP("curve_cost_geometric", decimal_curves::cost(GEOMETRIC_CURVE, k, k)),
+	BENCH_OP("curve_afford_arithmetic", decimal_curves::afford(ARITHMETIC_CURVE, a, k)),
+	BENCH_OP("curve_cost_arithmetic", decimal_curves::cost(ARITHMETIC_CURVE, k, k)),
+	BENCH_OP("curve_afford_geometric_in_table", decimal_curves::afford(GEOMETRIC_CURVE, DecimalData(a.mantissa, k % 60), k)),
+	BENCH_OP("table_afford_geometric", decimal_price_table::afford(GEOMETRIC_TABLE, DecimalData(a.mantissa, k % 60), k)),
+	BENCH_OP("table_cost_geometric", decimal_price_table::cost(GEOMETRIC_TABLE, k, k)),
+
+	BENCH_OP("formula_one", formula_one(a, b)),
+
+	BENCH_OP("to_string", decimal_string::to_string(a, STRING_BUF)),
+	BENCH_OP("to_exponential", decimal_string::to_exponential(a, -1, STRING_BUF)),
+	BENCH_OP("to_exponential_places", decimal_string::to_exponential(a, 4, STRING_BUF)),
+	BENCH_OP("format_suffix", decimal_format::format(a, SUFFIX_FORMAT, STRING_BUF)),
+
+	BENCH_PRECISION("f32_add", 32, precision::add(a, b)),
+	BENCH_PRECISION("f32_mul", 32, precision::mul(a, b)),
+	BENCH_PRECISION("f32_div", 32, precision::div(a, b)),
+	BENCH_PRECISION("f32_cmp", 32, precision::cmp(a, b)),
+	BENCH_PRECISION("f32_sqrt", 32, precision::sqrt(precision::abs(a))),
+	BENCH_PRECISION("f32_pow_num", 32, precision::pow_num(a, n)),
+	BENCH_PRECISION("f128_add", 128, precision::add(a, b)),
+	BENCH_PRECISION("f128_mul", 128, precision::mul(a, b)),
+	BENCH_PRECISION("f128_div", 128, precision::div(a, b)),
+	BENCH_PRECISION("f128_cmp", 128, precision::cmp(a, b)),
+	BENCH_PRECISION("f128_sqrt", 128, precision::sqrt(precision::abs(a))),
+	BENCH_PRECISION("f128_pow_num", 128, precision::pow_num(a, n)),
+
+	BENCH_BATCH("batch_normalize", decimal_simd::normalize(a, out, count)),
+	BENCH_BATCH("batch_add", decimal_simd::add(a, b, out, count)),
+	BENCH_BATCH("batch_sub", decimal_simd::sub(a, b, out, count)),
+	BENCH_BATCH("batch_mul", decimal_simd::mul(a, b, out, count)),
+	BENCH_BATCH("batch_mul_num", decimal_simd::mul_num(a, 1.5, out, count)),
+	BENCH_BATCH("batch_formula", formula_batch(a, b, out, count)),
+	BENCH_BATCH("stat_graph_update", stat_graph_update(a, out, count)),
+	BENCH_BATCH("stat_graph_recompute_all", stat_graph_recompute_all(a, out, count)),
+	BENCH_BATCH("batch_sum_accumulator", sum_accumulator(a, out, count)),
+	BENCH_BATCH("batch_sum_add", sum_add(a, out, count)),
+	BENCH_BATCH("threaded_add", threaded_add(a, b, out, count)),
+	BENCH_BATCH("threaded_pow_num", threaded_pow_num(a, out, count)),
+	BENCH_BATCH("batch_ge_mask", ge_mask(a, b, out, count)),
+	BENCH_BATCH("batch_ge_loop", ge_loop(a, b, out, count)),
+	BENCH_BATCH("sort_radix", sort_radix(a, out, count)),
+	BENCH_BATCH("sort_compare", sort_compare(a, out, count)),
+	BENCH_BATCH("top_k", top_k(a, out, count)),
+	BENCH_BATCH("batch_ge_scalar_mask", ge_scalar_mask(a, out, count)),
+	BENCH_BATCH("compact8_ge_scalar_mask", compact_ge_scalar_mask(in.a8, out, count)),
+	BENCH_BATCH("compact12_ge_scalar_mask", compact_ge_scalar_mask(in.a12, out, count)),
+	BENCH_BATCH("compact8_sum", compact_sum(in.a8, out, count)),
+	BENCH_BATCH("compact12_sum", compact_sum(in.a12, out, count)),
+	BENCH_BATCH("compact8_mul_num", compact_mul_num(in.a8, in.out8, out, count)),
+	BENCH_BATCH("compact12_mul_num", compact_mul_num(in.a12, in.out12, out, count)),
+};
+
+struct Result {
+	std::string op;
+	const char *distribution;
+	double min, p50, p90, p99, max, mean;
+};
+
+// nearest-rank percentile of an already sorted list
+auto percentile(const std::vector<double> &sorted, const double p) -> double {
+	const auto rank = static_cast<size_t>(p / 100.0 * static_cast<double>(sorted.size()) + 0.5);
+	return sorted[std::min(sorted.size() - 1, rank == 0 ? 0 : rank - 1)];
+}
+
+auto measure(const Case &c, Inputs &in, const Distribution dist, const int64_t samples) -> Result {
+	using Clock = std::chrono::steady_clock;
+
+	// one untimed pass to warm up caches and branch predictors
+	c.run(in);
+
+	std::vector<double> ns_per_op;
+	ns_per_op.reserve(samples);
+
+	for (int64_t s = 0; s < samples; s++) {
+		const auto start = Clock::now();
+		c.run(in);
+		const auto end = Clock::now();
+
+		const auto ns = std::chrono::duration<double, std::nano>(end - start).count();
+		ns_per_op.push_back(ns / static_cast<double>(in.a.size()));
+	}
+
+	double sum = 0;
+	for (const auto v : ns_per_op) sum += v;
+
+	std::sort(ns_per_op.begin(), ns_per_op.end());
+
+	return Result {
+		c.name,
+		distribution_name(dist),
+		ns_per_op.front(),
+		percentile(ns_per_op, 50),
+		percentile(ns_per_op, 90),
+		percentile(ns_per_op, 99),
+		ns_per_op.back(),
+		sum / static_cast<double>(ns_per_op.size()),
+	};
+}
+
+auto write_json(
+	const char *path,
+	const std::vector<Result> &results,
+	const uint64_t seed,
+	const size_t batch,
+	const int64_t samples
+) -> bool {
+	FILE *f = std::fopen(path, "w");
+	if (f == nullptr) return false;
+
+	std::fprintf(f, "{\n");
+	std::fprintf(f, "  \"format\": 1,\n");
+	std::fprintf(f, "  \"unit\": \"ns/op\",\n");
+	std::fprintf(f, "  \"kernel\": \"%s\",\n", decimal_simd::get_level_name());
+	std::fprintf(f, "  \"seed\": %llu,\n", static_cast<unsigned long long>(seed));
+	std::fprintf(f, "  \"batch\": %zu,\n", batch);
+	std::fprintf(f, "  \"samples\": %lld,\n", static_cast<long long>(samples));
+	std::fprintf(f, "  \"results\": [\n");
+
+	for (size_t i = 0; i < results.size(); i++) {
+		const auto &r = results[i];
+		std::fprintf(f,
+			"    {\"op\": \"%s\", \"distribution\": \"%s\", "
+			"\"min\": %.3f, \"p50\": %.3f, \"p90\": %.3f, \"p99\": %.3f, \"max\": %.3f, \"mean\": %.3f}%s\n",
+			r.op.c_str(), r.distribution,
+			r.min, r.p50, r.p90, r.p99, r.max, r.mean,
+			i + 1 < results.size() ? "," : ""
+		);
+	}
+
+	std::fprintf(f, "  ]\n}\n");
+	return std::fclose(f) == 0;
+}
+
+auto parse_level(const char *name, decimal_simd::Level &level) -> bool {
+	constexpr const decimal_simd::Level LEVELS[] = {
+		decimal_simd::Level::SCALAR,
+		decimal_simd::Level::SSE42,
+		decimal_simd::Level::AVX2,
+		decimal_simd::Level::AVX512,
+	};
+
+	for (const auto l : LEVELS) {
+		decimal_simd::init(l);
+		if (std::strcmp(decimal_simd::get_level_name(), name) == 0) {
+			level = l;
+			return true;
+		}
+	}
+	return false;
+}
+
+auto usage(const char *argv0) -> int {
+	std::fprintf(stderr,
+		"usage: %s [--json FILE] [--samples N] [--batch N] [--seed N]\n"
+		"          [--filter TEXT] [--kernel scalar|sse4.2|avx2|avx512]\n",
+		argv0
+	);
+	return 2;
+}
+
+} // namespace
+
+auto main(int argc, char **argv) -> int {
+	const char *json_path = nullptr;
+	const char *filter = nullptr;
+	int64_t samples = 100;
+	size_t batch = 4096;
+	uint64_t seed = 0x6e6968696c697479;
+	auto level = decimal_simd::detect();
+
+	for (int i = 1; i < argc; i++) {
+		const char *arg = argv[i];
+		const char *val = i + 1 < argc ? argv[i + 1] : nullptr;
+
+		if (val == nullptr) return usage(argv[0]);
+
+		if (std::strcmp(arg, "--json") == 0) {
+			json_path = val;
+		} else if (std::strcmp(arg, "--filter") == 0) {
+			filter = val;
+		} else if (std::strcmp(arg, "--samples") == 0) {
+			samples = std::strtoll(val, nullptr, 10);
+		} else if (std::strcmp(arg, "--batch") == 0) {
+			batch = static_cast<size_t>(std::strtoull(val, nullptr, 10));
+		} else if (std::strcmp(arg, "--seed") == 0) {
+			seed = std::strtoull(val, nullptr, 0);
+		} else if (std::strcmp(arg, "--kernel") == 0) {
+			if (!parse_level(val, level)) {
+				std::fprintf(stderr, "unknown or unsupported kernel: %s\n", val);
+				return 2;
+			}
+		} else {
+			return usage(argv[0]);
+		}
+		i++;
+	}
+
+	if (samples < 1 || batch < 1) return usage(argv[0]);
+
+	decimal_simd::init(level);
+
+	std::printf("kernel: %s, batch: %zu, samples: %lld, seed: %llu\n\n",
+		decimal_simd::get_level_name(), batch,
+		static_cast<long long>(samples), static_cast<unsigned long long>(seed)
+	);
+	std::printf("%-26s %-10s %9s %9s %9s %9s %9s\n", "op", "dist", "min", "p50", "p90", "p99", "max");
+
+	std::vector<Result> results;
+
+	for (const auto dist : DISTRIBUTIONS) {
+		auto in = generate(dist, batch, seed);
+
+		for (const auto &c : CASES) {
+			if (filter != nullptr && std::strstr(c.name, filter) == nullptr) continue;
+
+			const auto r = measure(c, in, dist, samples);
+			std::printf("%-26s %-10s %9.2f %9.2f %9.2f %9.2f %9.2f\n",
+				r.op.c_str(), r.distribution, r.min, r.p50, r.p90, r.p99, r.max
+			);
+			results.push_back(r);
+		}
+	}
+
+	if (json_path != nullptr) {
+		if (!write_json(json_path, results, seed, batch, samples)) {
+			std::fprintf(stderr, "couldn't write %s\n", json_path);
+			return 1;
+		}
+		std::printf("\nwrote %s\n", json_path);
+	}
+
+	return 0;
+}
@@ -0,0 +1,62 @@
+#include "cost_curve_set.hpp"
+#include "godot_cpp/core/error_macros.hpp"
+#include "godot_cpp/core/object.hpp"
+#include <cstdint>
+#include <godot_cpp/core/class_db.hpp>
+
+using namespace godot;
+
+auto CostCurveSet::_bind_methods() -> void {
+	ClassDB::bind_method(D_METHOD("add_geometric", "price_start", "price_ratio"), &CostCurveSet::add_geometric);
+	ClassDB::bind_method(D_METHOD("add_arithmetic", "price_start", "price_add"), &CostCurveSet::add_arithmetic);
+	ClassDB::bind_method(D_METHOD("size"), &CostCurveSet::size);
+	ClassDB::bind_method(D_METHOD("clear"), &CostCurveSet::clear);
+
+	ClassDB::bind_method(D_METHOD("max_affordable", "res_available", "owned"), &CostCurveSet::max_affordable);
+	ClassDB::bind_method(D_METHOD("cost_of", "num_items", "owned", "out"), &CostCurveSet::cost_of);
+}
+
+auto CostCurveSet::check_size(const char *fn, const char *param, const int64_t size) const -> bool {
+	ERR_FAIL_COND_V_MSG(size != this->size(), false,
+		String("CostCurveSet.") + fn + "() - `" + param + "` has " + String::num_int64(size) + " entries, but there are " + String::num_int64(this->size()) + " curves."
+	);
+	return true;
+}
+
+auto CostCurveSet::add_geometric(const Vector4i price_start, const Vector4i price_ratio) -> int64_t {
+	curves.push_back(decimal_curves::make_geometric(to_decimal(price_start), to_decimal(price_ratio)));
+	return size() - 1;
+}
+
+auto CostCurveSet::add_arithmetic(const Vector4i price_start, const Vector4i price_add) -> int64_t {
+	curves.push_back(decimal_curves::make_arithmetic(to_decimal(price_start), to_decimal(price_add)));
+	return size() - 1;
+}
+
+auto CostCurveSet::size() const -> int64_t {
+	return static_cast<int64_t>(curves.size());
+}
+
+auto CostCurveSet::clear() -> void {
+	curves.clear();
+}
+
+auto CostCurveSet::max_affordable(const Vector4i res_available, const PackedInt64Array &owned) const -> PackedInt64Array {
+	if (!check_size("max_affordable", "owned", owned.size())) return PackedInt64Array();
+
+	PackedInt64Array res;
+	res.resize(size());
+	decimal_curves::afford_many(curves.data(), size(), to_decimal(res_available), owned.ptr(), res.ptrw());
+	return res;
+}
+
+auto CostCurveSet::cost_of(const PackedInt64Array &num_items, const PackedInt64Array &owned, const Ref<DecimalArray> &out) const -> void {
+	ERR_FAIL_COND_MSG(out.is_null(), "CostCurveSet.cost_of() - `out` cannot be null.");
+	if (!check_size("cost_of", "num_items", num_items.size())) return;
+	if (!check_size("cost_of", "owned", owned.size())) return;
+
+	if (out->size() != size()) {
+		out->resize(size());
+	}
+	decimal_curves::cost_many(curves.data(), size(), num_items.ptr(), owned.ptr(), out->ptrw());
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "godot_cpp/classes/ref_counted.hpp"
+#include "godot_cpp/variant/packed_int64_array.hpp"
+#include "godot_cpp/variant/vector4i.hpp"
+
+#include "decimal_array.hpp"
+#include "decimal_curves.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace godot;
+
+// The price curves of every building in a shop, for "buy max" labels and the
+// like. Each curve's constants are worked out when it's added (see
+// decimal_curves.hpp), and the queries answer for all curves in one call.
+class CostCurveSet : public RefCounted {
+
+	GDCLASS(CostCurveSet, RefCounted)
+
+protected:
+	static auto _bind_methods() -> void;
+
+private:
+	std::vector<decimal_curves::Curve> curves;
+
+	auto check_size(const char *fn, const char *param, const int64_t size) const -> bool;
+
+public:
+	auto add_geometric(const Vector4i price_start, const Vector4i price_ratio) -> int64_t;
+	auto add_arithmetic(const Vector4i price_start, const Vector4i price_add) -> int64_t;
+	auto size() const -> int64_t;
+	auto clear() -> void;
+
+	auto max_affordable(const Vector4i res_available, const PackedInt64Array &owned) const -> PackedInt64Array;
+	auto cost_of(const PackedInt64Array &num_items, const PackedInt64Array &owned, const Ref<DecimalArray> &out) const -> void;
+};
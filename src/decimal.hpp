@@ -1,36 +1,47 @@
 #pragma once
 
 #include "godot_cpp/classes/object.hpp"
+#include "godot_cpp/classes/ref.hpp"
 #include "godot_cpp/classes/wrapped.hpp"
+#include "godot_cpp/variant/packed_byte_array.hpp"
 #include "godot_cpp/variant/string.hpp"
 #include "godot_cpp/variant/vector4i.hpp"
 
+#include "decimal_core.hpp"
+
 #include <cstdint>
-#include <limits>
-#include <optional>
+#include <cstring>
 
 using namespace godot;
 
 // We use Vector4i for the underlying data. This is due to
-// Godot not having a way to define custom variants. This struct
-// essentially automates the bitcasting for this purpose
+// Godot not having a way to define custom variants. These two
+// essentially automate the bitcasting for this purpose
 //
 // related proposal: https://github.com/godotengine/godot-proposals/issues/11797
-union DecimalData {
-	struct {
-		double mantissa;
-		int64_t exponent;
-	};
-	Vector4i raw;
-
-	#ifndef __ANDROID__
-		constexpr
-	#endif
-	DecimalData(const double m, const int64_t e)
-		: mantissa(m), exponent(e){}
-};
-
-
+//
+// The docs for Vector4i specifies: "Note that the values are limited to 32 bits,
+// and unlike Vector4 this cannot be configured with an engine build option."
+// So this should never ever trigger unless Godot decides to rework vectors.
+static_assert(sizeof(DecimalData) == sizeof(Vector4i),
+	"Size of the inner Decimal struct doesn't match the size of a Vector4i."
+);
+
+inline auto to_decimal(const Vector4i vec) -> DecimalData {
+	DecimalData dec;
+	memcpy(static_cast<void *>(&dec), &vec, sizeof(DecimalData));
+	return dec;
+}
+
+inline auto to_vector4i(const DecimalData dec) -> Vector4i {
+	Vector4i vec;
+	memcpy(static_cast<void *>(&vec), &dec, sizeof(Vector4i));
+	return vec;
+}
+
+class DecimalArray;
+
+// The math itself lives in decimal_core.hpp, this class only binds it.
 class Decimal : public Object {
 
 	GDCLASS(Decimal, Object)
@@ -38,37 +49,12 @@ class Decimal : public Object {
 protected:
 	static auto _bind_methods() -> void;
 
-// unions are dumb on android so...
-#ifdef __ANDROID__
-	#define DECIMAL_DECL_CONST inline
-#else
-	#define DECIMAL_DECL_CONST constexpr const
-#endif
-
-private:
-	static DECIMAL_DECL_CONST auto DECIMAL_ZERO = DecimalData(0.0, 0);
-	static DECIMAL_DECL_CONST auto DECIMAL_ZERO_NEG = DecimalData(-0.0, 0);
-
-	static DECIMAL_DECL_CONST auto DECIMAL_ONE = DecimalData(1.0, 0);
-	static DECIMAL_DECL_CONST auto DECIMAL_ONE_NEG = DecimalData(-1.0, 0);
-
-	static DECIMAL_DECL_CONST auto DECIMAL_INF = DecimalData(
-		std::numeric_limits<double>::infinity(), 0
-	);
-
-	static DECIMAL_DECL_CONST auto DECIMAL_INF_NEG = DecimalData(
-		-std::numeric_limits<double>::infinity(), 0
-	);
-
-	static DECIMAL_DECL_CONST auto DECIMAL_NAN = DecimalData(
-		std::numeric_limits<double>::signaling_NaN(), 0
-	);
-
-
 public:
 	static auto from_parts(const double layer, const int64_t exponent) -> Vector4i;
 	static auto from_parts_normalize(const double layer, const int64_t exponent) -> Vector4i;
 	static auto from_float(double num) -> Vector4i;
+	static auto from_string(const String &text) -> Vector4i;
+	static auto is_valid_string(const String &text) -> bool;
 
 	static auto get_mantissa(const Vector4i decimal) -> double;
 	static auto set_mantissa(const Vector4i decimal, double v) -> Vector4i;
@@ -83,6 +69,9 @@ public:
 	static auto to_string(const Vector4i decimal) -> String;
 	static auto to_exponential(const Vector4i decimal, const int64_t places = -1) -> String;
 
+	static auto pack(const Ref<DecimalArray> &values, const bool compact = false) -> PackedByteArray;
+	static auto unpack(const PackedByteArray &bytes) -> Ref<DecimalArray>;
+
 	static auto normalize(const Vector4i decimal) -> Vector4i;
 	static auto is_finite(const Vector4i decimal) -> bool;
 
@@ -111,6 +100,7 @@ public:
 	static auto ge(const Vector4i n1, const Vector4i n2) -> bool;
 	static auto eq(const Vector4i n1, const Vector4i n2) -> bool;
 	static auto ne(const Vector4i n1, const Vector4i n2) -> bool;
+	static auto sort_key(const Vector4i decimal) -> PackedByteArray;
 
 	static auto min(const Vector4i n1, const Vector4i n2) -> Vector4i;
 	static auto max(const Vector4i n1, const Vector4i n2) -> Vector4i;
@@ -135,8 +125,10 @@ public:
 
 	static auto pow10_num(const double exp) -> Vector4i;
 
-	// static auto pow(const Vector4i base, const Vector4i exp) -> Vector4i;
+	static auto pow(const Vector4i base, const Vector4i exp) -> Vector4i;
 	static auto pow_num(const Vector4i base, const double exp) -> Vector4i;
+	static auto pow_base(const double base, const Vector4i exp) -> Vector4i;
+	static auto exp(const Vector4i decimal) -> Vector4i;
 
 	static auto sqrt(const Vector4i base) -> Vector4i;
 	static auto cbrt(const Vector4i base) -> Vector4i;
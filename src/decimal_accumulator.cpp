@@ -0,0 +1,36 @@
+#include "decimal_accumulator.hpp"
+#include "godot_cpp/core/error_macros.hpp"
+#include "godot_cpp/core/object.hpp"
+#include <godot_cpp/core/class_db.hpp>
+
+using namespace godot;
+namespace core = decimal_core;
+
+auto DecimalAccumulator::_bind_methods() -> void {
+	ClassDB::bind_method(D_METHOD("add", "value"), &DecimalAccumulator::add);
+	ClassDB::bind_method(D_METHOD("sub", "value"), &DecimalAccumulator::sub);
+	ClassDB::bind_method(D_METHOD("add_many", "values"), &DecimalAccumulator::add_many);
+	ClassDB::bind_method(D_METHOD("read"), &DecimalAccumulator::read);
+	ClassDB::bind_method(D_METHOD("reset", "start"), &DecimalAccumulator::reset, DEFVAL(Vector4i()));
+}
+
+auto DecimalAccumulator::add(const Vector4i value) -> void {
+	acc.add(to_decimal(value));
+}
+
+auto DecimalAccumulator::sub(const Vector4i value) -> void {
+	acc.add(core::neg(to_decimal(value)));
+}
+
+auto DecimalAccumulator::add_many(const Ref<DecimalArray> &values) -> void {
+	ERR_FAIL_COND_MSG(values.is_null(), "DecimalAccumulator.add_many() - `values` cannot be null.");
+	acc.add_many(values->ptr(), values->size());
+}
+
+auto DecimalAccumulator::read() const -> Vector4i {
+	return to_vector4i(acc.read());
+}
+
+auto DecimalAccumulator::reset(const Vector4i start) -> void {
+	acc.reset(to_decimal(start));
+}
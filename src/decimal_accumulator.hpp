@@ -0,0 +1,29 @@
+#pragma once
+
+#include "godot_cpp/classes/ref_counted.hpp"
+#include "godot_cpp/variant/vector4i.hpp"
+
+#include "decimal_array.hpp"
+#include "decimal_sum.hpp"
+
+using namespace godot;
+
+// A running total that doesn't normalize after every addition and doesn't
+// drop small addends, see decimal_sum.hpp.
+class DecimalAccumulator : public RefCounted {
+
+	GDCLASS(DecimalAccumulator, RefCounted)
+
+protected:
+	static auto _bind_methods() -> void;
+
+private:
+	decimal_sum::Accumulator acc;
+
+public:
+	auto add(const Vector4i value) -> void;
+	auto sub(const Vector4i value) -> void;
+	auto add_many(const Ref<DecimalArray> &values) -> void;
+	auto read() const -> Vector4i;
+	auto reset(const Vector4i start = Vector4i()) -> void;
+};
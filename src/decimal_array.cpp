@@ -0,0 +1,406 @@
+#include "decimal_array.hpp"
+#include "decimal_simd.hpp"
+#include "decimal_sort.hpp"
+#include "decimal_string.hpp"
+#include "godot_cpp/core/error_macros.hpp"
+#include "godot_cpp/variant/variant.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <godot_cpp/core/class_db.hpp>
+
+using namespace godot;
+
+static constexpr const int64_t DECIMAL_SIZE = sizeof(DecimalData);
+
+int64_t DecimalArray::parallel_threshold = decimal_parallel::DEFAULT_THRESHOLD;
+
+auto DecimalArray::_bind_methods() -> void {
+	ClassDB::bind_static_method("DecimalArray", D_METHOD("create", "size"), &DecimalArray::create);
+	ClassDB::bind_static_method("DecimalArray", D_METHOD("from_array", "values"), &DecimalArray::from_array);
+	ClassDB::bind_static_method("DecimalArray", D_METHOD("from_strings", "strings"), &DecimalArray::from_strings);
+	ClassDB::bind_static_method("DecimalArray", D_METHOD("from_utf8", "text"), &DecimalArray::from_utf8);
+	ClassDB::bind_method(D_METHOD("to_array"), &DecimalArray::to_array);
+
+	ClassDB::bind_method(D_METHOD("size"), &DecimalArray::size);
+	ClassDB::bind_method(D_METHOD("resize", "size"), &DecimalArray::resize);
+	ClassDB::bind_method(D_METHOD("is_empty"), &DecimalArray::is_empty);
+
+	ClassDB::bind_method(D_METHOD("get_at", "idx"), &DecimalArray::get_at);
+	ClassDB::bind_method(D_METHOD("set_at", "idx", "decimal"), &DecimalArray::set_at);
+	ClassDB::bind_method(D_METHOD("append", "decimal"), &DecimalArray::append);
+	ClassDB::bind_method(D_METHOD("fill", "decimal"), &DecimalArray::fill);
+
+	ClassDB::bind_method(D_METHOD("get_data"), &DecimalArray::get_data);
+	ClassDB::bind_method(D_METHOD("set_data", "bytes"), &DecimalArray::set_data);
+
+	ClassDB::bind_static_method("DecimalArray", D_METHOD("add", "a", "b", "out"), &DecimalArray::add);
+	ClassDB::bind_static_method("DecimalArray", D_METHOD("sub", "a", "b", "out"), &DecimalArray::sub);
+	ClassDB::bind_static_method("DecimalArray", D_METHOD("mul", "a", "b", "out"), &DecimalArray::mul);
+	ClassDB::bind_static_method("DecimalArray", D_METHOD("div", "a", "b", "out"), &DecimalArray::div);
+
+	ClassDB::bind_static_method("DecimalArray", D_METHOD("mul_num", "a", "n", "out"), &DecimalArray::mul_num);
+	ClassDB::bind_static_method("DecimalArray", D_METHOD("pow_num", "a", "exp", "out"), &DecimalArray::pow_num);
+
+	ClassDB::bind_static_method("DecimalArray", D_METHOD("normalize", "a", "out"), &DecimalArray::normalize);
+
+	ClassDB::bind_static_method("DecimalArray", D_METHOD("ge_mask", "values", "thresholds"), &DecimalArray::ge_mask);
+	ClassDB::bind_static_method("DecimalArray", D_METHOD("ge_scalar_mask", "values", "x"), &DecimalArray::ge_scalar_mask);
+	ClassDB::bind_static_method("DecimalArray", D_METHOD("le_scalar_mask", "values", "x"), &DecimalArray::le_scalar_mask);
+	ClassDB::bind_static_method("DecimalArray", D_METHOD("mask_count", "mask"), &DecimalArray::mask_count);
+	ClassDB::bind_static_method("DecimalArray", D_METHOD("mask_find", "mask", "from"), &DecimalArray::mask_find, DEFVAL(0));
+
+	ClassDB::bind_static_method("DecimalArray", D_METHOD("sort", "a", "out"), &DecimalArray::sort);
+	ClassDB::bind_static_method("DecimalArray", D_METHOD("argsort", "a"), &DecimalArray::argsort);
+	ClassDB::bind_static_method("DecimalArray", D_METHOD("top_k", "a", "k"), &DecimalArray::top_k);
+	ClassDB::bind_static_method("DecimalArray", D_METHOD("binary_search", "a", "value", "before"), &DecimalArray::binary_search, DEFVAL(true));
+
+	ClassDB::bind_static_method("DecimalArray", D_METHOD("set_parallel_threshold", "threshold"), &DecimalArray::set_parallel_threshold);
+	ClassDB::bind_static_method("DecimalArray", D_METHOD("get_parallel_threshold"), &DecimalArray::get_parallel_threshold);
+
+	ClassDB::bind_static_method("DecimalArray", D_METHOD("get_kernel_name"), &DecimalArray::get_kernel_name);
+}
+
+auto DecimalArray::create(const int64_t size) -> Ref<DecimalArray> {
+	ERR_FAIL_COND_V_MSG(size < 0, Ref<DecimalArray>(), "DecimalArray.create() - size cannot be negative.");
+
+	Ref<DecimalArray> arr;
+	arr.instantiate();
+	arr->resize(size);
+	return arr;
+}
+
+auto DecimalArray::from_array(const Array &values) -> Ref<DecimalArray> {
+	Ref<DecimalArray> arr;
+	arr.instantiate();
+	arr->resize(values.size());
+
+	auto *dst = arr->ptrw();
+	for (int64_t i = 0; i < values.size(); i++) {
+		const Variant &v = values[i];
+		ERR_FAIL_COND_V_MSG(v.get_type() != Variant::VECTOR4I, Ref<DecimalArray>(),
+			"DecimalArray.from_array() - element " + String::num_int64(i) + " is not a Vector4i."
+		);
+		dst[i] = to_decimal(v);
+	}
+	return arr;
+}
+
+auto DecimalArray::from_strings(const PackedStringArray &strings) -> Ref<DecimalArray> {
+	Ref<DecimalArray> arr;
+	arr.instantiate();
+	arr->resize(strings.size());
+
+	auto *dst = arr->ptrw();
+	const auto *src = strings.ptr();
+
+	int64_t failed = 0;
+	for (int64_t i = 0; i < strings.size(); i++) {
+		const auto res = decimal_string::parse(src[i].ptr(), src[i].length(), dst[i]);
+		if (unlikely(res.error != decimal_string::ParseError::OK)) {
+			dst[i] = decimal_core::DECIMAL_NAN;
+
+			// one error for the whole batch, the rest only get counted
+			if (failed++ == 0) {
+				ERR_PRINT(String("DecimalArray.from_strings() - element ") + String::num_int64(i) + ": " +
+					decimal_string::get_parse_error_message(res.error) + " at position " + String::num_int64(res.position) +
+					" in \"" + src[i] + "\". Invalid elements are set to NaN."
+				);
+			}
+		}
+	}
+
+	if (failed > 1) {
+		ERR_PRINT("DecimalArray.from_strings() - " + String::num_int64(failed) + " elements in total couldn't be parsed.");
+	}
+	return arr;
+}
+
+auto DecimalArray::from_utf8(const PackedByteArray &text) -> Ref<DecimalArray> {
+	const auto *chars = reinterpret_cast<const char *>(text.ptr());
+	const auto len = text.size();
+
+	Ref<DecimalArray> arr;
+	arr.instantiate();
+	arr->resize(decimal_string::count_tokens(chars, len));
+
+	const auto err = decimal_string::parse_list(chars, len, arr->ptrw());
+	if (unlikely(err.count > 0)) {
+		ERR_PRINT(String("DecimalArray.from_utf8() - value ") + String::num_int64(err.index) + " (at byte " +
+			String::num_int64(err.offset) + "): " + decimal_string::get_parse_error_message(err.result.error) +
+			" at position " + String::num_int64(err.result.position) + ". " +
+			String::num_int64(err.count) + " invalid value(s) in total, set to NaN."
+		);
+	}
+	return arr;
+}
+
+auto DecimalArray::to_array() const -> Array {
+	Array res;
+	res.resize(size());
+
+	const auto *src = ptr();
+	for (int64_t i = 0; i < size(); i++) {
+		res[i] = to_vector4i(src[i]);
+	}
+	return res;
+}
+
+auto DecimalArray::size() const -> int64_t {
+	return data.size() / DECIMAL_SIZE;
+}
+
+auto DecimalArray::resize(const int64_t size) -> void {
+	ERR_FAIL_COND_MSG(size < 0, "DecimalArray.resize() - size cannot be negative.");
+
+	const auto old_bytes = data.size();
+	const auto new_bytes = size * DECIMAL_SIZE;
+	data.resize(new_bytes);
+
+	// packed arrays don't promise zeroed memory when growing,
+	// and an all-zero DecimalData happens to be exactly 0
+	if (new_bytes > old_bytes) {
+		memset(data.ptrw() + old_bytes, 0, new_bytes - old_bytes);
+	}
+}
+
+auto DecimalArray::is_empty() const -> bool {
+	return data.is_empty();
+}
+
+auto DecimalArray::get_at(const int64_t idx) const -> Vector4i {
+	ERR_FAIL_INDEX_V_MSG(idx, size(), Vector4i(), "DecimalArray.get_at() - index out of bounds.");
+	return to_vector4i(ptr()[idx]);
+}
+
+auto DecimalArray::set_at(const int64_t idx, const Vector4i decimal) -> void {
+	ERR_FAIL_INDEX_MSG(idx, size(), "DecimalArray.set_at() - index out of bounds.");
+	ptrw()[idx] = to_decimal(decimal);
+}
+
+auto DecimalArray::append(const Vector4i decimal) -> void {
+	const auto idx = size();
+	resize(idx + 1);
+	ptrw()[idx] = to_decimal(decimal);
+}
+
+auto DecimalArray::fill(const Vector4i decimal) -> void {
+	auto *dst = ptrw();
+	const auto dec = to_decimal(decimal);
+	for (int64_t i = 0; i < size(); i++) {
+		dst[i] = dec;
+	}
+}
+
+auto DecimalArray::get_data() const -> PackedByteArray {
+	return data;
+}
+
+auto DecimalArray::set_data(const PackedByteArray &bytes) -> void {
+	ERR_FAIL_COND_MSG(bytes.size() % DECIMAL_SIZE != 0,
+		"DecimalArray.set_data() - byte count has to be a multiple of " + String::num_int64(DECIMAL_SIZE) + "."
+	);
+	data = bytes;
+}
+
+auto DecimalArray::ptr() const -> const DecimalData * {
+	return reinterpret_cast<const DecimalData *>(data.ptr());
+}
+
+auto DecimalArray::ptrw() -> DecimalData * {
+	return reinterpret_cast<DecimalData *>(data.ptrw());
+}
+
+// Validates the arguments and sizes `out` to match. Callers have to fetch the
+// output pointer before the input ones: if `out` aliases an input and its
+// buffer is shared, ptrw() does the copy-on-write first, so the input pointer
+// ends up pointing at the same (new) buffer.
+static auto prepare_unary(const char *fn, const Ref<DecimalArray> &a, const Ref<DecimalArray> &out) -> bool {
+	ERR_FAIL_COND_V_MSG(a.is_null() || out.is_null(), false, String("DecimalArray.") + fn + "() - arrays cannot be null.");
+
+	if (out->size() != a->size()) {
+		out->resize(a->size());
+	}
+	return true;
+}
+
+static auto prepare_binary(const char *fn, const Ref<DecimalArray> &a, const Ref<DecimalArray> &b, const Ref<DecimalArray> &out) -> bool {
+	ERR_FAIL_COND_V_MSG(a.is_null() || b.is_null() || out.is_null(), false, String("DecimalArray.") + fn + "() - arrays cannot be null.");
+	ERR_FAIL_COND_V_MSG(a->size() != b->size(), false,
+		String("DecimalArray.") + fn + "() - size mismatch (" + String::num_int64(a->size()) + " vs " + String::num_int64(b->size()) + ")."
+	);
+
+	if (out->size() != a->size()) {
+		out->resize(a->size());
+	}
+	return true;
+}
+
+auto DecimalArray::add(const Ref<DecimalArray> &a, const Ref<DecimalArray> &b, const Ref<DecimalArray> &out) -> void {
+	if (!prepare_binary("add", a, b, out)) return;
+
+	auto *dst = out->ptrw();
+	const auto *lhs = a->ptr();
+	const auto *rhs = b->ptr();
+
+	for_each_chunk(out->size(), [&](const int64_t begin, const int64_t end) {
+		decimal_simd::add(lhs + begin, rhs + begin, dst + begin, end - begin);
+	});
+}
+
+auto DecimalArray::sub(const Ref<DecimalArray> &a, const Ref<DecimalArray> &b, const Ref<DecimalArray> &out) -> void {
+	if (!prepare_binary("sub", a, b, out)) return;
+
+	auto *dst = out->ptrw();
+	const auto *lhs = a->ptr();
+	const auto *rhs = b->ptr();
+
+	for_each_chunk(out->size(), [&](const int64_t begin, const int64_t end) {
+		decimal_simd::sub(lhs + begin, rhs + begin, dst + begin, end - begin);
+	});
+}
+
+auto DecimalArray::mul(const Ref<DecimalArray> &a, const Ref<DecimalArray> &b, const Ref<DecimalArray> &out) -> void {
+	if (!prepare_binary("mul", a, b, out)) return;
+
+	auto *dst = out->ptrw();
+	const auto *lhs = a->ptr();
+	const auto *rhs = b->ptr();
+
+	for_each_chunk(out->size(), [&](const int64_t begin, const int64_t end) {
+		decimal_simd::mul(lhs + begin, rhs + begin, dst + begin, end - begin);
+	});
+}
+
+auto DecimalArray::div(const Ref<DecimalArray> &a, const Ref<DecimalArray> &b, const Ref<DecimalArray> &out) -> void {
+	if (!prepare_binary("div", a, b, out)) return;
+
+	auto *dst = out->ptrw();
+	const auto *lhs = a->ptr();
+	const auto *rhs = b->ptr();
+
+	for_each_chunk(out->size(), [&](const int64_t begin, const int64_t end) {
+		for (auto i = begin; i < end; i++) {
+			dst[i] = decimal_core::div(lhs[i], rhs[i]);
+		}
+	});
+}
+
+auto DecimalArray::mul_num(const Ref<DecimalArray> &a, const double n, const Ref<DecimalArray> &out) -> void {
+	if (!prepare_unary("mul_num", a, out)) return;
+
+	auto *dst = out->ptrw();
+	const auto *src = a->ptr();
+
+	for_each_chunk(out->size(), [&](const int64_t begin, const int64_t end) {
+		decimal_simd::mul_num(src + begin, n, dst + begin, end - begin);
+	});
+}
+
+auto DecimalArray::pow_num(const Ref<DecimalArray> &a, const double exp, const Ref<DecimalArray> &out) -> void {
+	if (!prepare_unary("pow_num", a, out)) return;
+
+	auto *dst = out->ptrw();
+	const auto *src = a->ptr();
+
+	for_each_chunk(out->size(), [&](const int64_t begin, const int64_t end) {
+		for (auto i = begin; i < end; i++) {
+			dst[i] = decimal_core::pow_num(src[i], exp);
+		}
+	});
+}
+
+auto DecimalArray::normalize(const Ref<DecimalArray> &a, const Ref<DecimalArray> &out) -> void {
+	if (!prepare_unary("normalize", a, out)) return;
+
+	auto *dst = out->ptrw();
+	const auto *src = a->ptr();
+
+	for_each_chunk(out->size(), [&](const int64_t begin, const int64_t end) {
+		decimal_simd::normalize(src + begin, dst + begin, end - begin);
+	});
+}
+
+auto DecimalArray::ge_mask(const Ref<DecimalArray> &values, const Ref<DecimalArray> &thresholds) -> PackedByteArray {
+	ERR_FAIL_COND_V_MSG(values.is_null() || thresholds.is_null(), PackedByteArray(), "DecimalArray.ge_mask() - arrays cannot be null.");
+	ERR_FAIL_COND_V_MSG(values->size() != thresholds->size(), PackedByteArray(),
+		"DecimalArray.ge_mask() - size mismatch (" + String::num_int64(values->size()) + " vs " + String::num_int64(thresholds->size()) + ")."
+	);
+
+	PackedByteArray mask;
+	mask.resize((values->size() + 7) / 8);
+	decimal_simd::ge_mask(values->ptr(), thresholds->ptr(), mask.ptrw(), values->size());
+	return mask;
+}
+
+auto DecimalArray::ge_scalar_mask(const Ref<DecimalArray> &values, const Vector4i x) -> PackedByteArray {
+	ERR_FAIL_COND_V_MSG(values.is_null(), PackedByteArray(), "DecimalArray.ge_scalar_mask() - array cannot be null.");
+
+	PackedByteArray mask;
+	mask.resize((values->size() + 7) / 8);
+	decimal_simd::ge_scalar_mask(values->ptr(), to_decimal(x), mask.ptrw(), values->size());
+	return mask;
+}
+
+auto DecimalArray::le_scalar_mask(const Ref<DecimalArray> &values, const Vector4i x) -> PackedByteArray {
+	ERR_FAIL_COND_V_MSG(values.is_null(), PackedByteArray(), "DecimalArray.le_scalar_mask() - array cannot be null.");
+
+	PackedByteArray mask;
+	mask.resize((values->size() + 7) / 8);
+	decimal_simd::le_scalar_mask(values->ptr(), to_decimal(x), mask.ptrw(), values->size());
+	return mask;
+}
+
+auto DecimalArray::mask_count(const PackedByteArray &mask) -> int64_t {
+	return decimal_simd::mask_count(mask.ptr(), mask.size());
+}
+
+auto DecimalArray::mask_find(const PackedByteArray &mask, const int64_t from) -> int64_t {
+	return decimal_simd::mask_find(mask.ptr(), mask.size(), from);
+}
+
+auto DecimalArray::sort(const Ref<DecimalArray> &a, const Ref<DecimalArray> &out) -> void {
+	if (!prepare_unary("sort", a, out)) return;
+
+	auto *dst = out->ptrw();
+	const auto *src = a->ptr();
+
+	decimal_sort::sort(src, out->size(), dst);
+}
+
+auto DecimalArray::argsort(const Ref<DecimalArray> &a) -> PackedInt64Array {
+	ERR_FAIL_COND_V_MSG(a.is_null(), PackedInt64Array(), "DecimalArray.argsort() - array cannot be null.");
+
+	PackedInt64Array res;
+	res.resize(a->size());
+	decimal_sort::argsort(a->ptr(), a->size(), res.ptrw());
+	return res;
+}
+
+auto DecimalArray::top_k(const Ref<DecimalArray> &a, const int64_t k) -> PackedInt64Array {
+	ERR_FAIL_COND_V_MSG(a.is_null(), PackedInt64Array(), "DecimalArray.top_k() - array cannot be null.");
+	ERR_FAIL_COND_V_MSG(k < 0, PackedInt64Array(), "DecimalArray.top_k() - k cannot be negative.");
+
+	PackedInt64Array res;
+	res.resize(std::min(k, a->size()));
+	decimal_sort::top_k(a->ptr(), a->size(), k, res.ptrw());
+	return res;
+}
+
+auto DecimalArray::binary_search(const Ref<DecimalArray> &a, const Vector4i value, const bool before) -> int64_t {
+	ERR_FAIL_COND_V_MSG(a.is_null(), -1, "DecimalArray.binary_search() - array cannot be null.");
+
+	return decimal_sort::search(a->ptr(), a->size(), to_decimal(value), before);
+}
+
+auto DecimalArray::get_kernel_name() -> String {
+	return decimal_simd::get_level_name();
+}
+
+auto DecimalArray::set_parallel_threshold(const int64_t threshold) -> void {
+	parallel_threshold = threshold;
+}
+
+auto DecimalArray::get_parallel_threshold() -> int64_t {
+	return parallel_threshold;
+}
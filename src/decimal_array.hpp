@@ -0,0 +1,117 @@
+#pragma once
+
+#include "godot_cpp/classes/ref_counted.hpp"
+#include "godot_cpp/classes/worker_thread_pool.hpp"
+#include "godot_cpp/variant/array.hpp"
+#include "godot_cpp/variant/packed_byte_array.hpp"
+#include "godot_cpp/variant/packed_int64_array.hpp"
+#include "godot_cpp/variant/packed_string_array.hpp"
+#include "godot_cpp/variant/string.hpp"
+#include "godot_cpp/variant/vector4i.hpp"
+
+#include "decimal.hpp"
+#include "decimal_parallel.hpp"
+
+#include <cstdint>
+
+using namespace godot;
+
+// A contiguous array of DecimalData, kept inside a PackedByteArray (16 bytes
+// per element). Calling into the extension once per element is where most of
+// the time goes when a game ticks thousands of values per frame, so the static
+// methods here process whole arrays in a single call instead.
+//
+// Every op writes into a caller-provided `out` array, which is only resized
+// when its size doesn't match. `out` may alias one of the inputs.
+//
+// Arrays of parallel_threshold elements or more are split into chunks that
+// run on the WorkerThreadPool, see decimal_parallel.hpp.
+class DecimalArray : public RefCounted {
+
+	GDCLASS(DecimalArray, RefCounted)
+
+protected:
+	static auto _bind_methods() -> void;
+
+private:
+	PackedByteArray data;
+
+	static int64_t parallel_threshold;
+
+public:
+	static auto create(const int64_t size) -> Ref<DecimalArray>;
+	static auto from_array(const Array &values) -> Ref<DecimalArray>;
+	static auto from_strings(const PackedStringArray &strings) -> Ref<DecimalArray>;
+	static auto from_utf8(const PackedByteArray &text) -> Ref<DecimalArray>;
+	auto to_array() const -> Array;
+
+	auto size() const -> int64_t;
+	auto resize(const int64_t size) -> void;
+	auto is_empty() const -> bool;
+
+	auto get_at(const int64_t idx) const -> Vector4i;
+	auto set_at(const int64_t idx, const Vector4i decimal) -> void;
+	auto append(const Vector4i decimal) -> void;
+	auto fill(const Vector4i decimal) -> void;
+
+	auto get_data() const -> PackedByteArray;
+	auto set_data(const PackedByteArray &bytes) -> void;
+
+	// direct access for the C++ side, these don't do any bounds checks
+	auto ptr() const -> const DecimalData *;
+	auto ptrw() -> DecimalData *;
+
+	static auto add(const Ref<DecimalArray> &a, const Ref<DecimalArray> &b, const Ref<DecimalArray> &out) -> void;
+	static auto sub(const Ref<DecimalArray> &a, const Ref<DecimalArray> &b, const Ref<DecimalArray> &out) -> void;
+	static auto mul(const Ref<DecimalArray> &a, const Ref<DecimalArray> &b, const Ref<DecimalArray> &out) -> void;
+	static auto div(const Ref<DecimalArray> &a, const Ref<DecimalArray> &b, const Ref<DecimalArray> &out) -> void;
+
+	static auto mul_num(const Ref<DecimalArray> &a, const double n, const Ref<DecimalArray> &out) -> void;
+	static auto pow_num(const Ref<DecimalArray> &a, const double exp, const Ref<DecimalArray> &out) -> void;
+
+	static auto normalize(const Ref<DecimalArray> &a, const Ref<DecimalArray> &out) -> void;
+
+	// comparisons packed into bitmasks, bit i being bit (i % 8) of byte (i / 8)
+	static auto ge_mask(const Ref<DecimalArray> &values, const Ref<DecimalArray> &thresholds) -> PackedByteArray;
+	static auto ge_scalar_mask(const Ref<DecimalArray> &values, const Vector4i x) -> PackedByteArray;
+	static auto le_scalar_mask(const Ref<DecimalArray> &values, const Vector4i x) -> PackedByteArray;
+	static auto mask_count(const PackedByteArray &mask) -> int64_t;
+	static auto mask_find(const PackedByteArray &mask, const int64_t from = 0) -> int64_t;
+
+	// ordering through the integer keys of decimal_sort.hpp
+	static auto sort(const Ref<DecimalArray> &a, const Ref<DecimalArray> &out) -> void;
+	static auto argsort(const Ref<DecimalArray> &a) -> PackedInt64Array;
+	static auto top_k(const Ref<DecimalArray> &a, const int64_t k) -> PackedInt64Array;
+	static auto binary_search(const Ref<DecimalArray> &a, const Vector4i value, const bool before = true) -> int64_t;
+
+	// which SIMD path the batch kernels picked at load time
+	static auto get_kernel_name() -> String;
+
+	static auto set_parallel_threshold(const int64_t threshold) -> void;
+	static auto get_parallel_threshold() -> int64_t;
+
+	// Calls fn(begin, end) for every chunk of [0, n), spread over the
+	// WorkerThreadPool once n reaches the parallel threshold. Otherwise it's a
+	// single call for the whole range, on the calling thread.
+	template <typename F>
+	static auto for_each_chunk(const int64_t n, F &&fn) -> void {
+		auto *pool = WorkerThreadPool::get_singleton();
+		if (parallel_threshold <= 0 || n < parallel_threshold || pool == nullptr) {
+			fn(int64_t(0), n);
+			return;
+		}
+
+		struct Job {
+			std::remove_reference_t<F> *fn;
+			int64_t n;
+		};
+		Job job = { &fn, n };
+
+		const auto task = pool->add_native_group_task([](void *data, const uint32_t idx) {
+			auto *job = static_cast<Job *>(data);
+			const auto r = decimal_parallel::chunk_range(idx, job->n);
+			(*job->fn)(r.begin, r.end);
+		}, &job, static_cast<int>(decimal_parallel::chunk_count(n)), -1, true, String("DecimalArray batch"));
+		pool->wait_for_group_task_completion(task);
+	}
+};
@@ -0,0 +1,301 @@
+#include "decimal_array_precision.hpp"
+#include "godot_cpp/core/error_macros.hpp"
+#include "godot_cpp/variant/variant.hpp"
+#include <cstdint>
+#include <cstring>
+#include <godot_cpp/core/class_db.hpp>
+
+using namespace godot;
+namespace precision = decimal_precision;
+
+// Everything both classes share, with `Cls` being one of them. The static
+// methods here are bound as they are.
+template <typename Cls>
+struct PrecisionArray {
+	using Data = typename Cls::Data;
+	using Mantissa = typename Cls::Mantissa;
+
+	static constexpr const int64_t DATA_SIZE = sizeof(Data);
+
+	static auto bind() -> void {
+		const auto cls = Cls::get_class_static();
+
+		ClassDB::bind_static_method(cls, D_METHOD("create", "size"), &PrecisionArray::create);
+		ClassDB::bind_static_method(cls, D_METHOD("from_decimals", "values"), &PrecisionArray::from_decimals);
+		ClassDB::bind_method(D_METHOD("to_decimals"), &Cls::to_decimals);
+
+		ClassDB::bind_method(D_METHOD("size"), &Cls::size);
+		ClassDB::bind_method(D_METHOD("resize", "size"), &Cls::resize);
+
+		ClassDB::bind_method(D_METHOD("get_at", "idx"), &Cls::get_at);
+		ClassDB::bind_method(D_METHOD("set_at", "idx", "decimal"), &Cls::set_at);
+		ClassDB::bind_method(D_METHOD("append", "decimal"), &Cls::append);
+
+		ClassDB::bind_method(D_METHOD("get_data"), &Cls::get_data);
+		ClassDB::bind_method(D_METHOD("set_data", "bytes"), &Cls::set_data);
+
+		ClassDB::bind_static_method(cls, D_METHOD("add", "a", "b", "out"), &PrecisionArray::add);
+		ClassDB::bind_static_method(cls, D_METHOD("sub", "a", "b", "out"), &PrecisionArray::sub);
+		ClassDB::bind_static_method(cls, D_METHOD("mul", "a", "b", "out"), &PrecisionArray::mul);
+		ClassDB::bind_static_method(cls, D_METHOD("div", "a", "b", "out"), &PrecisionArray::div);
+
+		ClassDB::bind_static_method(cls, D_METHOD("mul_num", "a", "n", "out"), &PrecisionArray::mul_num);
+		ClassDB::bind_static_method(cls, D_METHOD("pow_num", "a", "exp", "out"), &PrecisionArray::pow_num);
+
+		ClassDB::bind_static_method(cls, D_METHOD("sum", "a"), &PrecisionArray::sum);
+	}
+
+	// "DecimalArray32.add()"
+	static auto method_name(const char *fn) -> String {
+		return String(Cls::get_class_static()) + "." + fn + "()";
+	}
+
+	static auto ptr(const Cls &arr) -> const Data * {
+		return reinterpret_cast<const Data *>(arr.data.ptr());
+	}
+
+	static auto ptrw(Cls &arr) -> Data * {
+		return reinterpret_cast<Data *>(arr.data.ptrw());
+	}
+
+	static auto size(const Cls &arr) -> int64_t {
+		return arr.data.size() / DATA_SIZE;
+	}
+
+	static auto resize(Cls &arr, const int64_t size) -> void {
+		ERR_FAIL_COND_MSG(size < 0, method_name("resize") + " - size cannot be negative.");
+
+		const auto old_size = PrecisionArray::size(arr);
+		arr.data.resize(size * DATA_SIZE);
+
+		// an all-zero double-double is 0 too, but the padding after a float
+		// mantissa would be left uninitialized
+		auto *dst = ptrw(arr);
+		for (auto i = old_size; i < size; i++) {
+			dst[i] = Data();
+		}
+	}
+
+	static auto create(const int64_t size) -> Ref<Cls> {
+		ERR_FAIL_COND_V_MSG(size < 0, Ref<Cls>(), method_name("create") + " - size cannot be negative.");
+
+		Ref<Cls> arr;
+		arr.instantiate();
+		resize(*arr.ptr(), size);
+		return arr;
+	}
+
+	static auto from_decimals(const Ref<DecimalArray> &values) -> Ref<Cls> {
+		ERR_FAIL_COND_V_MSG(values.is_null(), Ref<Cls>(), method_name("from_decimals") + " - `values` cannot be null.");
+
+		Ref<Cls> arr;
+		arr.instantiate();
+		resize(*arr.ptr(), values->size());
+
+		auto *dst = ptrw(*arr.ptr());
+		const auto *src = values->ptr();
+		for (int64_t i = 0; i < values->size(); i++) {
+			dst[i] = precision::from_decimal<Mantissa>(src[i]);
+		}
+		return arr;
+	}
+
+	static auto to_decimals(const Cls &arr) -> Ref<DecimalArray> {
+		const auto n = size(arr);
+		auto res = DecimalArray::create(n);
+
+		auto *dst = res->ptrw();
+		const auto *src = ptr(arr);
+		for (int64_t i = 0; i < n; i++) {
+			dst[i] = precision::to_decimal(src[i]);
+		}
+		return res;
+	}
+
+	static auto get_at(const Cls &arr, const int64_t idx) -> Vector4i {
+		ERR_FAIL_INDEX_V_MSG(idx, size(arr), Vector4i(), method_name("get_at") + " - index out of bounds.");
+		return to_vector4i(precision::to_decimal(ptr(arr)[idx]));
+	}
+
+	static auto set_at(Cls &arr, const int64_t idx, const Vector4i decimal) -> void {
+		ERR_FAIL_INDEX_MSG(idx, size(arr), method_name("set_at") + " - index out of bounds.");
+		ptrw(arr)[idx] = precision::from_decimal<Mantissa>(to_decimal(decimal));
+	}
+
+	static auto append(Cls &arr, const Vector4i decimal) -> void {
+		const auto idx = size(arr);
+		resize(arr, idx + 1);
+		ptrw(arr)[idx] = precision::from_decimal<Mantissa>(to_decimal(decimal));
+	}
+
+	static auto set_data(Cls &arr, const PackedByteArray &bytes) -> void {
+		ERR_FAIL_COND_MSG(bytes.size() % DATA_SIZE != 0,
+			method_name("set_data") + " - byte count has to be a multiple of " + String::num_int64(DATA_SIZE) + "."
+		);
+		arr.data = bytes;
+	}
+
+	static auto prepare_unary(const char *fn, const Ref<Cls> &a, const Ref<Cls> &out) -> bool {
+		ERR_FAIL_COND_V_MSG(a.is_null() || out.is_null(), false, method_name(fn) + " - arrays cannot be null.");
+
+		if (size(*out.ptr()) != size(*a.ptr())) {
+			resize(*out.ptr(), size(*a.ptr()));
+		}
+		return true;
+	}
+
+	static auto prepare_binary(const char *fn, const Ref<Cls> &a, const Ref<Cls> &b, const Ref<Cls> &out) -> bool {
+		ERR_FAIL_COND_V_MSG(a.is_null() || b.is_null() || out.is_null(), false, method_name(fn) + " - arrays cannot be null.");
+		ERR_FAIL_COND_V_MSG(size(*a.ptr()) != size(*b.ptr()), false,
+			method_name(fn) + " - size mismatch (" + String::num_int64(size(*a.ptr())) + " vs " + String::num_int64(size(*b.ptr())) + ")."
+		);
+
+		if (size(*out.ptr()) != size(*a.ptr())) {
+			resize(*out.ptr(), size(*a.ptr()));
+		}
+		return true;
+	}
+
+	// out[i] = op(a[i], b[i]). Same as in DecimalArray, `out` is fetched
+	// first in case it aliases one of the inputs.
+	template <typename Op>
+	static auto binary(const char *fn, const Ref<Cls> &a, const Ref<Cls> &b, const Ref<Cls> &out, Op op) -> void {
+		if (!prepare_binary(fn, a, b, out)) return;
+
+		auto *dst = ptrw(*out.ptr());
+		const auto *lhs = ptr(*a.ptr());
+		const auto *rhs = ptr(*b.ptr());
+
+		DecimalArray::for_each_chunk(size(*out.ptr()), [&](const int64_t begin, const int64_t end) {
+			for (auto i = begin; i < end; i++) {
+				dst[i] = op(lhs[i], rhs[i]);
+			}
+		});
+	}
+
+	template <typename Op>
+	static auto unary(const char *fn, const Ref<Cls> &a, const Ref<Cls> &out, Op op) -> void {
+		if (!prepare_unary(fn, a, out)) return;
+
+		auto *dst = ptrw(*out.ptr());
+		const auto *src = ptr(*a.ptr());
+
+		DecimalArray::for_each_chunk(size(*out.ptr()), [&](const int64_t begin, const int64_t end) {
+			for (auto i = begin; i < end; i++) {
+				dst[i] = op(src[i]);
+			}
+		});
+	}
+
+	static auto add(const Ref<Cls> &a, const Ref<Cls> &b, const Ref<Cls> &out) -> void {
+		binary("add", a, b, out, [](const Data &x, const Data &y) { return precision::add(x, y); });
+	}
+
+	static auto sub(const Ref<Cls> &a, const Ref<Cls> &b, const Ref<Cls> &out) -> void {
+		binary("sub", a, b, out, [](const Data &x, const Data &y) { return precision::sub(x, y); });
+	}
+
+	static auto mul(const Ref<Cls> &a, const Ref<Cls> &b, const Ref<Cls> &out) -> void {
+		binary("mul", a, b, out, [](const Data &x, const Data &y) { return precision::mul(x, y); });
+	}
+
+	static auto div(const Ref<Cls> &a, const Ref<Cls> &b, const Ref<Cls> &out) -> void {
+		binary("div", a, b, out, [](const Data &x, const Data &y) { return precision::div(x, y); });
+	}
+
+	static auto mul_num(const Ref<Cls> &a, const double n, const Ref<Cls> &out) -> void {
+		const auto factor = precision::from_float<Mantissa>(n);
+		unary("mul_num", a, out, [&](const Data &x) { return precision::mul(x, factor); });
+	}
+
+	static auto pow_num(const Ref<Cls> &a, const double exp, const Ref<Cls> &out) -> void {
+		unary("pow_num", a, out, [&](const Data &x) { return precision::pow_num(x, exp); });
+	}
+
+	// in order and at the array's own precision, that's the point of it
+	static auto sum(const Ref<Cls> &a) -> Vector4i {
+		ERR_FAIL_COND_V_MSG(a.is_null(), Vector4i(), method_name("sum") + " - array cannot be null.");
+
+		const auto count = size(*a.ptr());
+		if (count == 0) return to_vector4i(precision::to_decimal(Data()));
+
+		const auto *src = ptr(*a.ptr());
+		auto total = src[0];
+		for (int64_t i = 1; i < count; i++) {
+			total = precision::add(total, src[i]);
+		}
+		return to_vector4i(precision::to_decimal(total));
+	}
+};
+
+auto DecimalArray32::_bind_methods() -> void {
+	PrecisionArray<DecimalArray32>::bind();
+}
+
+auto DecimalArray32::to_decimals() const -> Ref<DecimalArray> {
+	return PrecisionArray<DecimalArray32>::to_decimals(*this);
+}
+
+auto DecimalArray32::size() const -> int64_t {
+	return PrecisionArray<DecimalArray32>::size(*this);
+}
+
+auto DecimalArray32::resize(const int64_t size) -> void {
+	PrecisionArray<DecimalArray32>::resize(*this, size);
+}
+
+auto DecimalArray32::get_at(const int64_t idx) const -> Vector4i {
+	return PrecisionArray<DecimalArray32>::get_at(*this, idx);
+}
+
+auto DecimalArray32::set_at(const int64_t idx, const Vector4i decimal) -> void {
+	PrecisionArray<DecimalArray32>::set_at(*this, idx, decimal);
+}
+
+auto DecimalArray32::append(const Vector4i decimal) -> void {
+	PrecisionArray<DecimalArray32>::append(*this, decimal);
+}
+
+auto DecimalArray32::get_data() const -> PackedByteArray {
+	return data;
+}
+
+auto DecimalArray32::set_data(const PackedByteArray &bytes) -> void {
+	PrecisionArray<DecimalArray32>::set_data(*this, bytes);
+}
+
+auto DecimalArray128::_bind_methods() -> void {
+	PrecisionArray<DecimalArray128>::bind();
+}
+
+auto DecimalArray128::to_decimals() const -> Ref<DecimalArray> {
+	return PrecisionArray<DecimalArray128>::to_decimals(*this);
+}
+
+auto DecimalArray128::size() const -> int64_t {
+	return PrecisionArray<DecimalArray128>::size(*this);
+}
+
+auto DecimalArray128::resize(const int64_t size) -> void {
+	PrecisionArray<DecimalArray128>::resize(*this, size);
+}
+
+auto DecimalArray128::get_at(const int64_t idx) const -> Vector4i {
+	return PrecisionArray<DecimalArray128>::get_at(*this, idx);
+}
+
+auto DecimalArray128::set_at(const int64_t idx, const Vector4i decimal) -> void {
+	PrecisionArray<DecimalArray128>::set_at(*this, idx, decimal);
+}
+
+auto DecimalArray128::append(const Vector4i decimal) -> void {
+	PrecisionArray<DecimalArray128>::append(*this, decimal);
+}
+
+auto DecimalArray128::get_data() const -> PackedByteArray {
+	return data;
+}
+
+auto DecimalArray128::set_data(const PackedByteArray &bytes) -> void {
+	PrecisionArray<DecimalArray128>::set_data(*this, bytes);
+}
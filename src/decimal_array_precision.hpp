@@ -0,0 +1,84 @@
+#pragma once
+
+#include "godot_cpp/classes/ref_counted.hpp"
+#include "godot_cpp/variant/packed_byte_array.hpp"
+#include "godot_cpp/variant/vector4i.hpp"
+
+#include "decimal_array.hpp"
+#include "decimal_precision.hpp"
+
+#include <cstdint>
+
+using namespace godot;
+
+// DecimalArray, but with a float mantissa (DecimalArray32) or a double-double
+// one (DecimalArray128), see decimal_precision.hpp. Values go in and come out
+// as regular Decimals, the other precision is only used for what happens in
+// between.
+//
+// Both have the same methods. The static ones (create, from_decimals and the
+// batch ops) are bound straight from a template in the .cpp that's shared
+// between the two, which is why it's a friend of both.
+
+template <typename Cls>
+struct PrecisionArray;
+
+class DecimalArray32 : public RefCounted {
+
+	GDCLASS(DecimalArray32, RefCounted)
+
+protected:
+	static auto _bind_methods() -> void;
+
+private:
+	template <typename Cls>
+	friend struct PrecisionArray;
+
+	PackedByteArray data;
+
+public:
+	using Mantissa = float;
+	using Data = BasicDecimal<Mantissa>;
+
+	auto to_decimals() const -> Ref<DecimalArray>;
+
+	auto size() const -> int64_t;
+	auto resize(const int64_t size) -> void;
+
+	auto get_at(const int64_t idx) const -> Vector4i;
+	auto set_at(const int64_t idx, const Vector4i decimal) -> void;
+	auto append(const Vector4i decimal) -> void;
+
+	auto get_data() const -> PackedByteArray;
+	auto set_data(const PackedByteArray &bytes) -> void;
+};
+
+class DecimalArray128 : public RefCounted {
+
+	GDCLASS(DecimalArray128, RefCounted)
+
+protected:
+	static auto _bind_methods() -> void;
+
+private:
+	template <typename Cls>
+	friend struct PrecisionArray;
+
+	PackedByteArray data;
+
+public:
+	using Mantissa = decimal_precision::DoubleDouble;
+	using Data = BasicDecimal<Mantissa>;
+
+	auto to_decimals() const -> Ref<DecimalArray>;
+
+	auto size() const -> int64_t;
+	auto resize(const int64_t size) -> void;
+
+	auto get_at(const int64_t idx) const -> Vector4i;
+	auto set_at(const int64_t idx, const Vector4i decimal) -> void;
+	auto append(const Vector4i decimal) -> void;
+
+	auto get_data() const -> PackedByteArray;
+	auto set_data(const PackedByteArray &bytes) -> void;
+};
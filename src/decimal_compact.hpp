@@ -0,0 +1,208 @@
+#pragma once
+
+// Smaller in-memory layouts for big arrays of decimals, without any Godot
+// dependency. (decimal_pack.hpp is about serializing, this is about keeping
+// values around in memory and scanning them.)
+//
+// - Compact8: a float mantissa and an int32 exponent, about 7 digits.
+// - Compact12: a double mantissa and an int32 exponent, every digit of a
+//   DecimalData. Packed to 12 bytes, so the mantissa is only 4-byte aligned.
+//
+// Turning either back into a DecimalData is always exact. The other way
+// around is exact as long as the exponent fits in an int32 (and for Compact8,
+// the mantissa in a float); exponents past that saturate, to infinity going up
+// and to zero going down. Infinities and NaN keep the 0 exponent they have in
+// a DecimalData.
+//
+// The batch ops read and write the compact form directly, widening one
+// element at a time, so a scan over a Compact8 array only moves half the
+// bytes of the same scan over DecimalData.
+
+#include "decimal_core.hpp"
+#include "decimal_precision.hpp"
+#include "decimal_sort.hpp"
+#include "decimal_sum.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+struct Compact8 {
+	float mantissa;
+	int32_t exponent;
+};
+
+#pragma pack(push, 4)
+struct Compact12 {
+	double mantissa;
+	int32_t exponent;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(Compact8) == 8, "Compact8 is expected to be exactly 8 bytes.");
+static_assert(sizeof(Compact12) == 12, "Compact12 is expected to be exactly 12 bytes.");
+
+namespace decimal_compact {
+
+namespace core = decimal_core;
+namespace precision = decimal_precision;
+
+template <typename C>
+struct Traits;
+
+template <>
+struct Traits<Compact8> {
+	using Mantissa = float;
+};
+
+template <>
+struct Traits<Compact12> {
+	using Mantissa = double;
+};
+
+// the math runs on these, with the full int64 exponent
+template <typename C>
+using Wide = BasicDecimal<typename Traits<C>::Mantissa>;
+
+constexpr const int64_t EXP_MIN = std::numeric_limits<int32_t>::min();
+constexpr const int64_t EXP_MAX = std::numeric_limits<int32_t>::max();
+
+template <typename C>
+inline auto widen(const C &c) -> Wide<C> {
+	return Wide<C>(c.mantissa, c.exponent);
+}
+
+// a normalized value, saturated into the int32 exponent range
+template <typename C>
+inline auto narrow(const Wide<C> &dec) -> C {
+	using M = typename Traits<C>::Mantissa;
+
+	if (DECIMAL_UNLIKELY(dec.exponent > EXP_MAX)) {
+		return C { dec.mantissa * std::numeric_limits<M>::infinity(), 0 };
+	}
+	if (DECIMAL_UNLIKELY(dec.exponent < EXP_MIN)) {
+		return C { dec.mantissa * M(0), 0 };
+	}
+	return C { dec.mantissa, static_cast<int32_t>(dec.exponent) };
+}
+
+// The mantissa of a Compact8 is a normalized float, so it stays within
+// [1, 10) as a double and this doesn't need to normalize.
+template <typename C>
+inline auto to_decimal(const C &c) -> DecimalData {
+	return DecimalData(c.mantissa, c.exponent);
+}
+
+// `dec` has to be normalized. Returns whether nothing was lost on the way.
+template <typename C>
+inline auto from_decimal(const DecimalData &dec, C &out) -> bool {
+	out = narrow<C>(precision::from_decimal<typename Traits<C>::Mantissa>(dec));
+
+	if (DECIMAL_UNLIKELY(std::isnan(dec.mantissa))) {
+		return true;
+	}
+	return out.mantissa == dec.mantissa && out.exponent == dec.exponent;
+}
+
+// from_decimal() for a whole array, returning how many elements weren't exact
+template <typename C>
+inline auto from_decimals(const DecimalData *src, const int64_t n, C *dst) -> int64_t {
+	int64_t inexact = 0;
+	for (int64_t i = 0; i < n; i++) {
+		inexact += !from_decimal(src[i], dst[i]);
+	}
+	return inexact;
+}
+
+template <typename C>
+inline auto to_decimals(const C *src, const int64_t n, DecimalData *dst) -> void {
+	for (int64_t i = 0; i < n; i++) {
+		dst[i] = to_decimal(src[i]);
+	}
+}
+
+template <typename C>
+inline auto add(const C *a, const C *b, C *dst, const int64_t n) -> void {
+	for (int64_t i = 0; i < n; i++) {
+		dst[i] = narrow<C>(precision::add(widen(a[i]), widen(b[i])));
+	}
+}
+
+template <typename C>
+inline auto sub(const C *a, const C *b, C *dst, const int64_t n) -> void {
+	for (int64_t i = 0; i < n; i++) {
+		dst[i] = narrow<C>(precision::sub(widen(a[i]), widen(b[i])));
+	}
+}
+
+template <typename C>
+inline auto mul(const C *a, const C *b, C *dst, const int64_t n) -> void {
+	for (int64_t i = 0; i < n; i++) {
+		dst[i] = narrow<C>(precision::mul(widen(a[i]), widen(b[i])));
+	}
+}
+
+template <typename C>
+inline auto mul_num(const C *a, const double b, C *dst, const int64_t n) -> void {
+	const auto factor = precision::from_float<typename Traits<C>::Mantissa>(b);
+	for (int64_t i = 0; i < n; i++) {
+		dst[i] = narrow<C>(precision::mul(widen(a[i]), factor));
+	}
+}
+
+// Masks of a[i] >= b and a[i] <= b, laid out like the decimal_simd ones. The
+// comparison happens against the exact DecimalData, so `b` doesn't get
+// rounded to the compact precision first.
+template <typename C, typename Cmp>
+inline auto scalar_mask(const C *a, const DecimalData &b, uint8_t *mask, const int64_t n, Cmp cmp) -> void {
+	for (int64_t i = 0; i < n; i += 8) {
+		const auto end = i + 8 < n ? i + 8 : n;
+		uint8_t bits = 0;
+		for (auto j = i; j < end; j++) {
+			bits |= static_cast<uint8_t>(cmp(to_decimal(a[j]), b) << (j - i));
+		}
+		mask[i / 8] = bits;
+	}
+}
+
+template <typename C>
+inline auto ge_scalar_mask(const C *a, const DecimalData &b, uint8_t *mask, const int64_t n) -> void {
+	scalar_mask(a, b, mask, n, [](const DecimalData &x, const DecimalData &y) { return core::ge(x, y); });
+}
+
+template <typename C>
+inline auto le_scalar_mask(const C *a, const DecimalData &b, uint8_t *mask, const int64_t n) -> void {
+	scalar_mask(a, b, mask, n, [](const DecimalData &x, const DecimalData &y) { return core::le(x, y); });
+}
+
+// the sum at full DecimalData precision, see decimal_sum.hpp
+template <typename C>
+inline auto sum(const C *a, const int64_t n) -> DecimalData {
+	decimal_sum::Accumulator acc;
+	for (int64_t i = 0; i < n; i++) {
+		acc.add(to_decimal(a[i]));
+	}
+	return acc.read();
+}
+
+// Index of the largest element (the first one on ties), -1 if there's none.
+// Ordered like DecimalArray.sort(), so infinities count as the largest and
+// smallest values, and NaN is skipped.
+template <typename C>
+inline auto max_index(const C *a, const int64_t n) -> int64_t {
+	int64_t best = -1;
+	decimal_sort::SortKey best_key {};
+	for (int64_t i = 0; i < n; i++) {
+		const auto value = to_decimal(a[i]);
+		if (DECIMAL_UNLIKELY(std::isnan(value.mantissa))) continue;
+
+		const auto key = decimal_sort::sort_key(value);
+		if (best < 0 || best_key < key) {
+			best = i;
+			best_key = key;
+		}
+	}
+	return best;
+}
+
+} // namespace decimal_compact
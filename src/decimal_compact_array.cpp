@@ -0,0 +1,280 @@
+#include "decimal_compact_array.hpp"
+#include "godot_cpp/core/error_macros.hpp"
+#include "godot_cpp/core/object.hpp"
+#include <cstdint>
+#include <godot_cpp/core/class_db.hpp>
+
+using namespace godot;
+namespace compact = decimal_compact;
+
+auto DecimalCompactArray::_bind_methods() -> void {
+	ClassDB::bind_static_method("DecimalCompactArray", D_METHOD("create", "size", "format"), &DecimalCompactArray::create, DEFVAL(FORMAT_8));
+	ClassDB::bind_static_method("DecimalCompactArray", D_METHOD("from_decimals", "values", "format"), &DecimalCompactArray::from_decimals, DEFVAL(FORMAT_8));
+	ClassDB::bind_static_method("DecimalCompactArray", D_METHOD("count_inexact", "values", "format"), &DecimalCompactArray::count_inexact, DEFVAL(FORMAT_8));
+	ClassDB::bind_method(D_METHOD("to_decimals"), &DecimalCompactArray::to_decimals);
+
+	ClassDB::bind_method(D_METHOD("get_format"), &DecimalCompactArray::get_format);
+
+	ClassDB::bind_method(D_METHOD("size"), &DecimalCompactArray::size);
+	ClassDB::bind_method(D_METHOD("resize", "size"), &DecimalCompactArray::resize);
+
+	ClassDB::bind_method(D_METHOD("get_at", "idx"), &DecimalCompactArray::get_at);
+	ClassDB::bind_method(D_METHOD("set_at", "idx", "decimal"), &DecimalCompactArray::set_at);
+	ClassDB::bind_method(D_METHOD("append", "decimal"), &DecimalCompactArray::append);
+
+	ClassDB::bind_method(D_METHOD("get_data"), &DecimalCompactArray::get_data);
+	ClassDB::bind_method(D_METHOD("set_data", "bytes"), &DecimalCompactArray::set_data);
+
+	ClassDB::bind_static_method("DecimalCompactArray", D_METHOD("add", "a", "b", "out"), &DecimalCompactArray::add);
+	ClassDB::bind_static_method("DecimalCompactArray", D_METHOD("sub", "a", "b", "out"), &DecimalCompactArray::sub);
+	ClassDB::bind_static_method("DecimalCompactArray", D_METHOD("mul", "a", "b", "out"), &DecimalCompactArray::mul);
+	ClassDB::bind_static_method("DecimalCompactArray", D_METHOD("mul_num", "a", "n", "out"), &DecimalCompactArray::mul_num);
+
+	ClassDB::bind_static_method("DecimalCompactArray", D_METHOD("ge_scalar_mask", "values", "x"), &DecimalCompactArray::ge_scalar_mask);
+	ClassDB::bind_static_method("DecimalCompactArray", D_METHOD("le_scalar_mask", "values", "x"), &DecimalCompactArray::le_scalar_mask);
+	ClassDB::bind_static_method("DecimalCompactArray", D_METHOD("sum", "a"), &DecimalCompactArray::sum);
+	ClassDB::bind_static_method("DecimalCompactArray", D_METHOD("max_index", "a"), &DecimalCompactArray::max_index);
+
+	BIND_ENUM_CONSTANT(FORMAT_8);
+	BIND_ENUM_CONSTANT(FORMAT_12);
+}
+
+auto DecimalCompactArray::element_size() const -> int64_t {
+	return dispatch([](auto c) { return static_cast<int64_t>(sizeof(c)); });
+}
+
+auto DecimalCompactArray::create(const int64_t size, const Format format) -> Ref<DecimalCompactArray> {
+	ERR_FAIL_COND_V_MSG(size < 0, Ref<DecimalCompactArray>(), "DecimalCompactArray.create() - size cannot be negative.");
+	ERR_FAIL_COND_V_MSG(format != FORMAT_8 && format != FORMAT_12, Ref<DecimalCompactArray>(),
+		"DecimalCompactArray.create() - unknown format " + String::num_int64(format) + "."
+	);
+
+	Ref<DecimalCompactArray> arr;
+	arr.instantiate();
+	arr->format = format;
+	arr->resize(size);
+	return arr;
+}
+
+auto DecimalCompactArray::from_decimals(const Ref<DecimalArray> &values, const Format format) -> Ref<DecimalCompactArray> {
+	ERR_FAIL_COND_V_MSG(values.is_null(), Ref<DecimalCompactArray>(), "DecimalCompactArray.from_decimals() - `values` cannot be null.");
+
+	auto arr = create(values->size(), format);
+	if (arr.is_null()) return arr;
+
+	arr->dispatch([&](auto c) {
+		using C = decltype(c);
+		compact::from_decimals(values->ptr(), values->size(), arr->ptrw<C>());
+	});
+	return arr;
+}
+
+auto DecimalCompactArray::count_inexact(const Ref<DecimalArray> &values, const Format format) -> int64_t {
+	ERR_FAIL_COND_V_MSG(values.is_null(), 0, "DecimalCompactArray.count_inexact() - `values` cannot be null.");
+
+	const auto *src = values->ptr();
+	int64_t inexact = 0;
+	if (format == FORMAT_12) {
+		Compact12 c;
+		for (int64_t i = 0; i < values->size(); i++) {
+			inexact += !compact::from_decimal(src[i], c);
+		}
+	} else {
+		Compact8 c;
+		for (int64_t i = 0; i < values->size(); i++) {
+			inexact += !compact::from_decimal(src[i], c);
+		}
+	}
+	return inexact;
+}
+
+auto DecimalCompactArray::to_decimals() const -> Ref<DecimalArray> {
+	auto res = DecimalArray::create(size());
+	dispatch([&](auto c) {
+		using C = decltype(c);
+		compact::to_decimals(ptr<C>(), size(), res->ptrw());
+	});
+	return res;
+}
+
+auto DecimalCompactArray::get_format() const -> Format {
+	return format;
+}
+
+auto DecimalCompactArray::size() const -> int64_t {
+	return data.size() / element_size();
+}
+
+auto DecimalCompactArray::resize(const int64_t size) -> void {
+	ERR_FAIL_COND_MSG(size < 0, "DecimalCompactArray.resize() - size cannot be negative.");
+
+	const auto old_size = this->size();
+	data.resize(size * element_size());
+
+	dispatch([&](auto c) {
+		using C = decltype(c);
+		auto *dst = ptrw<C>();
+		for (auto i = old_size; i < size; i++) {
+			dst[i] = C {};
+		}
+	});
+}
+
+auto DecimalCompactArray::get_at(const int64_t idx) const -> Vector4i {
+	ERR_FAIL_INDEX_V_MSG(idx, size(), Vector4i(), "DecimalCompactArray.get_at() - index out of bounds.");
+	return dispatch([&](auto c) {
+		using C = decltype(c);
+		return to_vector4i(compact::to_decimal(ptr<C>()[idx]));
+	});
+}
+
+auto DecimalCompactArray::set_at(const int64_t idx, const Vector4i decimal) -> void {
+	ERR_FAIL_INDEX_MSG(idx, size(), "DecimalCompactArray.set_at() - index out of bounds.");
+	dispatch([&](auto c) {
+		using C = decltype(c);
+		compact::from_decimal(to_decimal(decimal), ptrw<C>()[idx]);
+	});
+}
+
+auto DecimalCompactArray::append(const Vector4i decimal) -> void {
+	const auto idx = size();
+	resize(idx + 1);
+	set_at(idx, decimal);
+}
+
+auto DecimalCompactArray::get_data() const -> PackedByteArray {
+	return data;
+}
+
+auto DecimalCompactArray::set_data(const PackedByteArray &bytes) -> void {
+	ERR_FAIL_COND_MSG(bytes.size() % element_size() != 0,
+		"DecimalCompactArray.set_data() - byte count has to be a multiple of " + String::num_int64(element_size()) + "."
+	);
+	data = bytes;
+}
+
+// Like in DecimalArray, callers fetch the output pointer before the input
+// ones, in case `out` aliases an input. `out` takes on the format of `a`.
+auto DecimalCompactArray::prepare_unary(const char *fn, const Ref<DecimalCompactArray> &a, const Ref<DecimalCompactArray> &out) -> bool {
+	ERR_FAIL_COND_V_MSG(a.is_null() || out.is_null(), false, String("DecimalCompactArray.") + fn + "() - arrays cannot be null.");
+
+	if (out->format != a->format) {
+		out->data.resize(0);
+		out->format = a->format;
+	}
+	if (out->size() != a->size()) {
+		out->resize(a->size());
+	}
+	return true;
+}
+
+auto DecimalCompactArray::prepare_binary(const char *fn, const Ref<DecimalCompactArray> &a, const Ref<DecimalCompactArray> &b, const Ref<DecimalCompactArray> &out) -> bool {
+	ERR_FAIL_COND_V_MSG(a.is_null() || b.is_null() || out.is_null(), false, String("DecimalCompactArray.") + fn + "() - arrays cannot be null.");
+	ERR_FAIL_COND_V_MSG(a->format != b->format, false, String("DecimalCompactArray.") + fn + "() - both arrays must have the same format.");
+	ERR_FAIL_COND_V_MSG(a->size() != b->size(), false,
+		String("DecimalCompactArray.") + fn + "() - size mismatch (" + String::num_int64(a->size()) + " vs " + String::num_int64(b->size()) + ")."
+	);
+
+	return prepare_unary(fn, a, out);
+}
+
+auto DecimalCompactArray::add(const Ref<DecimalCompactArray> &a, const Ref<DecimalCompactArray> &b, const Ref<DecimalCompactArray> &out) -> void {
+	if (!prepare_binary("add", a, b, out)) return;
+
+	a->dispatch([&](auto c) {
+		using C = decltype(c);
+		auto *dst = out->ptrw<C>();
+		const auto *lhs = a->ptr<C>();
+		const auto *rhs = b->ptr<C>();
+
+		DecimalArray::for_each_chunk(out->size(), [&](const int64_t begin, const int64_t end) {
+			compact::add(lhs + begin, rhs + begin, dst + begin, end - begin);
+		});
+	});
+}
+
+auto DecimalCompactArray::sub(const Ref<DecimalCompactArray> &a, const Ref<DecimalCompactArray> &b, const Ref<DecimalCompactArray> &out) -> void {
+	if (!prepare_binary("sub", a, b, out)) return;
+
+	a->dispatch([&](auto c) {
+		using C = decltype(c);
+		auto *dst = out->ptrw<C>();
+		const auto *lhs = a->ptr<C>();
+		const auto *rhs = b->ptr<C>();
+
+		DecimalArray::for_each_chunk(out->size(), [&](const int64_t begin, const int64_t end) {
+			compact::sub(lhs + begin, rhs + begin, dst + begin, end - begin);
+		});
+	});
+}
+
+auto DecimalCompactArray::mul(const Ref<DecimalCompactArray> &a, const Ref<DecimalCompactArray> &b, const Ref<DecimalCompactArray> &out) -> void {
+	if (!prepare_binary("mul", a, b, out)) return;
+
+	a->dispatch([&](auto c) {
+		using C = decltype(c);
+		auto *dst = out->ptrw<C>();
+		const auto *lhs = a->ptr<C>();
+		const auto *rhs = b->ptr<C>();
+
+		DecimalArray::for_each_chunk(out->size(), [&](const int64_t begin, const int64_t end) {
+			compact::mul(lhs + begin, rhs + begin, dst + begin, end - begin);
+		});
+	});
+}
+
+auto DecimalCompactArray::mul_num(const Ref<DecimalCompactArray> &a, const double n, const Ref<DecimalCompactArray> &out) -> void {
+	if (!prepare_unary("mul_num", a, out)) return;
+
+	a->dispatch([&](auto c) {
+		using C = decltype(c);
+		auto *dst = out->ptrw<C>();
+		const auto *src = a->ptr<C>();
+
+		DecimalArray::for_each_chunk(out->size(), [&](const int64_t begin, const int64_t end) {
+			compact::mul_num(src + begin, n, dst + begin, end - begin);
+		});
+	});
+}
+
+auto DecimalCompactArray::ge_scalar_mask(const Ref<DecimalCompactArray> &values, const Vector4i x) -> PackedByteArray {
+	ERR_FAIL_COND_V_MSG(values.is_null(), PackedByteArray(), "DecimalCompactArray.ge_scalar_mask() - array cannot be null.");
+
+	PackedByteArray mask;
+	mask.resize((values->size() + 7) / 8);
+	values->dispatch([&](auto c) {
+		using C = decltype(c);
+		compact::ge_scalar_mask(values->ptr<C>(), to_decimal(x), mask.ptrw(), values->size());
+	});
+	return mask;
+}
+
+auto DecimalCompactArray::le_scalar_mask(const Ref<DecimalCompactArray> &values, const Vector4i x) -> PackedByteArray {
+	ERR_FAIL_COND_V_MSG(values.is_null(), PackedByteArray(), "DecimalCompactArray.le_scalar_mask() - array cannot be null.");
+
+	PackedByteArray mask;
+	mask.resize((values->size() + 7) / 8);
+	values->dispatch([&](auto c) {
+		using C = decltype(c);
+		compact::le_scalar_mask(values->ptr<C>(), to_decimal(x), mask.ptrw(), values->size());
+	});
+	return mask;
+}
+
+auto DecimalCompactArray::sum(const Ref<DecimalCompactArray> &a) -> Vector4i {
+	ERR_FAIL_COND_V_MSG(a.is_null(), Vector4i(), "DecimalCompactArray.sum() - array cannot be null.");
+
+	return a->dispatch([&](auto c) {
+		using C = decltype(c);
+		return to_vector4i(compact::sum(a->ptr<C>(), a->size()));
+	});
+}
+
+auto DecimalCompactArray::max_index(const Ref<DecimalCompactArray> &a) -> int64_t {
+	ERR_FAIL_COND_V_MSG(a.is_null(), -1, "DecimalCompactArray.max_index() - array cannot be null.");
+
+	return a->dispatch([&](auto c) {
+		using C = decltype(c);
+		return compact::max_index(a->ptr<C>(), a->size());
+	});
+}
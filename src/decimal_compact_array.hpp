@@ -0,0 +1,83 @@
+#pragma once
+
+#include "godot_cpp/classes/ref_counted.hpp"
+#include "godot_cpp/core/binder_common.hpp"
+#include "godot_cpp/variant/packed_byte_array.hpp"
+#include "godot_cpp/variant/vector4i.hpp"
+
+#include "decimal_array.hpp"
+#include "decimal_compact.hpp"
+
+#include <cstdint>
+
+using namespace godot;
+
+// An array of decimals in one of the smaller layouts of decimal_compact.hpp,
+// 8 or 12 bytes per element instead of 16. For keeping huge numbers of values
+// around (history buffers, per-player tables) and scanning over them; the
+// values come in and go out as regular decimals.
+class DecimalCompactArray : public RefCounted {
+
+	GDCLASS(DecimalCompactArray, RefCounted)
+
+public:
+	enum Format {
+		FORMAT_8,
+		FORMAT_12,
+	};
+
+protected:
+	static auto _bind_methods() -> void;
+
+private:
+	Format format = FORMAT_8;
+	PackedByteArray data;
+
+	auto element_size() const -> int64_t;
+
+	// calls fn(C()) with C being the Compact8 or Compact12 the array holds
+	template <typename F>
+	auto dispatch(F &&fn) const -> decltype(auto) {
+		if (format == FORMAT_12) return fn(Compact12());
+		return fn(Compact8());
+	}
+
+	template <typename C>
+	auto ptr() const -> const C * { return reinterpret_cast<const C *>(data.ptr()); }
+
+	template <typename C>
+	auto ptrw() -> C * { return reinterpret_cast<C *>(data.ptrw()); }
+
+	static auto prepare_binary(const char *fn, const Ref<DecimalCompactArray> &a, const Ref<DecimalCompactArray> &b, const Ref<DecimalCompactArray> &out) -> bool;
+	static auto prepare_unary(const char *fn, const Ref<DecimalCompactArray> &a, const Ref<DecimalCompactArray> &out) -> bool;
+
+public:
+	static auto create(const int64_t size, const Format format = FORMAT_8) -> Ref<DecimalCompactArray>;
+	static auto from_decimals(const Ref<DecimalArray> &values, const Format format = FORMAT_8) -> Ref<DecimalCompactArray>;
+	static auto count_inexact(const Ref<DecimalArray> &values, const Format format = FORMAT_8) -> int64_t;
+	auto to_decimals() const -> Ref<DecimalArray>;
+
+	auto get_format() const -> Format;
+
+	auto size() const -> int64_t;
+	auto resize(const int64_t size) -> void;
+
+	auto get_at(const int64_t idx) const -> Vector4i;
+	auto set_at(const int64_t idx, const Vector4i decimal) -> void;
+	auto append(const Vector4i decimal) -> void;
+
+	auto get_data() const -> PackedByteArray;
+	auto set_data(const PackedByteArray &bytes) -> void;
+
+	static auto add(const Ref<DecimalCompactArray> &a, const Ref<DecimalCompactArray> &b, const Ref<DecimalCompactArray> &out) -> void;
+	static auto sub(const Ref<DecimalCompactArray> &a, const Ref<DecimalCompactArray> &b, const Ref<DecimalCompactArray> &out) -> void;
+	static auto mul(const Ref<DecimalCompactArray> &a, const Ref<DecimalCompactArray> &b, const Ref<DecimalCompactArray> &out) -> void;
+	static auto mul_num(const Ref<DecimalCompactArray> &a, const double n, const Ref<DecimalCompactArray> &out) -> void;
+
+	static auto ge_scalar_mask(const Ref<DecimalCompactArray> &values, const Vector4i x) -> PackedByteArray;
+	static auto le_scalar_mask(const Ref<DecimalCompactArray> &values, const Vector4i x) -> PackedByteArray;
+	static auto sum(const Ref<DecimalCompactArray> &a) -> Vector4i;
+	static auto max_index(const Ref<DecimalCompactArray> &a) -> int64_t;
+};
+
+VARIANT_ENUM_CAST(DecimalCompactArray::Format);
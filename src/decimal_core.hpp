@@ -0,0 +1,750 @@
+#pragma once
+
+// All the math behind Decimal, without any Godot dependency. Everything here is
+// inline, so C++ callers (native modules, headless simulations...) can use it
+// directly and let the compiler inline the whole chain. The Decimal class only
+// converts from and to Vector4i, and forwards here.
+//
+// Nothing in here reports errors; invalid inputs just produce NaN. Printing
+// warnings is left to the binding layer.
+
+#include "decimal_constants.hpp"
+#include "decimal_counters.hpp"
+#include "decimal_fastmath.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <limits>
+
+#if defined(__GNUC__) || defined(__clang__)
+	#define DECIMAL_LIKELY(x) __builtin_expect(!!(x), 1)
+	#define DECIMAL_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+	#define DECIMAL_LIKELY(x) (x)
+	#define DECIMAL_UNLIKELY(x) (x)
+#endif
+
+// The stored number is equal to: mantissa × 10^exponent
+//
+// Normalized values keep the mantissa in [1, 10) (or exactly 0). The mantissa
+// type is a template parameter so that other precisions can share the layout
+// (see decimal_precision.hpp), but everything in this file works on doubles.
+template <typename M>
+struct BasicDecimal {
+	M mantissa;
+	int64_t exponent;
+
+	constexpr BasicDecimal() : mantissa(), exponent(0) {}
+	constexpr BasicDecimal(const M m, const int64_t e) : mantissa(m), exponent(e) {}
+};
+
+// This is a trivially copyable 16 byte POD, so it can be bitcast to anything
+// else that happens to be 16 bytes.
+using DecimalData = BasicDecimal<double>;
+
+static_assert(sizeof(DecimalData) == 16, "DecimalData is expected to be exactly 16 bytes.");
+
+namespace decimal_core {
+
+inline constexpr const auto DECIMAL_ZERO = DecimalData(0.0, 0);
+inline constexpr const auto DECIMAL_ZERO_NEG = DecimalData(-0.0, 0);
+
+inline constexpr const auto DECIMAL_ONE = DecimalData(1.0, 0);
+inline constexpr const auto DECIMAL_ONE_NEG = DecimalData(-1.0, 0);
+
+inline constexpr const auto DECIMAL_INF = DecimalData(
+	std::numeric_limits<double>::infinity(), 0
+);
+
+inline constexpr const auto DECIMAL_INF_NEG = DecimalData(
+	-std::numeric_limits<double>::infinity(), 0
+);
+
+inline constexpr const auto DECIMAL_NAN = DecimalData(
+	std::numeric_limits<double>::signaling_NaN(), 0
+);
+
+// 10^exp from the lookup table, NaN if it's out of range
+inline auto pow10(const int64_t exp) -> double {
+	const auto idx = static_cast<uint64_t>(exp + POW10_OFFSET);
+	if (DECIMAL_UNLIKELY(idx >= std::size(POW10_LOOKUP))) {
+		return std::numeric_limits<double>::signaling_NaN();
+	}
+	return POW10_LOOKUP[idx];
+}
+
+// floor(e * log10(2)) == (e * 78913) >> 18 for every binary exponent a double
+// can have. The bias keeps the product positive, so SIMD code can get away with
+// a logical shift (there's no 64-bit arithmetic shift before AVX-512).
+constexpr const int64_t LOG10_2_MUL = 78913;
+constexpr const int64_t LOG10_2_SHIFT = 18;
+constexpr const int64_t LOG10_2_BIAS = 400;
+
+constexpr const int64_t DOUBLE_BIAS = 1023;
+constexpr const int64_t DOUBLE_EXP_SPECIAL = 2047;
+
+// Powers of 10 up to this are exact doubles, so their reciprocals (1e-1,
+// 1e-2...) aren't. Scaling by 10^-k is done with a multiply everywhere except
+// for 1 <= k <= this, where dividing by the exact power is the only way to get
+// correctly rounded results (multiplying 30 by 0.1 gives 3.0000000000000004).
+constexpr const int64_t POW10_EXACT_MAX = 22;
+
+// Subnormals only have a few bits of precision left, and so do the entries of
+// the lookup table down there. Scaling them into the normal range first keeps
+// the mantissa within [1, 10) and avoids a special case for 1e-324.
+constexpr const double SUBNORMAL_SCALE = 1e16;
+constexpr const int64_t SUBNORMAL_SCALE_EXP = 16;
+
+// floor(log10(abs)) for a finite, positive and normal `abs`
+inline auto floor_log10(const double abs) -> int64_t {
+	uint64_t bits;
+	memcpy(&bits, &abs, sizeof(bits));
+
+	const int64_t exp2 = static_cast<int64_t>(bits >> 52) - DOUBLE_BIAS;
+	const int64_t exp10 = ((exp2 * LOG10_2_MUL + (LOG10_2_BIAS << LOG10_2_SHIFT)) >> LOG10_2_SHIFT) - LOG10_2_BIAS;
+
+	// the estimate above is either exact or one too small
+	return exp10 + (abs >= POW10_LOOKUP[exp10 + 1 + POW10_OFFSET]);
+}
+
+// m * 10^-k, for any k that floor_log10() can return
+inline auto scale_pow10(const double m, const int64_t k) -> double {
+	return (k > 0 && k <= POW10_EXACT_MAX) ?
+		m / POW10_LOOKUP[k + POW10_OFFSET] :
+		m * POW10_LOOKUP[-k + POW10_OFFSET];
+}
+
+// Doesn't use log10 or any divisions outside of the exact range above. The
+// exponent comes from the binary exponent of the mantissa, which is then
+// scaled with a single multiply from the lookup table.
+inline auto normalize(const DecimalData &dec) -> DecimalData {
+	DECIMAL_COUNT(NORMALIZE);
+
+	if (dec.mantissa == 0) {
+		return DECIMAL_ZERO;
+	}
+
+	if (DECIMAL_UNLIKELY(!std::isfinite(dec.mantissa))) {
+		return dec;
+	}
+
+	const auto subnormal = std::abs(dec.mantissa) < std::numeric_limits<double>::min();
+	const auto m = DECIMAL_UNLIKELY(subnormal) ? dec.mantissa * SUBNORMAL_SCALE : dec.mantissa;
+	const auto k = floor_log10(std::abs(m));
+	const auto exp = dec.exponent + k - (subnormal ? SUBNORMAL_SCALE_EXP : 0);
+	const auto res = scale_pow10(m, k);
+
+	// Beyond 1e22 the table entries are rounded, which can push a mantissa
+	// that's within an ulp of a power of 10 just outside of [1, 10).
+	const auto res_abs = std::abs(res);
+	if (DECIMAL_UNLIKELY(res_abs < 1.0)) {
+		return DecimalData(std::copysign(1.0, res), exp);
+	}
+	if (DECIMAL_UNLIKELY(res_abs >= 10.0)) {
+		return DecimalData(std::copysign(1.0, res), exp + 1);
+	}
+	return DecimalData(res, exp);
+}
+
+// no normalization, the caller has to make sure the mantissa is in range
+constexpr auto from_parts(const double mantissa, const int64_t exponent) -> DecimalData {
+	return (mantissa == 0 && exponent == 0) ? DECIMAL_ZERO : DecimalData(mantissa, exponent);
+}
+
+inline auto from_parts_normalize(const double mantissa, const int64_t exponent) -> DecimalData {
+	if (mantissa == 0 && exponent == 0) {
+		return DECIMAL_ZERO;
+	}
+	return normalize(DecimalData(mantissa, exponent));
+}
+
+inline auto from_float(const double num) -> DecimalData {
+	return normalize(DecimalData(num, 0));
+}
+
+inline auto into_float(const DecimalData &dec) -> double {
+	return dec.mantissa * pow10(dec.exponent);
+}
+
+inline auto is_finite(const DecimalData &dec) -> bool {
+	return std::isfinite(dec.mantissa);
+}
+
+inline auto abs(const DecimalData &dec) -> DecimalData {
+	return DecimalData(std::fabs(dec.mantissa), dec.exponent);
+}
+
+constexpr auto neg(const DecimalData &dec) -> DecimalData {
+	return DecimalData(dec.mantissa * -1, dec.exponent);
+}
+
+constexpr auto sign(const DecimalData &dec) -> int64_t {
+	return dec.mantissa > 0 ?
+		+1 : dec.mantissa < 0 ?
+		-1 :
+		+0;
+}
+
+inline auto add(const DecimalData &d1, const DecimalData &d2) -> DecimalData {
+	const auto &d_bigger  = d1.exponent > d2.exponent ? d1 : d2;
+	const auto &d_smaller = d1.exponent > d2.exponent ? d2 : d1;
+
+// if the difference in exponents in addition/subtraction is at least
+// this much apart, then the smaller number will be simply discarded
+// (cuz it wouldn't matter anyway thanks to floating precision)
+// (the difference is taken as unsigned, so one that overflows is also "too far")
+	const auto diff = static_cast<uint64_t>(d_bigger.exponent) - static_cast<uint64_t>(d_smaller.exponent);
+	if (diff >= MAX_SIGNIFICANT_DIGITS) {
+		DECIMAL_COUNT(ADD_EARLY_EXIT);
+		return d_bigger;
+	}
+
+	// ?????????????????????
+	return normalize(DecimalData(
+		std::round(
+			1e14 * d_bigger.mantissa +
+			1e14 * d_smaller.mantissa * pow10(-static_cast<int64_t>(diff))),
+		d_bigger.exponent - 14
+	));
+}
+
+inline auto add_num(const DecimalData &d1, const double d2) -> DecimalData {
+	// it's simply easier to just convert
+	return add(d1, from_float(d2));
+}
+
+inline auto sub(const DecimalData &d1, const DecimalData &d2) -> DecimalData {
+	return add(d1, neg(d2));
+}
+
+inline auto sub_num(const DecimalData &d1, const double d2) -> DecimalData {
+	return sub(d1, from_float(d2));
+}
+
+inline auto mul(const DecimalData &d1, const DecimalData &d2) -> DecimalData {
+	return normalize(DecimalData(
+		d1.mantissa * d2.mantissa,
+		d1.exponent + d2.exponent
+	));
+}
+
+inline auto mul_num(const DecimalData &d1, const double d2) -> DecimalData {
+	return normalize(DecimalData(
+		d1.mantissa * d2,
+		d1.exponent
+	));
+}
+
+inline auto recip(const DecimalData &dec) -> DecimalData {
+	// decimal -> [1, 10)
+	// 1/decimal -> (0.1, 1] = (1, 10] * 1e-1
+	// so we don't really need to normalize.
+	// Just do a check to not hit a mantissa of +10 or -10.
+	if (DECIMAL_LIKELY(dec.mantissa < 1 || dec.mantissa > -1)) {
+		return DecimalData(
+			(1 / dec.mantissa) * 10,
+			-dec.exponent - 1
+		);
+	} else {
+		return DecimalData(
+			(1 / dec.mantissa),
+			-dec.exponent
+		);
+	}
+}
+
+inline auto div(const DecimalData &d1, const DecimalData &d2) -> DecimalData {
+	return mul(d1, recip(d2));
+}
+
+inline auto div_num(const DecimalData &d1, const double d2) -> DecimalData {
+	// TODO: if d2 is below 1.8e-308, this could cause issues
+	return mul_num(d1, 1 / d2);
+}
+
+constexpr auto cmp(const DecimalData &d1, const DecimalData &d2) -> int64_t {
+	const auto s1 = sign(d1);
+	const auto s2 = sign(d2);
+
+	if (DECIMAL_UNLIKELY(s1 * s2 != 1)) {
+		// signs are different or at least one of them zero, so we can just compare them
+		return s1 > s2 ? +1 :
+		       s1 < s2 ? -1 :
+		                  0;
+	}
+
+	// both have the same sign, but exponent comparison will work in reverse on negatives
+	const auto flip = s1;
+
+	return
+		d1.exponent > d2.exponent ? +1 * flip :
+		d1.exponent < d2.exponent ? -1 * flip :
+		d1.mantissa > d2.mantissa ? +1 :
+		d1.mantissa < d2.mantissa ? -1 :
+		                             0;
+}
+
+constexpr auto lt(const DecimalData &d1, const DecimalData &d2) -> bool { return cmp(d1, d2) < 0; }
+constexpr auto le(const DecimalData &d1, const DecimalData &d2) -> bool { return cmp(d1, d2) <= 0; }
+constexpr auto gt(const DecimalData &d1, const DecimalData &d2) -> bool { return cmp(d1, d2) > 0; }
+constexpr auto ge(const DecimalData &d1, const DecimalData &d2) -> bool { return cmp(d1, d2) >= 0; }
+constexpr auto eq(const DecimalData &d1, const DecimalData &d2) -> bool { return cmp(d1, d2) == 0; }
+constexpr auto ne(const DecimalData &d1, const DecimalData &d2) -> bool { return cmp(d1, d2) != 0; }
+
+constexpr auto min(const DecimalData &d1, const DecimalData &d2) -> DecimalData {
+	return lt(d1, d2) ? d1 : d2;
+}
+
+constexpr auto max(const DecimalData &d1, const DecimalData &d2) -> DecimalData {
+	return gt(d1, d2) ? d1 : d2;
+}
+
+inline auto floor(const DecimalData &dec) -> DecimalData {
+	if (is_finite(dec) == false) return dec;
+
+	if (dec.exponent < -1) {
+		return sign(dec) >= 0 ? DECIMAL_ZERO : DECIMAL_ONE_NEG;
+	}
+
+	if (dec.exponent >= MAX_SIGNIFICANT_DIGITS) return dec;
+
+	// into_float cannot fail here
+	return from_float(std::floor(into_float(dec)));
+}
+
+inline auto ceil(const DecimalData &dec) -> DecimalData {
+	if (is_finite(dec) == false) return dec;
+
+	if (dec.exponent < -1) {
+		return sign(dec) >= 0 ? DECIMAL_ONE : DECIMAL_ZERO;
+	}
+
+	if (dec.exponent >= MAX_SIGNIFICANT_DIGITS) return dec;
+
+	return from_float(std::ceil(into_float(dec)));
+}
+
+inline auto trunc(const DecimalData &dec) -> DecimalData {
+	if (is_finite(dec) == false) return dec;
+
+	if (dec.exponent < 0) return DECIMAL_ZERO;
+
+	if (dec.exponent >= MAX_SIGNIFICANT_DIGITS) return dec;
+
+	return from_float(std::trunc(into_float(dec)));
+}
+
+// `lo` is expected to not be greater than `hi`
+constexpr auto clamp(const DecimalData &x, const DecimalData &lo, const DecimalData &hi) -> DecimalData {
+	return min(max(x, lo), hi);
+}
+
+inline auto eq_tolerance_abs(const DecimalData &d1, const DecimalData &d2, const DecimalData &epsilon) -> bool {
+	const auto diff = abs(sub(d1, d2));
+	return le(diff, epsilon);
+}
+
+inline auto eq_tolerance_rel(const DecimalData &d1, const DecimalData &d2, const DecimalData &epsilon) -> bool {
+	// NOTE: if epsilon is 1 or bigger, result will always return true
+	const auto diff = abs(sub(d1, d2));
+	const auto tol = mul(epsilon, max(abs(d1), abs(d2)));
+	return le(diff, tol);
+}
+
+// log10 of a single mantissa. Fast math builds use the tables from
+// decimal_fastmath.hpp for the normalized ones, and libm for anything else.
+inline auto mantissa_log10(const double m) -> double {
+#ifdef DECIMAL_FAST_MATH
+	if (DECIMAL_LIKELY(m >= 1.0 && m < 10.0)) {
+		return decimal_fastmath::log10_mantissa(m);
+	}
+#endif
+	return std::log10(m);
+}
+
+inline auto log10(const DecimalData &dec) -> double {
+	return dec.exponent + mantissa_log10(dec.mantissa);
+}
+
+inline auto abs_log10(const DecimalData &dec) -> double {
+	return dec.exponent + mantissa_log10(std::abs(dec.mantissa));
+}
+
+inline auto log10_prot(const DecimalData &dec) -> double {
+	return dec.mantissa <= 0 ? 0 : log10(dec);
+}
+
+inline auto log2(const DecimalData &dec) -> double {
+	constexpr const double LOG_10_2 = 3.321928094887362;
+
+	return LOG_10_2 * log10(dec);
+}
+
+inline auto log(const DecimalData &dec, const double base) -> double {
+	constexpr const double LN_10 = 2.302585092994046;
+
+	return (LN_10 / std::log(base)) * log10(dec);
+}
+
+inline auto ln(const DecimalData &dec) -> double {
+	constexpr const double LN_10 = 2.302585092994045;
+
+	return LN_10 * log10(dec);
+}
+
+inline auto pow10_num(const double exp) -> DecimalData {
+#ifdef DECIMAL_FAST_MATH
+	// exp - floor(exp) is exact, and lands the mantissa in [1, 10) right away
+	if (DECIMAL_LIKELY(std::isfinite(exp))) {
+		const auto floor = std::floor(exp);
+		const auto m = decimal_fastmath::pow10_frac(exp - floor);
+		const auto e = static_cast<int64_t>(floor);
+		return DECIMAL_LIKELY(m < 10.0) ? DecimalData(m, e) : DecimalData(1.0, e + 1);
+	}
+#endif
+
+	const auto trunc = std::trunc(exp);
+
+	return normalize(DecimalData(
+		std::pow(10, exp - trunc),
+		static_cast<int64_t>(trunc)
+	));
+}
+
+inline auto pow_num(const DecimalData &base, const double exp) -> DecimalData {
+	const auto res = pow10_num(exp * abs_log10(base));
+
+	if (DECIMAL_LIKELY(sign(base) != -1)) return res;
+
+	// handle negative bases
+	const auto parity = std::abs(std::fmod(exp, 2.0));
+	if (parity == 1.0) {
+		return neg(res);
+	} else if (parity == 0.0) {
+		return res;
+	}
+	return DECIMAL_NAN;
+}
+
+// Powers whose exponent of 10 would get past this saturate, to infinity going
+// up and to zero going down. It's a bit under INT64_MAX, so that normalizing
+// the result can't overflow the exponent either.
+constexpr const double POW_EXPONENT_LIMIT = 9.2e18;
+
+// every integer up to 2^53 is an exact double, and every double past it is an
+// even integer
+constexpr const double EXACT_INTEGER_LIMIT = 9007199254740992.0;
+
+// into_float(), but exponents past what a double can hold give infinity or
+// zero instead of NaN
+inline auto into_float_saturated(const DecimalData &dec) -> double {
+	if (dec.exponent > std::numeric_limits<double>::max_exponent10) return dec.mantissa * std::numeric_limits<double>::infinity();
+	if (dec.exponent < -POW10_OFFSET) return dec.mantissa * 0.0;
+	return into_float(dec);
+}
+
+// pow10_num(), but saturating instead of overflowing the exponent
+inline auto pow10_saturated(const double exp) -> DecimalData {
+	if (DECIMAL_UNLIKELY(std::isnan(exp))) return DECIMAL_NAN;
+	if (DECIMAL_UNLIKELY(exp >= POW_EXPONENT_LIMIT)) return DECIMAL_INF;
+	if (DECIMAL_UNLIKELY(exp <= -POW_EXPONENT_LIMIT)) return DECIMAL_ZERO;
+	return pow10_num(exp);
+}
+
+// base^n by squaring. With base = m * 10^e, that's m^n * 10^(e * n): the
+// first part is squared up in doubles that are only ever rescaled by powers of
+// 2 (which is exact), the second part is exact integer math. So small integer
+// powers come out exact, like 2^10 = 1024, instead of going through
+// 10^(n * log10(base)). `base` has to be normalized, finite and nonzero, with
+// |n| < 2^53.
+inline auto pow_int(const DecimalData &base, const int64_t n) -> DecimalData {
+	constexpr const double LOG10_2 = 0.30102999566398120;
+
+	const auto negative = base.mantissa < 0 && (n & 1) != 0;
+
+	// saturate up front, which also keeps the exponents below from overflowing
+	const auto estimate = static_cast<double>(n) * abs_log10(base);
+	if (estimate >= POW_EXPONENT_LIMIT) return negative ? DECIMAL_INF_NEG : DECIMAL_INF;
+	if (estimate <= -POW_EXPONENT_LIMIT) return negative ? DECIMAL_ZERO_NEG : DECIMAL_ZERO;
+
+	// res * 2^res_exp2 and sq * 2^sq_exp2, rescaled into [1, 2) before they can
+	// overflow. Both stay >= 1 that way, so they can't underflow either.
+	constexpr const double RESCALE_ABOVE = 1e150;
+	auto res = 1.0;
+	int64_t res_exp2 = 0;
+	auto sq = std::abs(base.mantissa);
+	int64_t sq_exp2 = 0;
+
+	int exp2;
+	for (auto bits = static_cast<uint64_t>(n < 0 ? -n : n); bits != 0; bits >>= 1) {
+		if (bits & 1) {
+			res *= sq;
+			res_exp2 += sq_exp2;
+			if (DECIMAL_UNLIKELY(res > RESCALE_ABOVE)) {
+				res = std::frexp(res, &exp2) * 2.0;
+				res_exp2 += exp2 - 1;
+			}
+		}
+		if (bits > 1) {
+			sq *= sq;
+			sq_exp2 *= 2;
+			if (DECIMAL_UNLIKELY(sq > RESCALE_ABOVE)) {
+				sq = std::frexp(sq, &exp2) * 2.0;
+				sq_exp2 += exp2 - 1;
+			}
+		}
+	}
+
+	res = std::frexp(res, &exp2);
+	res_exp2 += exp2;
+	if (n < 0) {
+		res = 1.0 / res;
+		res_exp2 = -res_exp2;
+	}
+	if (negative) {
+		res = -res;
+	}
+
+	// back to a power of 10, exactly while it still fits in a double
+	auto dec = std::abs(res_exp2) <= 1000 ?
+		from_float(std::ldexp(res, static_cast<int>(res_exp2))) :
+		mul(from_float(res), pow10_num(static_cast<double>(res_exp2) * LOG10_2));
+	dec.exponent += base.exponent * n;
+	return dec;
+}
+
+// Decimal^Decimal. Integer exponents below 2^53 go through pow_int() (or are
+// exact for powers of 10), others through 10^(exp * log10(base)), with that
+// product done in decimals once the exponent doesn't fit in a double. Negative
+// bases only work with integer exponents, and past 2^53 all of them are even.
+inline auto pow(const DecimalData &base, const DecimalData &exp) -> DecimalData {
+	if (DECIMAL_UNLIKELY(std::isnan(base.mantissa) || std::isnan(exp.mantissa))) return DECIMAL_NAN;
+	if (exp.mantissa == 0 || (base.mantissa == 1.0 && base.exponent == 0)) return DECIMAL_ONE;
+	if (base.mantissa == 0) return sign(exp) > 0 ? DECIMAL_ZERO : DECIMAL_INF;
+
+	// mantissa * 10^exponent can be a couple ulp off for integers like
+	// 1.23456789e12, which still count as integers here
+	auto x = into_float_saturated(exp);
+	const auto rounded = std::round(x);
+	const auto small_integer = std::abs(rounded) < EXACT_INTEGER_LIMIT &&
+		std::abs(x - rounded) <= std::abs(x) * 4.0 * std::numeric_limits<double>::epsilon();
+	if (small_integer) {
+		x = rounded;
+	}
+
+	if (small_integer && is_finite(base)) {
+		const auto b = normalize(base);
+		const auto n = static_cast<int64_t>(x);
+
+		// the saturation checks below would also catch exponents near the
+		// limits that don't change at all
+		if (n == 1) return b;
+
+		if (std::abs(b.mantissa) == 1.0) {
+			if (static_cast<double>(b.exponent) * x >= POW_EXPONENT_LIMIT) return (b.mantissa < 0 && (n & 1)) ? DECIMAL_INF_NEG : DECIMAL_INF;
+			if (static_cast<double>(b.exponent) * x <= -POW_EXPONENT_LIMIT) return (b.mantissa < 0 && (n & 1)) ? DECIMAL_ZERO_NEG : DECIMAL_ZERO;
+			return DecimalData((b.mantissa < 0 && (n & 1)) ? -1.0 : 1.0, b.exponent * n);
+		}
+		return pow_int(b, n);
+	}
+
+	auto negative = false;
+	if (sign(base) < 0) {
+		if (!small_integer && std::abs(x) < EXACT_INTEGER_LIMIT) return DECIMAL_NAN;
+		negative = small_integer && std::fmod(x, 2.0) != 0;
+	}
+
+	const auto log = abs_log10(base);
+	if (log == 0) return negative ? DECIMAL_ONE_NEG : DECIMAL_ONE;
+
+	DecimalData res;
+	if (std::isfinite(x)) {
+		res = pow10_saturated(x * log);
+	} else {
+		const auto y = mul(exp, from_float(log));
+		if (!is_finite(y) || y.exponent >= 19) {
+			res = sign(y) > 0 ? DECIMAL_INF : DECIMAL_ZERO;
+		} else {
+			res = pow10_saturated(into_float_saturated(y));
+		}
+	}
+	return negative ? neg(res) : res;
+}
+
+// e^x, with std::exp's precision while the result still fits in a double
+inline auto exp(const DecimalData &x) -> DecimalData {
+	constexpr const double LOG10_E = 0.4342944819032518;
+
+	const auto f = into_float_saturated(x);
+	if (std::abs(f) < 709.0) return from_float(std::exp(f));
+	return pow10_saturated(f * LOG10_E);
+}
+
+// base^exp for a plain number base, like 2^x or 10^x
+inline auto pow_base(const double base, const DecimalData &exp) -> DecimalData {
+	return pow(from_float(base), exp);
+}
+
+inline auto sqrt(const DecimalData &dec) -> DecimalData {
+	constexpr const double SQRT_10 = 3.1622776601683795;
+
+	if (dec.mantissa < 0) return DECIMAL_NAN;
+
+	if (dec.exponent % 2 != 0) {
+		// sqrt(10) * sqrt(10)
+		// [1, 10) -> [1, 10)
+		return DecimalData(
+			std::sqrt(dec.mantissa) * SQRT_10,
+			(dec.exponent - 1) / 2
+		);
+	}
+
+	// [1, 10) -> [1, ~3.16)
+	return DecimalData(
+		std::sqrt(dec.mantissa),
+		dec.exponent / 2
+	);
+}
+
+inline auto cbrt(const DecimalData &dec) -> DecimalData {
+	constexpr const double CBRT_10 = 2.154434690031884;
+	constexpr const double CBRT_10_SQ = 4.641588833612779;
+
+	switch (dec.exponent % 3) {
+
+		case 1: case -2:
+			// cbrt(10) * cbrt(10)
+			// [1, 10) -> [1, ~4.64)
+			return DecimalData(
+				std::cbrt(dec.mantissa) * CBRT_10,
+				dec.exponent / 3
+			);
+
+		case 2: case -1:
+			// cbrt(10) * cbrt(10)^2
+			// [1, 10) -> [1, 10)
+			return DecimalData(
+				std::cbrt(dec.mantissa) * CBRT_10_SQ,
+				dec.exponent / 3
+			);
+
+		default: // 0
+			// [1, 10) -> [1, ~2.15)
+			return DecimalData(
+				std::cbrt(dec.mantissa),
+				dec.exponent / 3
+			);
+	}
+}
+
+// number of decimal places
+inline auto dp(const DecimalData &dec) -> int64_t {
+	if (is_finite(dec) == false) return -1;
+	if (dec.exponent >= MAX_SIGNIFICANT_DIGITS) return 0;
+
+	int64_t places = -dec.exponent;
+	int64_t e = 1;
+
+	for (;;) {
+		const double rem = std::round(dec.mantissa * e) / e - dec.mantissa;
+		if (std::abs(rem) < ROUND_TOLERANCE) break;
+
+		e *= 10;
+		places++;
+	}
+
+	return places > 0 ? places : 0;
+}
+
+/**
+ * If you're willing to spend 'resourcesAvailable' and want to buy something
+ * with exponentially increasing cost each purchase (start at priceStart,
+ * multiply by priceRatio, already own currentOwned), how much of it can you buy?
+ * Adapted from Trimps source code.
+ */
+inline auto afford_geometric_series(
+	const DecimalData &res_available,
+	const DecimalData &price_start,
+	const DecimalData &price_ratio,
+	const int64_t current_owned
+) -> int64_t {
+
+	const auto relative_start = mul(price_start, pow_num(price_ratio, current_owned));
+
+	const auto a = mul(div(res_available, relative_start), sub_num(price_ratio, 1));
+	const auto b = log10(add_num(a, 1)) / log10(price_ratio);
+	return static_cast<int64_t>(std::floor(b));
+}
+
+/**
+ * How much resource would it cost to buy (numItems) items if you already have currentOwned,
+ * the initial price is priceStart and it multiplies by priceRatio each purchase?
+ */
+inline auto sum_geometric_series(
+	const int64_t num_items,
+	const DecimalData &price_start,
+	const DecimalData &price_ratio,
+	const int64_t current_owned
+) -> DecimalData {
+
+	const auto a = mul(price_start, pow_num(price_ratio, current_owned));
+	const auto b = mul(a, sub(DECIMAL_ONE, pow_num(price_ratio, num_items)));
+	return div(b, sub(DECIMAL_ONE, price_ratio));
+}
+
+/**
+ * If you're willing to spend 'resourcesAvailable' and want to buy something with additively
+ * increasing cost each purchase (start at priceStart, add by priceAdd, already own currentOwned),
+ * how much of it can you buy?
+ */
+inline auto afford_arithmetic_series(
+	const DecimalData &res_available,
+	const DecimalData &price_start,
+	const DecimalData &price_add,
+	const DecimalData &current_owned
+) -> DecimalData {
+
+	const auto relative_start = add(price_start, mul(price_add, current_owned));
+	const auto b = sub(relative_start, div_num(price_add, 2));
+	const auto b2 = pow_num(b, 2);
+
+	const auto a = add(neg(b), sqrt(add(b2, mul_num(mul(price_add, res_available), 2))));
+	return floor(div(a, price_add));
+}
+
+/**
+ * How much resource would it cost to buy (numItems) items if you already have currentOwned,
+ * the initial price is priceStart and it adds priceAdd each purchase?
+ * Adapted from http://www.mathwords.com/a/arithmetic_series.htm
+ */
+inline auto sum_arithmetic_series(
+	const DecimalData &num_items,
+	const DecimalData &price_start,
+	const DecimalData &price_add,
+	const DecimalData &current_owned
+) -> DecimalData {
+
+	const auto relative_start = add(price_start, mul(price_add, current_owned));
+
+	return mul(div_num(num_items, 2), add(mul_num(relative_start, 2), mul(sub_num(num_items, 1), price_add)));
+}
+
+/**
+ * When comparing two purchases that cost (resource) and increase your resource/sec by (deltaRpS),
+ * the lowest efficiency score is the better one to purchase.
+ * From Frozen Cookies:
+ * http://cookieclicker.wikia.com/wiki/Frozen_Cookies_(JavaScript_Add-on)#Efficiency.3F_What.27s_that.3F
+ */
+inline auto efficiency_of_purchase(
+	const DecimalData &cost,
+	const DecimalData &current_rps,
+	const DecimalData &delta_rps
+) -> DecimalData {
+
+	return add(div(cost, current_rps), div(cost, delta_rps));
+}
+
+} // namespace decimal_core
@@ -0,0 +1,86 @@
+#pragma once
+
+// Optional counters for what the math is doing: how often values get
+// normalized, how often add() takes its shortcut, and (from the binding layer)
+// how often each Decimal method is called and how long it takes.
+//
+// Everything here is only compiled in when building with DECIMAL_STATS, so
+// builds without it pay nothing. With it, counting can still be paused at
+// runtime, which leaves a single relaxed load per op. The counters are relaxed
+// atomics: the totals are exact, but there's no ordering between them, so a
+// snapshot taken while other threads are working can be a few ops apart from
+// one counter to the next.
+
+#include <atomic>
+#include <cstdint>
+
+namespace decimal_counters {
+
+enum Counter : int {
+	NORMALIZE,
+	ADD_EARLY_EXIT,
+	NAN_RESULT,
+	INF_RESULT,
+	COUNTER_MAX,
+};
+
+// more than the number of methods Decimal binds
+constexpr const int MAX_METHODS = 128;
+
+struct Method {
+	const char *name = nullptr;
+	std::atomic<uint64_t> calls{ 0 };
+	std::atomic<uint64_t> nanos{ 0 };
+};
+
+inline std::atomic<bool> enabled{ true };
+inline std::atomic<bool> timing{ false };
+
+inline std::atomic<uint64_t> counters[COUNTER_MAX];
+
+// filled in while binding, read-only after that
+inline Method methods[MAX_METHODS];
+inline int method_count = 0;
+
+inline auto is_enabled() -> bool {
+	return enabled.load(std::memory_order_relaxed);
+}
+
+inline auto is_timing() -> bool {
+	return timing.load(std::memory_order_relaxed);
+}
+
+inline auto hit(const Counter counter) -> void {
+	if (is_enabled()) {
+		counters[counter].fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+inline auto get(const Counter counter) -> uint64_t {
+	return counters[counter].load(std::memory_order_relaxed);
+}
+
+// returns the method's slot, or -1 once every slot is taken
+inline auto register_method(const char *name) -> int {
+	if (method_count >= MAX_METHODS) return -1;
+	methods[method_count].name = name;
+	return method_count++;
+}
+
+inline auto reset() -> void {
+	for (auto &c : counters) {
+		c.store(0, std::memory_order_relaxed);
+	}
+	for (int i = 0; i < method_count; i++) {
+		methods[i].calls.store(0, std::memory_order_relaxed);
+		methods[i].nanos.store(0, std::memory_order_relaxed);
+	}
+}
+
+} // namespace decimal_counters
+
+#ifdef DECIMAL_STATS
+	#define DECIMAL_COUNT(counter) decimal_counters::hit(decimal_counters::counter)
+#else
+	#define DECIMAL_COUNT(counter) ((void)0)
+#endif
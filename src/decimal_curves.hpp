@@ -0,0 +1,131 @@
+#pragma once
+
+// Price curves with their per-curve constants worked out once, for answering
+// "how many can I afford" and "how much do the next N cost" for a whole shop
+// at a time.
+//
+// decimal_core's afford_*_series and sum_*_series helpers redo things like
+// log10(price_ratio) and price_ratio - 1 on every call, even though those only
+// depend on the curve. The functions here take them from the Curve instead,
+// but otherwise follow the exact same steps, so results are bit-identical to
+// the decimal_core helpers.
+
+#include "decimal_core.hpp"
+
+#include <cmath>
+#include <cstdint>
+
+namespace decimal_curves {
+
+enum class Kind : uint8_t {
+	GEOMETRIC,   // price_start * price_step^owned
+	ARITHMETIC,  // price_start + price_step * owned
+};
+
+struct Curve {
+	Kind kind = Kind::GEOMETRIC;
+	DecimalData price_start;
+	DecimalData price_step;
+
+	// geometric
+	double log10_ratio = 0.0;       // log10(price_step), as afford_geometric_series divides by it
+	double abs_log10_ratio = 0.0;   // what pow_num(price_step, x) scales x by
+	bool positive_ratio = true;     // pow_num() needs its sign handling otherwise
+	DecimalData ratio_minus_one;
+	DecimalData one_minus_ratio;
+
+	// arithmetic
+	DecimalData half_add;
+	DecimalData recip_add;
+};
+
+inline auto make_geometric(const DecimalData &price_start, const DecimalData &price_ratio) -> Curve {
+	namespace core = decimal_core;
+
+	Curve c;
+	c.kind = Kind::GEOMETRIC;
+	c.price_start = price_start;
+	c.price_step = price_ratio;
+	c.log10_ratio = core::log10(price_ratio);
+	c.abs_log10_ratio = core::abs_log10(price_ratio);
+	c.positive_ratio = core::sign(price_ratio) == 1;
+	c.ratio_minus_one = core::sub_num(price_ratio, 1);
+	c.one_minus_ratio = core::sub(core::DECIMAL_ONE, price_ratio);
+	return c;
+}
+
+inline auto make_arithmetic(const DecimalData &price_start, const DecimalData &price_add) -> Curve {
+	namespace core = decimal_core;
+
+	Curve c;
+	c.kind = Kind::ARITHMETIC;
+	c.price_start = price_start;
+	c.price_step = price_add;
+	c.half_add = core::div_num(price_add, 2);
+	c.recip_add = core::recip(price_add);
+	return c;
+}
+
+// price_step^x, same as core::pow_num(price_step, x)
+inline auto ratio_pow(const Curve &c, const double x) -> DecimalData {
+	if (DECIMAL_LIKELY(c.positive_ratio)) {
+		return decimal_core::pow10_num(x * c.abs_log10_ratio);
+	}
+	return decimal_core::pow_num(c.price_step, x);
+}
+
+// floor() of a count that came out of a double, without the cast overflowing
+inline auto to_count(const double x) -> int64_t {
+	if (DECIMAL_UNLIKELY(std::isnan(x))) return 0;
+	if (DECIMAL_UNLIKELY(x >= 9.2e18)) return INT64_MAX;
+	if (DECIMAL_UNLIKELY(x <= -9.2e18)) return INT64_MIN;
+	return static_cast<int64_t>(std::floor(x));
+}
+
+// core::afford_geometric_series() / core::afford_arithmetic_series()
+inline auto afford(const Curve &c, const DecimalData &res_available, const int64_t owned) -> int64_t {
+	namespace core = decimal_core;
+
+	if (c.kind == Kind::GEOMETRIC) {
+		const auto relative_start = core::mul(c.price_start, ratio_pow(c, static_cast<double>(owned)));
+		const auto a = core::mul(core::div(res_available, relative_start), c.ratio_minus_one);
+		return to_count(core::log10(core::add_num(a, 1)) / c.log10_ratio);
+	}
+
+	const auto relative_start = core::add(c.price_start, core::mul(c.price_step, core::from_float(static_cast<double>(owned))));
+	const auto b = core::sub(relative_start, c.half_add);
+	const auto b2 = core::pow_num(b, 2);
+
+	const auto a = core::add(core::neg(b), core::sqrt(core::add(b2, core::mul_num(core::mul(c.price_step, res_available), 2))));
+	return to_count(core::into_float(core::floor(core::mul(a, c.recip_add))));
+}
+
+// core::sum_geometric_series() / core::sum_arithmetic_series()
+inline auto cost(const Curve &c, const int64_t num_items, const int64_t owned) -> DecimalData {
+	namespace core = decimal_core;
+
+	if (c.kind == Kind::GEOMETRIC) {
+		const auto a = core::mul(c.price_start, ratio_pow(c, static_cast<double>(owned)));
+		const auto b = core::mul(a, core::sub(core::DECIMAL_ONE, ratio_pow(c, static_cast<double>(num_items))));
+		return core::div(b, c.one_minus_ratio);
+	}
+
+	const auto n = core::from_float(static_cast<double>(num_items));
+	const auto relative_start = core::add(c.price_start, core::mul(c.price_step, core::from_float(static_cast<double>(owned))));
+	return core::mul(core::div_num(n, 2), core::add(core::mul_num(relative_start, 2), core::mul(core::sub_num(n, 1), c.price_step)));
+}
+
+// `owned` and `out` have `count` entries, one per curve
+inline auto afford_many(const Curve *curves, const int64_t count, const DecimalData &res_available, const int64_t *owned, int64_t *out) -> void {
+	for (int64_t i = 0; i < count; i++) {
+		out[i] = afford(curves[i], res_available, owned[i]);
+	}
+}
+
+inline auto cost_many(const Curve *curves, const int64_t count, const int64_t *num_items, const int64_t *owned, DecimalData *out) -> void {
+	for (int64_t i = 0; i < count; i++) {
+		out[i] = cost(curves[i], num_items[i], owned[i]);
+	}
+}
+
+} // namespace decimal_curves
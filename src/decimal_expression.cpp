@@ -0,0 +1,120 @@
+#include "decimal_expression.hpp"
+#include "godot_cpp/core/error_macros.hpp"
+#include "godot_cpp/core/object.hpp"
+#include <cstdint>
+#include <godot_cpp/core/class_db.hpp>
+#include <string>
+
+using namespace godot;
+namespace core = decimal_core;
+
+auto DecimalExpression::_bind_methods() -> void {
+	ClassDB::bind_method(D_METHOD("compile", "formula", "variable_names"), &DecimalExpression::compile, DEFVAL(PackedStringArray()));
+	ClassDB::bind_method(D_METHOD("get_error_text"), &DecimalExpression::get_error_text);
+	ClassDB::bind_method(D_METHOD("is_compiled"), &DecimalExpression::is_compiled);
+
+	ClassDB::bind_method(D_METHOD("evaluate", "variables"), &DecimalExpression::evaluate, DEFVAL(Array()));
+	ClassDB::bind_method(D_METHOD("evaluate_batch", "variables", "out"), &DecimalExpression::evaluate_batch);
+}
+
+auto DecimalExpression::compile(const String &formula, const PackedStringArray &variable_names) -> Error {
+	std::vector<std::string> names;
+	names.reserve(variable_names.size());
+	for (int64_t i = 0; i < variable_names.size(); i++) {
+		const auto name = variable_names[i].utf8();
+		names.emplace_back(name.get_data(), name.length());
+	}
+
+	const auto text = formula.utf8();
+	const auto err = decimal_formula::compile(text.get_data(), text.length(), names, program);
+	if (err.message != nullptr) {
+		error_text = String(err.message) + " (at position " + String::num_int64(err.position) + ")";
+		return ERR_PARSE_ERROR;
+	}
+
+	error_text = String();
+	return OK;
+}
+
+auto DecimalExpression::get_error_text() const -> String {
+	return error_text;
+}
+
+auto DecimalExpression::is_compiled() const -> bool {
+	return !program.code.empty();
+}
+
+auto DecimalExpression::evaluate(const Array &variables) -> Vector4i {
+	ERR_FAIL_COND_V_MSG(!is_compiled(), to_vector4i(core::DECIMAL_NAN),
+		"DecimalExpression.evaluate() - no formula has been compiled."
+	);
+	ERR_FAIL_COND_V_MSG(variables.size() != program.variable_count, to_vector4i(core::DECIMAL_NAN),
+		"DecimalExpression.evaluate() - expected " + String::num_int64(program.variable_count) + " variables, got " + String::num_int64(variables.size()) + "."
+	);
+
+	values.resize(program.variable_count);
+	for (int64_t i = 0; i < program.variable_count; i++) {
+		const Variant &v = variables[i];
+		switch (v.get_type()) {
+			case Variant::VECTOR4I:
+				values[i] = to_decimal(v);
+				break;
+			case Variant::INT:
+				values[i] = core::from_float(static_cast<double>(static_cast<int64_t>(v)));
+				break;
+			case Variant::FLOAT:
+				values[i] = core::from_float(v);
+				break;
+			default:
+				ERR_FAIL_V_MSG(to_vector4i(core::DECIMAL_NAN),
+					"DecimalExpression.evaluate() - variable " + String::num_int64(i) + " is not a Vector4i, int or float."
+				);
+		}
+	}
+
+	return to_vector4i(decimal_formula::run_one(program, values.data(), stack));
+}
+
+auto DecimalExpression::evaluate_batch(const Array &variables, const Ref<DecimalArray> &out) -> void {
+	ERR_FAIL_COND_MSG(out.is_null(), "DecimalExpression.evaluate_batch() - `out` cannot be null.");
+	ERR_FAIL_COND_MSG(!is_compiled(), "DecimalExpression.evaluate_batch() - no formula has been compiled.");
+	ERR_FAIL_COND_MSG(variables.size() != program.variable_count,
+		"DecimalExpression.evaluate_batch() - expected " + String::num_int64(program.variable_count) + " variables, got " + String::num_int64(variables.size()) + "."
+	);
+
+	// without variables there's nothing to size the batch by, so `out` keeps its size
+	auto count = out->size();
+	columns.resize(program.variable_count);
+	for (int64_t i = 0; i < program.variable_count; i++) {
+		const Ref<DecimalArray> column = variables[i];
+		ERR_FAIL_COND_MSG(column.is_null(),
+			"DecimalExpression.evaluate_batch() - variable " + String::num_int64(i) + " is not a DecimalArray."
+		);
+		if (i == 0) {
+			count = column->size();
+		}
+		ERR_FAIL_COND_MSG(column->size() != count,
+			"DecimalExpression.evaluate_batch() - variable " + String::num_int64(i) + " has " + String::num_int64(column->size()) + " entries, expected " + String::num_int64(count) + "."
+		);
+	}
+
+	if (out->size() != count) {
+		out->resize(count);
+	}
+
+	// `out` may be one of the columns, so its pointer has to be fetched first
+	// (see prepare_unary() in decimal_array.cpp)
+	auto *dst = out->ptrw();
+	for (int64_t i = 0; i < program.variable_count; i++) {
+		const Ref<DecimalArray> column = variables[i];
+		columns[i] = column->ptr();
+	}
+
+	DecimalArray::for_each_chunk(count, [&](const int64_t begin, const int64_t end) {
+		// each thread gets its own stack, the one in `this` is only for
+		// when everything runs on the calling thread
+		thread_local std::vector<DecimalData> chunk_stack;
+		auto &scratch = begin == 0 && end == count ? stack : chunk_stack;
+		decimal_formula::run(program, columns.data(), begin, end, dst, scratch);
+	});
+}
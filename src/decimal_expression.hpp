@@ -0,0 +1,42 @@
+#pragma once
+
+#include "godot_cpp/classes/global_constants.hpp"
+#include "godot_cpp/classes/ref_counted.hpp"
+#include "godot_cpp/variant/array.hpp"
+#include "godot_cpp/variant/packed_string_array.hpp"
+#include "godot_cpp/variant/string.hpp"
+#include "godot_cpp/variant/vector4i.hpp"
+
+#include "decimal_array.hpp"
+#include "decimal_formula.hpp"
+
+#include <vector>
+
+using namespace godot;
+
+// A formula over decimals, compiled once (see decimal_formula.hpp) and then
+// evaluated without going back through GDScript for every operation.
+class DecimalExpression : public RefCounted {
+
+	GDCLASS(DecimalExpression, RefCounted)
+
+protected:
+	static auto _bind_methods() -> void;
+
+private:
+	decimal_formula::Program program;
+	String error_text;
+
+	// scratch, kept around so evaluating doesn't allocate
+	std::vector<DecimalData> stack;
+	std::vector<DecimalData> values;
+	std::vector<const DecimalData *> columns;
+
+public:
+	auto compile(const String &formula, const PackedStringArray &variable_names = PackedStringArray()) -> Error;
+	auto get_error_text() const -> String;
+	auto is_compiled() const -> bool;
+
+	auto evaluate(const Array &variables = Array()) -> Vector4i;
+	auto evaluate_batch(const Array &variables, const Ref<DecimalArray> &out) -> void;
+};
@@ -0,0 +1,488 @@
+#pragma once
+
+// Table-driven replacements for the libm calls behind Decimal's pow10_num()
+// and log10(), without any Godot dependency. decimal_core.hpp only uses them
+// when built with DECIMAL_FAST_MATH (`scons fast_math=yes`), but they can be
+// called directly either way.
+//
+// - pow10_frac(f) splits f into j / 128 + r, looks 10^(j / 128) up in a table
+//   and multiplies it by a degree 6 polynomial for 10^r, |r| <= 1/256.
+// - log10_mantissa(m) splits m into 2^e * (1 + j / 128) * (1 + r), looks
+//   log10 of the first part up in a table and adds a degree 8 polynomial for
+//   log10(1 + r), 0 <= r < 1/128.
+//
+// The tables hold every value as two doubles (the nearest one, plus the
+// rounding error), and the large terms are added up without rounding, so the
+// only error that matters is the final rounding. Both results are within
+// MAX_ULP_ERROR of the exact value over their whole domain; the test suite
+// checks them against libm. At these table sizes the Taylor coefficients are
+// already far more accurate than a double, so there's no need for a fitted
+// polynomial.
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace decimal_fastmath {
+
+constexpr const double MAX_ULP_ERROR = 1.0;
+
+constexpr const int64_t TABLE_BITS = 7;
+constexpr const double TABLE_SIZE = 1 << TABLE_BITS;
+
+// 10^(j / 128) for j = 0...128, as the nearest double plus what's left over
+inline constexpr const double POW10_FRAC_HI[] = {
+	0x1.0000000000000p+0, 0x1.04a5975b254b9p+0, 0x1.0960c68d98bc3p+0, 0x1.0e31f1ee598ffp+0,
+	0x1.13197fa6aa677p+0, 0x1.1817d7ba87ec7p+0, 0x1.1d2d641146cc9p+0, 0x1.225a907e59beep+0,
+	0x1.279fcaca404e6p+0, 0x1.2cfd82bb9f26cp+0, 0x1.32742a2082a48p+0, 0x1.380434d7cc6cbp+0,
+	0x1.3dae18daccd3ep+0, 0x1.43724e4708e10p+0, 0x1.49514f682db9fp+0, 0x1.4f4b98c2324dfp+0,
+	0x1.5561a91ba8144p+0, 0x1.5b9401883bba3p+0, 0x1.61e32573669e7p+0, 0x1.684f9aab51fdbp+0,
+	0x1.6ed9e96becb66p+0, 0x1.75829c6a348f3p+0, 0x1.7c4a40dfb3efap+0, 0x1.8331669634fe5p+0,
+	0x1.8a389ff3ab1cfp+0, 0x1.9160820653becp+0, 0x1.98a9a4910f9b1p+0, 0x1.a014a217f540bp+0,
+	0x1.a7a217ed1e165p+0, 0x1.af52a63daed5dp+0, 0x1.b726f01f1c989p+0, 0x1.bf1f9b9caf8c5p+0,
+	0x1.c73d51c54470ep+0, 0x1.cf80beb94e016p+0, 0x1.d7ea91b917723p+0, 0x1.e07b7d3349323p+0,
+	0x1.e93436d3b1239p+0, 0x1.f21577924f848p+0, 0x1.fb1ffbc2a9c8cp+0, 0x1.022a4191b2537p+1,
+	0x1.06d9e87713534p+1, 0x1.0b9f55f3e23eep+1, 0x1.107aef385c4c2p+1, 0x1.156d1b4af3904p+1,
+	0x1.1a764310d7fa1p+1, 0x1.1f96d156a7f46p+1, 0x1.24cf32d9496aap+1, 0x1.2a1fd64eebea3p+1,
+	0x1.2f892c7034a03p+1, 0x1.350ba80194f60p+1, 0x1.3aa7bddccc926p+1, 0x1.405de4fa97896p+1,
+	0x1.462e967c89878p+1, 0x1.4c1a4db716ca3p+1, 0x1.5221883bcbb97p+1, 0x1.5844c5e3b3fc0p+1,
+	0x1.5e8488d9f1e22p+1, 0x1.64e155a687085p+1, 0x1.6b5bb3394f161p+1, 0x1.71f42af52d816p+1,
+	0x1.78ab48bb6f451p+1, 0x1.7f819af7617a3p+1, 0x1.8677b2aa1dcadp+1, 0x1.8d8e23768db89p+1,
+	0x1.94c583ada5b53p+1, 0x1.9c1e6c5ad9110p+1, 0x1.a3997950c7c75p+1, 0x1.ab3749362734fp+1,
+	0x1.b2f87d92e6cc1p+1, 0x1.baddbadd91da9p+1, 0x1.c2e7a888ef7fdp+1, 0x1.cb16f111e1f27p+1,
+	0x1.d36c420d863bep+1, 0x1.dbe84c3795966p+1, 0x1.e48bc381099d0p+1, 0x1.ed575f1f04857p+1,
+	0x1.f64bd999fe9ecp+1, 0x1.ff69f0dd3a57cp+1, 0x1.04593323400a0p+2, 0x1.0912ff5b118f2p+2,
+	0x1.0de2c14fa8852p+2, 0x1.12c8df0c5670fp+2, 0x1.17c5c0769bbe2p+2, 0x1.1cd9cf56c3330p+2,
+	0x1.22057760a5640p+2, 0x1.2749263c94e00p+2, 0x1.2ca54b9073d27p+2, 0x1.321a5908f3dd1p+2,
+	0x1.37a8c26300ebcp+2, 0x1.3d50fd7557cbep+2, 0x1.4313823a49515p+2, 0x1.48f0cad9aad8bp+2,
+	0x1.4ee953b2f4f99p+2, 0x1.54fd9b67913f3p+2, 0x1.5b2e22e557c27p+2, 0x1.617b6d713d82dp+2,
+	0x1.67e600b234626p+2, 0x1.6e6e64bc3da97p+2, 0x1.7515241baffecp+2, 0x1.7bdacbe0b1c18p+2,
+	0x1.82bfebaae8b9dp+2, 0x1.89c515b560173p+2, 0x1.90eadee2a5b8dp+2, 0x1.9831dec91fc1bp+2,
+	0x1.9f9aafbf9b7cbp+2, 0x1.a725eeea169c5p+2, 0x1.aed43c46c3e4bp+2, 0x1.b6a63abb4c538p+2,
+	0x1.be9c90224ddfdp+2, 0x1.c6b7e55918ef7p+2, 0x1.cef8e64dada51p+2, 0x1.d760420cfa30dp+2,
+	0x1.dfeeaad15b500p+2, 0x1.e8a4d61160307p+2, 0x1.f1837c8ed2f09p+2, 0x1.fa8b5a6606fa9p+2,
+	0x1.01de978eb73ffp+3, 0x1.068cdedabc2f6p+3, 0x1.0b50e65c5be18p+3, 0x1.102b13262b6c3p+3,
+	0x1.151bcc206af5cp+3, 0x1.1a237a118c2e0p+3, 0x1.1f4287a6e0653p+3, 0x1.2479617d6ef87p+3,
+	0x1.29c8762af4cf5p+3, 0x1.2f3036470da98p+3, 0x1.34b1147487feap+3, 0x1.3a4b856ae435fp+3,
+	0x1.4000000000000p+3,
+};
+inline constexpr const double POW10_FRAC_LO[] = {
+	0x0.0p+0, -0x1.46fe20f42a6eap-54, -0x1.0347f75b98551p-54, 0x1.af3bc3f881e15p-55,
+	0x1.ac9e24f18a452p-54, 0x1.4aa8d3746256ap-54, 0x1.021d824b4be07p-56, -0x1.7e426a887e90dp-56,
+	-0x1.4cd2ad9836925p-54, -0x1.78b1da645deb1p-55, 0x1.40d2ddac25551p-54, -0x1.77b3f0aa2593dp-54,
+	-0x1.78070830e093cp-57, -0x1.245a630bf05aep-59, -0x1.2d34ca671159dp-55, -0x1.b54f907a3eab9p-54,
+	0x1.eee3993e6259ap-55, 0x1.39f400919ffa5p-56, 0x1.344aaf593f22cp-54, 0x1.91ff3b8d8580ap-54,
+	0x1.09a96afc0e6f4p-55, -0x1.3e38455745cb9p-56, 0x1.85aebfd1cc974p-55, 0x1.270b67c8acb76p-56,
+	-0x1.e93a6ca471fa8p-54, -0x1.3f1a02c29ccadp-56, -0x1.3653c2145d0f7p-54, 0x1.1d0f6e82f6a93p-55,
+	-0x1.39842bc7026dcp-54, 0x1.9da61d5fd5005p-54, 0x1.e2a5ef6e97288p-57, -0x1.14a9a1758791cp-55,
+	0x1.87f37c988e80fp-55, 0x1.50b7ca0bfcc0fp-55, -0x1.9340578e3e192p-54, 0x1.5f9609180e333p-56,
+	-0x1.4934faf48b0d6p-54, 0x1.d36563508dd21p-54, -0x1.b992d8a1cb6eep-55, 0x1.8e97d5c905a8cp-55,
+	-0x1.ff58107a035b9p-53, 0x1.d2e893375d007p-53, -0x1.0d703475f148fp-54, -0x1.5c3a92d025c5ep-56,
+	-0x1.ff268bc934c6fp-53, -0x1.ded97476ab779p-54, -0x1.760a73aa8af50p-55, 0x1.188c3f4821460p-54,
+	0x1.cb478c3fae572p-53, 0x1.c292dc0a10874p-54, 0x1.bba4683e15f36p-53, -0x1.5306b07400ba8p-54,
+	-0x1.c74efa8f6b9adp-55, 0x1.1dedd1dd97869p-57, 0x1.3f937134194b1p-53, -0x1.10ac41999ac15p-53,
+	-0x1.1210801b36dc0p-53, 0x1.33c57f35433d1p-53, -0x1.28a56729b3179p-53, -0x1.94b384afc8757p-53,
+	-0x1.0669bc8ee5929p-53, -0x1.c676f0ae311b9p-53, -0x1.edc948fa3ce4dp-54, -0x1.4b7d59c654717p-53,
+	-0x1.b7ed750df3ccap-53, 0x1.20305653787c3p-53, -0x1.7b62326d8807fp-54, 0x1.b2a6d53e2d81ap-54,
+	0x1.21c624e26b1d5p-54, 0x1.2f9a394e8f45ep-54, 0x1.e464f41eb19bap-53, -0x1.edfdae6f10c59p-54,
+	-0x1.a6e769bcf261fp-55, -0x1.2fca078987be9p-53, 0x1.da071dd238c67p-55, 0x1.5a437119385a6p-54,
+	0x1.9a3e5957511ccp-54, -0x1.d35a5f6da3c18p-53, 0x1.df459ef68a872p-53, 0x1.2ad599ecd990ep-53,
+	0x1.0908710ca7fadp-52, 0x1.020d3e41eb35dp-52, -0x1.67ed44cdb0b0ap-53, -0x1.505d341080090p-52,
+	0x1.a407d1b02c23ep-55, -0x1.664b2dea94247p-52, 0x1.cbd1354fbab5ap-52, 0x1.e987250938f0fp-53,
+	0x1.93dd46ad32974p-52, 0x1.eef011268f738p-52, 0x1.32c2e3c2baba8p-52, -0x1.5a738af0e8dfbp-55,
+	-0x1.66d9800fbdabfp-53, 0x1.20f68ac3dc0dcp-52, -0x1.6b58c33c0e6b4p-52, 0x1.ff2996f40dc74p-56,
+	-0x1.a8be911c027e7p-52, 0x1.08ce7e3c4d161p-52, 0x1.4a47edf1dc895p-52, -0x1.306ac89c73361p-58,
+	0x1.f9cbdb0995b71p-61, -0x1.b53914ae47b09p-52, 0x1.99ec8b79508d2p-52, 0x1.2f8e17ec2d357p-52,
+	-0x1.5f3b78424b051p-58, 0x1.c36aab55fd24ap-52, 0x1.3c9bb7a3f2e56p-52, 0x1.c2378571fa9cap-53,
+	0x1.4b11356231dd5p-52, -0x1.c622703ab5be6p-52, -0x1.5fca62e9af209p-59, 0x1.811dbabf31bfap-52,
+	-0x1.f32eae0b4ee61p-56, -0x1.547af6ccebd09p-53, -0x1.5f021eb788cf1p-52, 0x1.d695b1d02671fp-52,
+	0x1.ea8488761c785p-51, 0x1.66bc289bf71eep-51, 0x1.ad9e5cac13d4ap-55, -0x1.2deb465a44aaep-53,
+	-0x1.df5bd7d5e2c21p-51, -0x1.e84d7b6d0ae3dp-51, -0x1.85bdf250439cdp-51, -0x1.e6d1eb9cf170cp-51,
+	-0x1.3f68016747bc1p-52, 0x1.176614764bd25p-51, -0x1.c3c7e4f31b3a6p-52, -0x1.070d0cce39a25p-53,
+	0x0.0p+0,
+};
+
+// log10(c), split the same way, and 1 / c, for c = 2^e * (1 + j / 128) up to 10
+inline constexpr const double LOG10_TABLE_HI[] = {
+	0x0.0p+0, 0x1.bafd47221ed26p-9, 0x1.b9476a4fcd10fp-8, 0x1.49b0851443684p-7,
+	0x1.b5e908eb13790p-7, 0x1.10a83a8446c78p-6, 0x1.45f4f5acb8be0p-6, 0x1.7adc3df3b1ff8p-6,
+	0x1.af5f92b00e610p-6, 0x1.e3806acbd058fp-6, 0x1.0ba01a8170000p-5, 0x1.25502c0fc314cp-5,
+	0x1.3ed1199a5e425p-5, 0x1.58238eeb353dap-5, 0x1.71483427d2a99p-5, 0x1.8a3fadeb847f4p-5,
+	0x1.a30a9d609efeap-5, 0x1.bba9a058dfd84p-5, 0x1.d41d5164facb4p-5, 0x1.ec6647eb58808p-5,
+	0x1.02428c1f08016p-4, 0x1.0e3d29d81165ep-4, 0x1.1a23445501816p-4, 0x1.25f5215eb594ap-4,
+	0x1.31b3055c47118p-4, 0x1.3d5d335c53179p-4, 0x1.48f3ed1df48fbp-4, 0x1.5477731973e85p-4,
+	0x1.5fe80488af4fdp-4, 0x1.6b45df6f3e2c9p-4, 0x1.769140a2526fdp-4, 0x1.81ca63d05a44ap-4,
+	0x1.8cf183886480dp-4, 0x1.9806d9414a209p-4, 0x1.a30a9d609efeap-4, 0x1.adfd07416be07p-4,
+	0x1.b8de4d3ab3d98p-4, 0x1.c3aea4a5c6effp-4, 0x1.ce6e41e463da5p-4, 0x1.d91d5866aa99cp-4,
+	0x1.e3bc1ab0e19fep-4, 0x1.ee4aba610f204p-4, 0x1.f8c9683468191p-4, 0x1.019c2a064b486p-3,
+	0x1.06cbd67a6c3b6p-3, 0x1.0bf3d0937c41cp-3, 0x1.11142f0811357p-3, 0x1.162d082ac9d10p-3,
+	0x1.1b3e71ec94f7bp-3, 0x1.204881dee8777p-3, 0x1.254b4d35e7d3cp-3, 0x1.2a46e8ca7ba2ap-3,
+	0x1.2f3b691c5a001p-3, 0x1.3428e2540096dp-3, 0x1.390f6844a0b83p-3, 0x1.3def0e6dfdf85p-3,
+	0x1.42c7e7fe3fc02p-3, 0x1.479a07d3b6411p-3, 0x1.4c65807e93338p-3, 0x1.512a644296c3dp-3,
+	0x1.55e8c518b10f8p-3, 0x1.5aa0b4b0988fap-3, 0x1.5f52447255c92p-3, 0x1.63fd857fc49bbp-3,
+	0x1.68a288b60b7fcp-3, 0x1.6d415eaf0906bp-3, 0x1.71da17c2b7e80p-3, 0x1.766cc40889e85p-3,
+	0x1.7af97358b9e04p-3, 0x1.7f80354d952a0p-3, 0x1.84011944bcb75p-3, 0x1.887c2e605e119p-3,
+	0x1.8cf183886480dp-3, 0x1.9161276ba2978p-3, 0x1.95cb2880f45bap-3, 0x1.9a2f95085a45cp-3,
+	0x1.9e8e7b0c0d4bep-3, 0x1.a2e7e8618c2d2p-3, 0x1.a73beaaaa22f4p-3, 0x1.ab8a8f56677fcp-3,
+	0x1.afd3e3a23b680p-3, 0x1.b417f49ab8807p-3, 0x1.b856cf1ca3105p-3, 0x1.bc907fd5d1c40p-3,
+	0x1.c0c5134610e26p-3, 0x1.c4f495c0002a2p-3, 0x1.c91f1369eb7cap-3, 0x1.cd44983e9e7bdp-3,
+	0x1.d165300e333f7p-3, 0x1.d580e67edc43dp-3, 0x1.d997c70da9b47p-3, 0x1.dda9dd0f4a329p-3,
+	0x1.e1b733b0c7381p-3, 0x1.e5bfd5f83d342p-3, 0x1.e9c3cec58f807p-3, 0x1.edc328d3184afp-3,
+	0x1.f1bdeeb654901p-3, 0x1.f5b42ae08c407p-3, 0x1.f9a5e79f76ac5p-3, 0x1.fd932f1ddb4d6p-3,
+	0x1.00be05b217844p-2, 0x1.02b0432c96ff0p-2, 0x1.04a054e139004p-2, 0x1.068e3fa282e3dp-2,
+	0x1.087a0832fa7acp-2, 0x1.0a63b3456c819p-2, 0x1.0c4b457d3193dp-2, 0x1.0e30c36e71a7fp-2,
+	0x1.1014319e661bdp-2, 0x1.11f594839a5bdp-2, 0x1.13d4f0862b2e1p-2, 0x1.15b24a0004a92p-2,
+	0x1.178da53d1ee01p-2, 0x1.1967067bb94b8p-2, 0x1.1b3e71ec94f7bp-2, 0x1.1d13ebb32d7f9p-2,
+	0x1.1ee777e5f0dc3p-2, 0x1.20b91a8e76105p-2, 0x1.2288d7a9b2b64p-2, 0x1.2456b3282f786p-2,
+	0x1.2622b0ee3b79dp-2, 0x1.27ecd4d41eb67p-2, 0x1.29b522a64b609p-2, 0x1.2b7b9e258e422p-2,
+	0x1.2d404b073e27ep-2, 0x1.2f032cf56a5bep-2, 0x1.30c4478f0835fp-2, 0x1.32839e681fc62p-2,
+	0x1.34413509f79ffp-2, 0x1.37b72f983bdd9p-2, 0x1.3b2652b336d43p-2, 0x1.3e8eb93299bb3p-2,
+	0x1.41f07d51503bbp-2, 0x1.454bb8b23c0c6p-2, 0x1.48a08464c32bdp-2, 0x1.4beef8e932bfep-2,
+	0x1.4f372e34f8860p-2, 0x1.52793bb6b4a58p-2, 0x1.55b5385a259ffp-2, 0x1.58eb3a8bf0028p-2,
+	0x1.5c1b583d43684p-2, 0x1.5f45a6e75e47ap-2, 0x1.626a3b8ef1f52p-2, 0x1.65892ac7682fdp-2,
+	0x1.68a288b60b7fcp-2, 0x1.6bb66915139afp-2, 0x1.6ec4df3696f95p-2, 0x1.71cdfe0762b00p-2,
+	0x1.74d1d811b9a04p-2, 0x1.77d07f7ffbf97p-2, 0x1.7aca061f38004p-2, 0x1.7dbe7d61a5051p-2,
+	0x1.80adf66109645p-2, 0x1.839881e10c65dp-2, 0x1.867e305174c3ep-2, 0x1.895f11d0549a0p-2,
+	0x1.8c3b362c2373ep-2, 0x1.8f12ace5c72b1p-2, 0x1.91e585328c3bep-2, 0x1.94b3cdfe0e311p-2,
+	0x1.977d95ec10c02p-2, 0x1.9a42eb5a4a281p-2, 0x1.9d03dc621f5f9p-2, 0x1.9fc076da52981p-2,
+	0x1.a278c858a4965p-2, 0x1.a52cde33695bfp-2, 0x1.a7dcc58310968p-2, 0x1.aa888b23a2466p-2,
+	0x1.ad303bb63007fp-2, 0x1.afd3e3a23b680p-2, 0x1.b2738f1711a63p-2, 0x1.b50f4a0d1d442p-2,
+	0x1.b7a720472dbdap-2, 0x1.ba3b1d53b5c0dp-2, 0x1.bccb4c8e003aap-2, 0x1.bf57b91f5c887p-2,
+	0x1.c1e06e00421bcp-2, 0x1.c46575f96bdbbp-2, 0x1.c6e6dba4eb89dp-2, 0x1.c964a96f35714p-2,
+	0x1.cbdee998249ffp-2, 0x1.ce55a633f7eb6p-2, 0x1.d0c8e92c47fc0p-2, 0x1.d338bc40f69c1p-2,
+	0x1.d5a5290917800p-2, 0x1.d80e38f3d2c08p-2, 0x1.da73f5494139bp-2, 0x1.dcd6672b4301dp-2,
+	0x1.df3597965027bp-2, 0x1.e1918f6243e7cp-2, 0x1.e3ea574322848p-2, 0x1.e63ff7c9d9edcp-2,
+	0x1.e8927964fd5fdp-2, 0x1.eae1e4617c234p-2, 0x1.ed2e40eb5393fp-2, 0x1.ef77970e3c941p-2,
+	0x1.f1bdeeb654901p-2, 0x1.f4014fb0c234fp-2, 0x1.f641c1ac55fbap-2, 0x1.f87f4c3a26a8bp-2,
+	0x1.fab9f6ce29e05p-2, 0x1.fcf1c8bfc8ebbp-2, 0x1.ff26c94a71cdcp-2, 0x1.00ac7fc712616p-1,
+	0x1.01c43947ff22fp-1, 0x1.02da949d5edb4p-1, 0x1.03ef952fa45bcp-1, 0x1.05033e5a95affp-1,
+	0x1.0615936d8aa9fp-1, 0x1.072697aba9f01p-1, 0x1.08364e4c24941p-1, 0x1.0944ba7a70410p-1,
+	0x1.0a51df5680089p-1, 0x1.0b5dbff4fbda8p-1, 0x1.0c685f5f76af2p-1, 0x1.0d71c094a36efp-1,
+	0x1.0e79e688889fdp-1, 0x1.0f80d424b2e0fp-1, 0x1.10868c48663d1p-1, 0x1.118b11c8ce5cap-1,
+	0x1.128e67712d9e0p-1, 0x1.139090030b1d0p-1, 0x1.14918e365fb01p-1, 0x1.159164b9c1e2bp-1,
+	0x1.1690163290f40p-1, 0x1.178da53d1ee01p-1, 0x1.188a146cd97b1p-1, 0x1.1985664c72a35p-1,
+	0x1.1a7f9d5e07922p-1, 0x1.1b78bc1b474f8p-1, 0x1.1c70c4f598501p-1, 0x1.1d67ba563d41ep-1,
+	0x1.1e5d9e9e790d6p-1, 0x1.1f527427b210cp-1, 0x1.20463d439499ep-1, 0x1.2138fc3c34a3fp-1,
+	0x1.222ab3542eddep-1, 0x1.231b64c6c8fdep-1, 0x1.240b12c811670p-1, 0x1.24f9bf84fe249p-1,
+	0x1.25e76d238b400p-1, 0x1.26d41dc2d875bp-1, 0x1.27bfd37b464bdp-1, 0x1.28aa905e928fcp-1,
+	0x1.29945677f43e1p-1, 0x1.2a7d27cc36d82p-1, 0x1.2b650659d52b2p-1, 0x1.2c4bf419138c2p-1,
+	0x1.2d31f2fc198cep-1, 0x1.2e1704ef0b2b3p-1, 0x1.2efb2bd821804p-1, 0x1.2fde6997c2f11p-1,
+	0x1.30c0c0089ae3ep-1, 0x1.31a230ffb0fdfp-1, 0x1.3282be4c7feafp-1, 0x1.336269b90bb31p-1,
+	0x1.34413509f79ffp-1, 0x1.35fc325119becp-1, 0x1.37b3c3de973a1p-1, 0x1.3967f71e48ad9p-1,
+	0x1.3b18d92da3eddp-1, 0x1.3cc676de19d63p-1, 0x1.3e70dcb75d65ep-1, 0x1.401816f9952ffp-1,
+	0x1.41bc319f7812fp-1, 0x1.435d38605622bp-1, 0x1.44fb36b20e9ffp-1, 0x1.469637caf3d14p-1,
+	0x1.482e46a39d841p-1, 0x1.49c36df8aaf3dp-1, 0x1.4b55b84c74ca8p-1, 0x1.4ce52fe8afe7ep-1,
+	0x1.4e71dee0018fep-1, 0x1.4ffbcf0f859d7p-1, 0x1.51830a20474cap-1, 0x1.53079988ad27fp-1,
+	0x1.5489868dd8a02p-1, 0x1.5608da44f9ccbp-1, 0x1.57859d9497d02p-1, 0x1.58ffd935ce528p-1,
+	0x1.5a7795b580822p-1, 0x1.5becdb758202ep-1, 0x1.5d5fb2adb631ep-1, 0x1.5ed0236d261d0p-1,
+	0x1.603e359b0d89fp-1, 0x1.61a9f0f7df658p-1, 0x1.63135d1e41edfp-1, 0x1.647a818402e88p-1,
+	0x1.65df657b04301p-1, 0x1.6742103220e40p-1, 0x1.68a288b60b7fcp-1, 0x1.6a00d5f2251c0p-1,
+	0x1.6b5cfeb14e1b2p-1, 0x1.6cb7099eb07dfp-1, 0x1.6e0efd46841b4p-1, 0x1.6f64e016ccf32p-1,
+	0x1.70b8b86013d3fp-1, 0x1.720a8c5619840p-1, 0x1.735a621084a31p-1, 0x1.74a83f8b8a721p-1,
+	0x1.75f42aa892aedp-1, 0x1.773e292ed6b06p-1, 0x1.788640cbfbed5p-1, 0x1.79cc7714aa143p-1,
+	0x1.7b10d1851cddep-1, 0x1.7c535581b1bddp-1, 0x1.7d9408577194ep-1, 0x1.7ed2ef3c96889p-1,
+	0x1.80100f510e1ffp-1, 0x1.814b6d9ef7c5ap-1, 0x1.82850f1b1fce0p-1, 0x1.83bcf8a5771e0p-1,
+	0x1.84f32f09878ffp-1, 0x1.8627b6fee5303p-1, 0x1.875a95299c6cdp-1, 0x1.888bce1a9d50ep-1,
+	0x1.89bb665023e3dp-1, 0x1.8ae962361dc3dp-1, 0x1.8c15c6268d124p-1, 0x1.8d409669e8c6ep-1,
+	0x1.8e69d7377a7fep-1, 0x1.8f918cb5b9e1ap-1, 0x1.90b7bafaa599fp-1, 0x1.91dc660c1a1a0p-1,
+	0x1.92ff91e026180p-1, 0x1.9421425d5cea7p-1, 0x1.95417b5b26cdcp-1, 0x1.966040a20f245p-1,
+	0x1.977d95ec10c02p-1, 0x1.98997ee4e045dp-1, 0x1.99b3ff2a34b6ep-1, 0x1.9acd1a4c0e316p-1,
+	0x1.9be4d3ccfaf2ep-1, 0x1.9cfb2f225aab4p-1, 0x1.9e102fb4a02bcp-1, 0x1.9f23d8df917fep-1,
+	0x1.a0362df28679fp-1, 0x1.a1473230a5c01p-1, 0x1.a256e8d120640p-1, 0x1.a36554ff6c10fp-1,
+	0x1.a47279db7bd89p-1, 0x1.a57e5a79f7aa8p-1, 0x1.a688f9e4727f1p-1, 0x1.a7925b199f3eep-1,
+	0x1.a89a810d846fdp-1, 0x1.a9a16ea9aeb0ep-1, 0x1.aaa726cd620d1p-1, 0x1.ababac4dca2c9p-1,
+	0x1.acaf01f6296dfp-1, 0x1.adb12a8806ecfp-1, 0x1.aeb228bb5b801p-1, 0x1.afb1ff3ebdb2bp-1,
+	0x1.b0b0b0b78cc3fp-1, 0x1.b1ae3fc21ab01p-1, 0x1.b2aaaef1d54b0p-1, 0x1.b3a600d16e734p-1,
+	0x1.b4a037e303621p-1, 0x1.b59956a0431f7p-1, 0x1.b6915f7a94201p-1, 0x1.b78854db3911dp-1,
+	0x1.b87e392374dd5p-1, 0x1.b9730eacade0bp-1, 0x1.ba66d7c89069ep-1, 0x1.bb5996c13073fp-1,
+	0x1.bc4b4dd92aaddp-1, 0x1.bd3bff4bc4cdep-1, 0x1.be2bad4d0d370p-1, 0x1.bf1a5a09f9f48p-1,
+	0x1.c00807a887100p-1, 0x1.c0f4b847d445bp-1, 0x1.c1e06e00421bcp-1, 0x1.c2cb2ae38e5fbp-1,
+	0x1.c3b4f0fcf00e1p-1, 0x1.c49dc25132a81p-1, 0x1.c585a0ded0fb1p-1, 0x1.c66c8e9e0f5c2p-1,
+	0x1.c7528d81155cdp-1, 0x1.c8379f7406fb3p-1, 0x1.c91bc65d1d504p-1, 0x1.c9ff041cbec10p-1,
+	0x1.cae15a8d96b3ep-1, 0x1.cbc2cb84accdep-1, 0x1.cca358d17bbafp-1, 0x1.cd83043e07830p-1,
+	0x1.ce61cf8ef36fep-1, 0x1.d01cccd6158ecp-1, 0x1.d1d45e63930a1p-1, 0x1.d38891a3447d8p-1,
+	0x1.d53973b29fbddp-1, 0x1.d6e7116315a62p-1, 0x1.d891773c5935dp-1, 0x1.da38b17e90ffep-1,
+	0x1.dbdccc2473e2fp-1, 0x1.dd7dd2e551f2bp-1, 0x1.df1bd1370a6fep-1, 0x1.e0b6d24fefa13p-1,
+	0x1.e24ee12899541p-1, 0x1.e3e4087da6c3cp-1, 0x1.e57652d1709a8p-1, 0x1.e705ca6dabb7ep-1,
+	0x1.e8927964fd5fdp-1, 0x1.ea1c6994816d7p-1, 0x1.eba3a4a5431cap-1, 0x1.ed28340da8f7fp-1,
+	0x1.eeaa2112d4701p-1, 0x1.f02974c9f59cap-1, 0x1.f1a6381993a01p-1, 0x1.f32073baca228p-1,
+	0x1.f498303a7c521p-1, 0x1.f60d75fa7dd2ep-1, 0x1.f7804d32b201ep-1, 0x1.f8f0bdf221ecfp-1,
+	0x1.fa5ed0200959ep-1, 0x1.fbca8b7cdb358p-1, 0x1.fd33f7a33dbdep-1, 0x1.fe9b1c08feb88p-1,
+};
+inline constexpr const double LOG10_TABLE_LO[] = {
+	0x0.0p+0, 0x1.9706ea523f0a5p-63, -0x1.3b252df477a75p-63, -0x1.8f207a6d0d0b1p-62,
+	0x1.f2e9fe367a511p-64, -0x1.7b9fd5428084fp-60, 0x1.dda7897a55eb5p-60, 0x1.b980714c596a3p-62,
+	-0x1.6487d64961833p-60, 0x1.af3eb3b443356p-63, 0x1.5f1d45244f437p-60, -0x1.ff894a084ae68p-59,
+	0x1.ba93eba3e387fp-64, 0x1.efd454f7ea69ap-59, -0x1.8f0f77fcff1d9p-60, -0x1.b144b06126f68p-59,
+	-0x1.ebf33e9410429p-60, 0x1.a9796c3448989p-61, -0x1.7f9dc537bfbfbp-59, 0x1.1f406230b3528p-59,
+	-0x1.5943d4373d44ap-60, 0x1.89565863c8cf4p-58, -0x1.f990c2c07d3b5p-59, -0x1.06ad025ca3a44p-59,
+	0x1.b420b9b202eddp-64, -0x1.a83d8a6eb8e2ep-59, 0x1.782120ed9fd02p-58, -0x1.e1bcfb0476f5dp-58,
+	-0x1.5b6acfce71752p-58, 0x1.643835531d8eep-58, -0x1.ac4c370ae3c1dp-58, -0x1.f639ecb00a83ap-58,
+	-0x1.935d381a0844fp-58, 0x1.c81cca3dd9b7bp-58, -0x1.ebf33e9410429p-59, -0x1.448acb08c4bcap-63,
+	-0x1.446d00b829ad4p-61, -0x1.8b9190212e5bap-58, -0x1.6f0603909a181p-61, -0x1.ce84c9eaee37ap-58,
+	0x1.eab1529f83ac7p-59, 0x1.c427300821266p-58, -0x1.ec7f2dac60a5cp-58, 0x1.c5e9d9a0e1fd9p-57,
+	0x1.5163143f60061p-57, 0x1.e17a06836db63p-58, -0x1.b8c4f1b08949bp-59, -0x1.c6397435bc5b6p-57,
+	-0x1.1113336d7c017p-57, 0x1.54b04da9d7f6dp-57, 0x1.d7958ffee72acp-59, -0x1.aa8c8a1f1c5fbp-57,
+	-0x1.072d03df862acp-57, 0x1.db19f0230af8bp-58, 0x1.4eaa9265471b5p-62, -0x1.5eff6a51557dep-59,
+	-0x1.d22abd8abe1b5p-58, 0x1.0b28e96c1434fp-57, 0x1.0cb15e9cbb524p-58, -0x1.3da42e36a831ep-57,
+	0x1.66fc0dd411a45p-57, -0x1.c2d2132aa11d3p-57, 0x1.39b9a5665fe36p-57, -0x1.60fccbbe64ad0p-57,
+	0x1.5b1121872a033p-58, -0x1.8558bb3439c70p-57, -0x1.5b1f860180520p-59, -0x1.776403f43cdd0p-57,
+	-0x1.9a51ddbb7842fp-58, -0x1.b4327a5a208e3p-57, 0x1.62dcc98003ec7p-58, -0x1.8e7f03689c4e9p-57,
+	-0x1.935d381a0844fp-57, 0x1.d27b03e5bf7e0p-58, 0x1.bab6cd52140e7p-57, -0x1.b6067ff1bf5f0p-57,
+	0x1.01ef2bf4d1a26p-58, 0x1.220a93e77942bp-57, -0x1.c7ed721778d20p-57, 0x1.b2d872d03dd40p-58,
+	0x1.ea8c8576f27aap-60, -0x1.0daaf1fa17fbap-57, 0x1.b0fdb89adcc8ap-57, 0x1.a4ce7fc8b8557p-57,
+	0x1.efea023e11c82p-57, 0x1.7ba6a1c3f51dep-57, -0x1.49d4209317175p-57, -0x1.784b87cda41c6p-57,
+	-0x1.8ff5d70eed06cp-57, -0x1.82f9286e7ec6ep-58, -0x1.ea0e7cbdc7028p-57, 0x1.36847dd69446ap-59,
+	0x1.29f1842bfee0ap-60, 0x1.0c095e5b21eeep-61, 0x1.04c02c795ab20p-58, 0x1.cba1b7464daefp-59,
+	-0x1.3499658410160p-58, 0x1.7923009bad962p-60, -0x1.ba2dd126ffae4p-57, -0x1.a3b0e99a71f80p-60,
+	0x1.61e1a46df20eep-58, 0x1.a530723441f6dp-56, 0x1.34f014b6733f8p-59, -0x1.2ccdbd8b362cbp-58,
+	0x1.3e6ade14fa5bcp-56, -0x1.844915066910dp-59, 0x1.ffd328dc5c470p-57, 0x1.4ea6b8e386c0fp-56,
+	-0x1.e0245ce0087fap-56, 0x1.d762753e2320bp-57, 0x1.9c91293a65e25p-56, 0x1.2556b3b4e8d9bp-56,
+	0x1.e3d9f4b690df2p-57, -0x1.55aa70d0e40f9p-62, -0x1.1113336d7c017p-56, -0x1.e6ba1f70b7878p-56,
+	0x1.49a38f00e0d54p-56, 0x1.a4a1d454fef04p-59, 0x1.3283817024cd8p-58, 0x1.02e748890954cp-59,
+	-0x1.1d40b0371699fp-58, 0x1.4b4c184545b01p-56, 0x1.d17a15ec79cc5p-56, 0x1.afc1217eabe9ep-56,
+	-0x1.6be58d4a4509ap-56, 0x1.02ebb6e692787p-56, 0x1.b3dc5efd9cb5ep-56, 0x1.b748f9ed64aecp-57,
+	-0x1.9dc1da994fd21p-59, 0x1.feeba502f507ap-57, 0x1.73a2f4a1da2cep-57, 0x1.182d0b0c87465p-58,
+	0x1.ce3aaeab0c801p-56, 0x1.b48dc758adfd7p-56, -0x1.5ddc2bb849b8dp-60, 0x1.d32dc672076b6p-56,
+	-0x1.2802e2df0049dp-58, -0x1.c166f7af05cf6p-58, -0x1.dc66700e5060bp-60, 0x1.8c569b6bcca8fp-56,
+	-0x1.b1fda7678616cp-56, 0x1.0a424f4bd352fp-56, 0x1.9ab66968309f3p-59, 0x1.961f2ea0b126fp-56,
+	0x1.5b1121872a033p-57, 0x1.d993900e784a8p-56, 0x1.9c540c05de0dcp-56, -0x1.fa05e1a271fe3p-61,
+	0x1.b6b3876962317p-56, -0x1.d162a53a37c67p-56, 0x1.8d15ac54c65e5p-56, 0x1.ab72246141913p-56,
+	-0x1.9020d4cbbfbaap-59, 0x1.2e8026bdfdd2cp-57, -0x1.ab5fe62f840c7p-57, 0x1.4f6217aee1212p-58,
+	0x1.d5b442e4e6a1dp-58, 0x1.2555d2019d697p-56, 0x1.84d2dba874553p-58, 0x1.4eb94980d364dp-56,
+	0x1.9dc1da994fd21p-58, 0x1.3e4ef73c4c73bp-56, 0x1.8ec95cda53fd7p-56, -0x1.364150e93b83cp-56,
+	-0x1.eedd1ac75a3d6p-59, -0x1.969c9f5b75913p-56, 0x1.819f2920a26a0p-57, -0x1.4eb2db9bcb105p-57,
+	-0x1.f66210ff3984bp-56, 0x1.ea8c8576f27aap-59, 0x1.449fe506f7714p-58, 0x1.5e7962fa8e090p-57,
+	0x1.d3e53b3218232p-58, 0x1.12991936c5cd3p-58, 0x1.952f2676c4dc9p-56, -0x1.16d4f56e0827fp-56,
+	0x1.43be2af618050p-56, -0x1.8960147e3dfeep-56, 0x1.ce9dab2cbac59p-62, -0x1.08fe8062b82a2p-56,
+	0x1.48b142bd12f06p-56, -0x1.bcf1bf4a673c1p-56, 0x1.d1826ef66b223p-56, 0x1.a067d762ab560p-56,
+	-0x1.5085d56bb3023p-57, -0x1.ae23c69d1fdfcp-56, 0x1.ee838a809b49dp-61, 0x1.2d75ad9181ecdp-56,
+	0x1.ff172e5b7b5f9p-58, -0x1.152144e87a88ep-56, 0x1.a4925d8017ddcp-58, 0x1.1bc95ecda3af4p-56,
+	0x1.1860687504345p-59, 0x1.099b6712b9224p-56, -0x1.7c70b04d68120p-58, 0x1.1095c2b2b7974p-56,
+	-0x1.3499658410160p-57, -0x1.0dd178803a416p-56, -0x1.db0108f328ff2p-56, 0x1.050842f887de8p-56,
+	0x1.0299289fd1e35p-56, 0x1.039a16991794fp-58, 0x1.534656abc019fp-57, 0x1.78a24259fb2b2p-55,
+	0x1.9871f5414dcabp-61, 0x1.75343a824a9c6p-58, 0x1.742885d08cce6p-55, -0x1.e3810f4f8d42ap-55,
+	0x1.f57846822296bp-55, 0x1.45724bafca07fp-56, -0x1.5b395f05bb95fp-56, -0x1.b0a87db766e7cp-55,
+	0x1.88798b97bdd39p-57, 0x1.14362b1da1296p-57, -0x1.b14497396b0bep-57, -0x1.77eeff9cfe044p-55,
+	0x1.044cd9255f826p-56, -0x1.4a3b42b764d60p-55, 0x1.ae810c9be5090p-57, -0x1.0673d5cc2bb8bp-55,
+	-0x1.108c918835062p-55, -0x1.5abf830287565p-59, 0x1.06bbe7e596592p-55, 0x1.02ddfdcacfdddp-55,
+	-0x1.406f4a5a16ffep-55, 0x1.e3d9f4b690df2p-56, -0x1.886791f354e8bp-55, -0x1.37cd27b344670p-58,
+	-0x1.ed9fe91bd6bb4p-55, -0x1.4743e48f7401cp-55, 0x1.f972e3a1d236dp-55, -0x1.fbaeaad7de15cp-58,
+	-0x1.7aa6ae9f17cf4p-55, -0x1.910577cfdc717p-58, 0x1.9862b23608528p-57, 0x1.1aee7d905cc6bp-56,
+	-0x1.09ee4c19993cfp-55, 0x1.6ff1fe97cf2c3p-57, 0x1.68d8ede73be81p-56, -0x1.8730c3cf20905p-55,
+	0x1.7c697e103ceaap-57, 0x1.e3788d74c93acp-55, -0x1.44cb6ec0a5fbcp-56, -0x1.0d392d61f0c0ep-55,
+	0x1.15eb53adb6dafp-56, 0x1.b7fe6eebc78e9p-65, -0x1.f38bad7b90637p-55, 0x1.f65256defb983p-55,
+	-0x1.ec219d83be82fp-58, 0x1.1793dcf21bb5dp-56, 0x1.9dc1da994fd21p-56, -0x1.41fb8cea3f083p-55,
+	0x1.30311bb1487e1p-55, -0x1.986642364bc0fp-55, 0x1.802423aa72bbap-56, -0x1.ac09df2e3bd17p-55,
+	-0x1.9dc1da994fd21p-58, 0x1.977b2e5ca1132p-57, 0x1.0c327dfb86386p-57, 0x1.253076ff7d750p-60,
+	0x1.9a827357e285dp-56, -0x1.3f9539fd3dfe7p-55, -0x1.2657f83aba574p-58, -0x1.30453a7091477p-55,
+	0x1.c12385fa8af9ap-55, 0x1.adf703608a48fp-55, -0x1.45fa89503c013p-58, -0x1.53b0cff3aea8bp-55,
+	0x1.0d250ea2a7f78p-55, -0x1.94baf603ab53ap-55, 0x1.ffcf48ecee0cdp-55, 0x1.6266f34d872cbp-56,
+	-0x1.c317d547ca7c5p-55, 0x1.a5db54bb4e504p-56, 0x1.689bd0b2b4138p-56, 0x1.de3bcacfe13aep-55,
+	-0x1.3e8259f4e3e46p-55, -0x1.028d7046b0e06p-55, -0x1.5351477f31cdfp-55, 0x1.77b9e90e1796fp-56,
+	-0x1.96f157b287c65p-58, 0x1.8e1f602f53bc8p-58, 0x1.7b4be8ca89ffcp-55, -0x1.efefdab3b8d90p-55,
+	-0x1.df25954cf828ep-55, 0x1.e33b2d5ce6de6p-57, -0x1.e941c23486728p-55, 0x1.1b010e2da96a9p-56,
+	-0x1.e623e2566b02ep-55, 0x1.0a96bbe922797p-56, 0x1.5b1121872a033p-56, -0x1.69f98c3c657e0p-56,
+	-0x1.c64f7ab05507bp-58, -0x1.ca54daae9f8b7p-56, -0x1.b97453616c62ap-55, 0x1.92772b6f783edp-55,
+	-0x1.150d262931bf8p-55, -0x1.fb33555225d57p-55, 0x1.d6fbdee93e20ep-60, -0x1.c23dc4eaf17aep-55,
+	-0x1.df5f764351f8cp-55, 0x1.0ee0afa877909p-60, -0x1.4f448a6e328eep-55, -0x1.4a8d30c132223p-56,
+	-0x1.77fd082e88faap-55, -0x1.bd184fd167f92p-56, -0x1.63ee2533b8796p-59, 0x1.61a4a2250eeddp-55,
+	0x1.14f90769e8f62p-56, 0x1.07ab02b13764dp-55, -0x1.311ae62e5f6c1p-55, 0x1.6caf9c0f815bcp-56,
+	0x1.92026cfb7e425p-55, 0x1.0f11ff07db130p-55, -0x1.2220f7f928ffap-59, 0x1.f37ae47cafe52p-57,
+	0x1.3036410ed3769p-58, 0x1.5b933fe22dbe7p-55, -0x1.e549d1f992017p-55, -0x1.8bf76e42c3258p-55,
+	-0x1.0ac2e448973b9p-60, -0x1.950e6a20386c0p-55, -0x1.25a8cecd07fd8p-57, 0x1.b9bb0ebf1b39fp-57,
+	-0x1.9c09dc2a640a8p-57, -0x1.4189b3d3643bap-56, 0x1.f146bbb9ad06ap-56, 0x1.a2a00f4abbc87p-57,
+	0x1.9dc1da994fd21p-57, 0x1.a5c94a637d5f8p-61, -0x1.c50a87fea4f6ap-55, -0x1.4273b69f33a40p-56,
+	0x1.ec85aa2b703a1p-55, -0x1.eb3596594ba99p-55, -0x1.4b672fb2105d8p-56, 0x1.5169836ee01f7p-62,
+	-0x1.231eb93b93336p-58, -0x1.7722f7d1aff93p-55, 0x1.388732d38d37ep-55, 0x1.abdb24f820d8ep-58,
+	-0x1.b7bdbac3a5884p-55, -0x1.d4ce92e22cb2dp-55, 0x1.79d2bc88103ffp-55, 0x1.b8d38ae5b3fa9p-57,
+	-0x1.97b5b116e53bfp-55, 0x1.37d13f3e0c59cp-56, -0x1.ae3bda829bbaep-55, 0x1.bf6019147e945p-56,
+	0x1.ab2ea19c6bf98p-56, 0x1.d077ea26428d8p-55, -0x1.132035c3fea40p-55, -0x1.16fe1fdec51f5p-55,
+	0x1.4b692ff8a8060p-56, -0x1.27ef234e4c8d9p-55, 0x1.76f1418c5868cp-57, 0x1.bf2a3d6002760p-55,
+	-0x1.df01b15aee196p-61, 0x1.3dbffb8dee025p-56, -0x1.0349d03e16325p-58, 0x1.a6ae0cfb6f402p-55,
+	0x1.adf4cedd4cce7p-57, 0x1.b403335c6f74bp-55, -0x1.b3c3711c12e88p-55, -0x1.8c64dee16699dp-55,
+	0x1.b86b2c79a38bdp-56, -0x1.bddf9e03a1321p-55, -0x1.656fa6b5f7092p-55, 0x1.7bcc7a1d29ca5p-57,
+	-0x1.bac1be2585c28p-55, -0x1.b31c81a65e130p-58, 0x1.43be2af618050p-55, 0x1.b1d569e8f483fp-56,
+	-0x1.8ee673d2b98fap-55, 0x1.e691e1f225f4cp-55, -0x1.acf964a4ac123p-60, -0x1.1c4e3654cb27bp-58,
+	0x1.a89faea5f3328p-55, -0x1.8e122f3087224p-55, -0x1.4afb305ced142p-55, 0x1.4850aad857f56p-56,
+	-0x1.d35603f098fe3p-56, 0x1.36f680807d07dp-57, -0x1.59ca0bd45b9f5p-55, 0x1.d0d01941798b6p-58,
+	0x1.b26ba7034108ap-55, -0x1.b3fd52126cb86p-55, -0x1.d6cf7e2ab36f1p-55, 0x1.ef4d660e66ee8p-55,
+	-0x1.4c9ae3fda3ba4p-55, 0x1.4d1d50b25a08fp-56, 0x1.c158e34f13b7fp-55, 0x1.6bbd4fcbb376ep-56,
+	-0x1.62e25ebc280dfp-57, -0x1.af9469242ad0bp-57, 0x1.bd64912c6382cp-55, 0x1.24e624c578b47p-56,
+	-0x1.0cb70f06ed05ap-55, 0x1.45a3b14afebcep-57, -0x1.a0cd4bca6f04fp-59, -0x1.68a8a402d166dp-55,
+	0x1.1860687504345p-58, -0x1.46ee734bedd50p-55, -0x1.658e35503af36p-55, -0x1.dd0296cd9e11dp-58,
+	0x1.4f4310c30e3cfp-56, 0x1.c72ce41f74451p-56, 0x1.25a535ae7269dp-56, -0x1.5dff29228931ap-55,
+	0x1.b345b7601a0a1p-55, -0x1.e81831a3aa859p-55, -0x1.3d2069be15facp-56, -0x1.397f0ba9bac3bp-60,
+	0x1.bf93425cb67e4p-61, -0x1.a10d52525b458p-55, -0x1.8eefef0db7ce4p-62, -0x1.8c5b9692c047dp-55,
+};
+inline constexpr const double LOG10_TABLE_INV[] = {
+	0x1.0000000000000p+0, 0x1.fc07f01fc07f0p-1, 0x1.f81f81f81f820p-1, 0x1.f44659e4a4271p-1,
+	0x1.f07c1f07c1f08p-1, 0x1.ecc07b301ecc0p-1, 0x1.e9131abf0b767p-1, 0x1.e573ac901e574p-1,
+	0x1.e1e1e1e1e1e1ep-1, 0x1.de5d6e3f8868ap-1, 0x1.dae6076b981dbp-1, 0x1.d77b654b82c34p-1,
+	0x1.d41d41d41d41dp-1, 0x1.d0cb58f6ec074p-1, 0x1.cd85689039b0bp-1, 0x1.ca4b3055ee191p-1,
+	0x1.c71c71c71c71cp-1, 0x1.c3f8f01c3f8f0p-1, 0x1.c0e070381c0e0p-1, 0x1.bdd2b899406f7p-1,
+	0x1.bacf914c1bad0p-1, 0x1.b7d6c3dda338bp-1, 0x1.b4e81b4e81b4fp-1, 0x1.b2036406c80d9p-1,
+	0x1.af286bca1af28p-1, 0x1.ac5701ac5701bp-1, 0x1.a98ef606a63bep-1, 0x1.a6d01a6d01a6dp-1,
+	0x1.a41a41a41a41ap-1, 0x1.a16d3f97a4b02p-1, 0x1.9ec8e951033d9p-1, 0x1.9c2d14ee4a102p-1,
+	0x1.999999999999ap-1, 0x1.970e4f80cb872p-1, 0x1.948b0fcd6e9e0p-1, 0x1.920fb49d0e229p-1,
+	0x1.8f9c18f9c18fap-1, 0x1.8d3018d3018d3p-1, 0x1.8acb90f6bf3aap-1, 0x1.886e5f0abb04ap-1,
+	0x1.8618618618618p-1, 0x1.83c977ab2beddp-1, 0x1.8181818181818p-1, 0x1.7f405fd017f40p-1,
+	0x1.7d05f417d05f4p-1, 0x1.7ad2208e0ecc3p-1, 0x1.78a4c8178a4c8p-1, 0x1.767dce434a9b1p-1,
+	0x1.745d1745d1746p-1, 0x1.724287f46debcp-1, 0x1.702e05c0b8170p-1, 0x1.6e1f76b4337c7p-1,
+	0x1.6c16c16c16c17p-1, 0x1.6a13cd1537290p-1, 0x1.6816816816817p-1, 0x1.661ec6a5122f9p-1,
+	0x1.642c8590b2164p-1, 0x1.623fa77016240p-1, 0x1.6058160581606p-1, 0x1.5e75bb8d015e7p-1,
+	0x1.5c9882b931057p-1, 0x1.5ac056b015ac0p-1, 0x1.58ed2308158edp-1, 0x1.571ed3c506b3ap-1,
+	0x1.5555555555555p-1, 0x1.5390948f40febp-1, 0x1.51d07eae2f815p-1, 0x1.5015015015015p-1,
+	0x1.4e5e0a72f0539p-1, 0x1.4cab88725af6ep-1, 0x1.4afd6a052bf5bp-1, 0x1.49539e3b2d067p-1,
+	0x1.47ae147ae147bp-1, 0x1.460cbc7f5cf9ap-1, 0x1.446f86562d9fbp-1, 0x1.42d6625d51f87p-1,
+	0x1.4141414141414p-1, 0x1.3fb013fb013fbp-1, 0x1.3e22cbce4a902p-1, 0x1.3c995a47babe7p-1,
+	0x1.3b13b13b13b14p-1, 0x1.3991c2c187f63p-1, 0x1.3813813813814p-1, 0x1.3698df3de0748p-1,
+	0x1.3521cfb2b78c1p-1, 0x1.33ae45b57bcb2p-1, 0x1.323e34a2b10bfp-1, 0x1.30d190130d190p-1,
+	0x1.2f684bda12f68p-1, 0x1.2e025c04b8097p-1, 0x1.2c9fb4d812ca0p-1, 0x1.2b404ad012b40p-1,
+	0x1.29e4129e4129ep-1, 0x1.288b01288b013p-1, 0x1.27350b8812735p-1, 0x1.25e22708092f1p-1,
+	0x1.2492492492492p-1, 0x1.23456789abcdfp-1, 0x1.21fb78121fb78p-1, 0x1.20b470c67c0d9p-1,
+	0x1.1f7047dc11f70p-1, 0x1.1e2ef3b3fb874p-1, 0x1.1cf06ada2811dp-1, 0x1.1bb4a4046ed29p-1,
+	0x1.1a7b9611a7b96p-1, 0x1.19453808ca29cp-1, 0x1.1811811811812p-1, 0x1.16e0689427379p-1,
+	0x1.15b1e5f75270dp-1, 0x1.1485f0e0acd3bp-1, 0x1.135c81135c811p-1, 0x1.12358e75d3033p-1,
+	0x1.1111111111111p-1, 0x1.0fef010fef011p-1, 0x1.0ecf56be69c90p-1, 0x1.0db20a88f4696p-1,
+	0x1.0c9714fbcda3bp-1, 0x1.0b7e6ec259dc8p-1, 0x1.0a6810a6810a7p-1, 0x1.0953f39010954p-1,
+	0x1.0842108421084p-1, 0x1.073260a47f7c6p-1, 0x1.0624dd2f1a9fcp-1, 0x1.05197f7d73404p-1,
+	0x1.0410410410410p-1, 0x1.03091b51f5e1ap-1, 0x1.0204081020408p-1, 0x1.0101010101010p-1,
+	0x1.0000000000000p-1, 0x1.fc07f01fc07f0p-2, 0x1.f81f81f81f820p-2, 0x1.f44659e4a4271p-2,
+	0x1.f07c1f07c1f08p-2, 0x1.ecc07b301ecc0p-2, 0x1.e9131abf0b767p-2, 0x1.e573ac901e574p-2,
+	0x1.e1e1e1e1e1e1ep-2, 0x1.de5d6e3f8868ap-2, 0x1.dae6076b981dbp-2, 0x1.d77b654b82c34p-2,
+	0x1.d41d41d41d41dp-2, 0x1.d0cb58f6ec074p-2, 0x1.cd85689039b0bp-2, 0x1.ca4b3055ee191p-2,
+	0x1.c71c71c71c71cp-2, 0x1.c3f8f01c3f8f0p-2, 0x1.c0e070381c0e0p-2, 0x1.bdd2b899406f7p-2,
+	0x1.bacf914c1bad0p-2, 0x1.b7d6c3dda338bp-2, 0x1.b4e81b4e81b4fp-2, 0x1.b2036406c80d9p-2,
+	0x1.af286bca1af28p-2, 0x1.ac5701ac5701bp-2, 0x1.a98ef606a63bep-2, 0x1.a6d01a6d01a6dp-2,
+	0x1.a41a41a41a41ap-2, 0x1.a16d3f97a4b02p-2, 0x1.9ec8e951033d9p-2, 0x1.9c2d14ee4a102p-2,
+	0x1.999999999999ap-2, 0x1.970e4f80cb872p-2, 0x1.948b0fcd6e9e0p-2, 0x1.920fb49d0e229p-2,
+	0x1.8f9c18f9c18fap-2, 0x1.8d3018d3018d3p-2, 0x1.8acb90f6bf3aap-2, 0x1.886e5f0abb04ap-2,
+	0x1.8618618618618p-2, 0x1.83c977ab2beddp-2, 0x1.8181818181818p-2, 0x1.7f405fd017f40p-2,
+	0x1.7d05f417d05f4p-2, 0x1.7ad2208e0ecc3p-2, 0x1.78a4c8178a4c8p-2, 0x1.767dce434a9b1p-2,
+	0x1.745d1745d1746p-2, 0x1.724287f46debcp-2, 0x1.702e05c0b8170p-2, 0x1.6e1f76b4337c7p-2,
+	0x1.6c16c16c16c17p-2, 0x1.6a13cd1537290p-2, 0x1.6816816816817p-2, 0x1.661ec6a5122f9p-2,
+	0x1.642c8590b2164p-2, 0x1.623fa77016240p-2, 0x1.6058160581606p-2, 0x1.5e75bb8d015e7p-2,
+	0x1.5c9882b931057p-2, 0x1.5ac056b015ac0p-2, 0x1.58ed2308158edp-2, 0x1.571ed3c506b3ap-2,
+	0x1.5555555555555p-2, 0x1.5390948f40febp-2, 0x1.51d07eae2f815p-2, 0x1.5015015015015p-2,
+	0x1.4e5e0a72f0539p-2, 0x1.4cab88725af6ep-2, 0x1.4afd6a052bf5bp-2, 0x1.49539e3b2d067p-2,
+	0x1.47ae147ae147bp-2, 0x1.460cbc7f5cf9ap-2, 0x1.446f86562d9fbp-2, 0x1.42d6625d51f87p-2,
+	0x1.4141414141414p-2, 0x1.3fb013fb013fbp-2, 0x1.3e22cbce4a902p-2, 0x1.3c995a47babe7p-2,
+	0x1.3b13b13b13b14p-2, 0x1.3991c2c187f63p-2, 0x1.3813813813814p-2, 0x1.3698df3de0748p-2,
+	0x1.3521cfb2b78c1p-2, 0x1.33ae45b57bcb2p-2, 0x1.323e34a2b10bfp-2, 0x1.30d190130d190p-2,
+	0x1.2f684bda12f68p-2, 0x1.2e025c04b8097p-2, 0x1.2c9fb4d812ca0p-2, 0x1.2b404ad012b40p-2,
+	0x1.29e4129e4129ep-2, 0x1.288b01288b013p-2, 0x1.27350b8812735p-2, 0x1.25e22708092f1p-2,
+	0x1.2492492492492p-2, 0x1.23456789abcdfp-2, 0x1.21fb78121fb78p-2, 0x1.20b470c67c0d9p-2,
+	0x1.1f7047dc11f70p-2, 0x1.1e2ef3b3fb874p-2, 0x1.1cf06ada2811dp-2, 0x1.1bb4a4046ed29p-2,
+	0x1.1a7b9611a7b96p-2, 0x1.19453808ca29cp-2, 0x1.1811811811812p-2, 0x1.16e0689427379p-2,
+	0x1.15b1e5f75270dp-2, 0x1.1485f0e0acd3bp-2, 0x1.135c81135c811p-2, 0x1.12358e75d3033p-2,
+	0x1.1111111111111p-2, 0x1.0fef010fef011p-2, 0x1.0ecf56be69c90p-2, 0x1.0db20a88f4696p-2,
+	0x1.0c9714fbcda3bp-2, 0x1.0b7e6ec259dc8p-2, 0x1.0a6810a6810a7p-2, 0x1.0953f39010954p-2,
+	0x1.0842108421084p-2, 0x1.073260a47f7c6p-2, 0x1.0624dd2f1a9fcp-2, 0x1.05197f7d73404p-2,
+	0x1.0410410410410p-2, 0x1.03091b51f5e1ap-2, 0x1.0204081020408p-2, 0x1.0101010101010p-2,
+	0x1.0000000000000p-2, 0x1.fc07f01fc07f0p-3, 0x1.f81f81f81f820p-3, 0x1.f44659e4a4271p-3,
+	0x1.f07c1f07c1f08p-3, 0x1.ecc07b301ecc0p-3, 0x1.e9131abf0b767p-3, 0x1.e573ac901e574p-3,
+	0x1.e1e1e1e1e1e1ep-3, 0x1.de5d6e3f8868ap-3, 0x1.dae6076b981dbp-3, 0x1.d77b654b82c34p-3,
+	0x1.d41d41d41d41dp-3, 0x1.d0cb58f6ec074p-3, 0x1.cd85689039b0bp-3, 0x1.ca4b3055ee191p-3,
+	0x1.c71c71c71c71cp-3, 0x1.c3f8f01c3f8f0p-3, 0x1.c0e070381c0e0p-3, 0x1.bdd2b899406f7p-3,
+	0x1.bacf914c1bad0p-3, 0x1.b7d6c3dda338bp-3, 0x1.b4e81b4e81b4fp-3, 0x1.b2036406c80d9p-3,
+	0x1.af286bca1af28p-3, 0x1.ac5701ac5701bp-3, 0x1.a98ef606a63bep-3, 0x1.a6d01a6d01a6dp-3,
+	0x1.a41a41a41a41ap-3, 0x1.a16d3f97a4b02p-3, 0x1.9ec8e951033d9p-3, 0x1.9c2d14ee4a102p-3,
+	0x1.999999999999ap-3, 0x1.970e4f80cb872p-3, 0x1.948b0fcd6e9e0p-3, 0x1.920fb49d0e229p-3,
+	0x1.8f9c18f9c18fap-3, 0x1.8d3018d3018d3p-3, 0x1.8acb90f6bf3aap-3, 0x1.886e5f0abb04ap-3,
+	0x1.8618618618618p-3, 0x1.83c977ab2beddp-3, 0x1.8181818181818p-3, 0x1.7f405fd017f40p-3,
+	0x1.7d05f417d05f4p-3, 0x1.7ad2208e0ecc3p-3, 0x1.78a4c8178a4c8p-3, 0x1.767dce434a9b1p-3,
+	0x1.745d1745d1746p-3, 0x1.724287f46debcp-3, 0x1.702e05c0b8170p-3, 0x1.6e1f76b4337c7p-3,
+	0x1.6c16c16c16c17p-3, 0x1.6a13cd1537290p-3, 0x1.6816816816817p-3, 0x1.661ec6a5122f9p-3,
+	0x1.642c8590b2164p-3, 0x1.623fa77016240p-3, 0x1.6058160581606p-3, 0x1.5e75bb8d015e7p-3,
+	0x1.5c9882b931057p-3, 0x1.5ac056b015ac0p-3, 0x1.58ed2308158edp-3, 0x1.571ed3c506b3ap-3,
+	0x1.5555555555555p-3, 0x1.5390948f40febp-3, 0x1.51d07eae2f815p-3, 0x1.5015015015015p-3,
+	0x1.4e5e0a72f0539p-3, 0x1.4cab88725af6ep-3, 0x1.4afd6a052bf5bp-3, 0x1.49539e3b2d067p-3,
+	0x1.47ae147ae147bp-3, 0x1.460cbc7f5cf9ap-3, 0x1.446f86562d9fbp-3, 0x1.42d6625d51f87p-3,
+	0x1.4141414141414p-3, 0x1.3fb013fb013fbp-3, 0x1.3e22cbce4a902p-3, 0x1.3c995a47babe7p-3,
+	0x1.3b13b13b13b14p-3, 0x1.3991c2c187f63p-3, 0x1.3813813813814p-3, 0x1.3698df3de0748p-3,
+	0x1.3521cfb2b78c1p-3, 0x1.33ae45b57bcb2p-3, 0x1.323e34a2b10bfp-3, 0x1.30d190130d190p-3,
+	0x1.2f684bda12f68p-3, 0x1.2e025c04b8097p-3, 0x1.2c9fb4d812ca0p-3, 0x1.2b404ad012b40p-3,
+	0x1.29e4129e4129ep-3, 0x1.288b01288b013p-3, 0x1.27350b8812735p-3, 0x1.25e22708092f1p-3,
+	0x1.2492492492492p-3, 0x1.23456789abcdfp-3, 0x1.21fb78121fb78p-3, 0x1.20b470c67c0d9p-3,
+	0x1.1f7047dc11f70p-3, 0x1.1e2ef3b3fb874p-3, 0x1.1cf06ada2811dp-3, 0x1.1bb4a4046ed29p-3,
+	0x1.1a7b9611a7b96p-3, 0x1.19453808ca29cp-3, 0x1.1811811811812p-3, 0x1.16e0689427379p-3,
+	0x1.15b1e5f75270dp-3, 0x1.1485f0e0acd3bp-3, 0x1.135c81135c811p-3, 0x1.12358e75d3033p-3,
+	0x1.1111111111111p-3, 0x1.0fef010fef011p-3, 0x1.0ecf56be69c90p-3, 0x1.0db20a88f4696p-3,
+	0x1.0c9714fbcda3bp-3, 0x1.0b7e6ec259dc8p-3, 0x1.0a6810a6810a7p-3, 0x1.0953f39010954p-3,
+	0x1.0842108421084p-3, 0x1.073260a47f7c6p-3, 0x1.0624dd2f1a9fcp-3, 0x1.05197f7d73404p-3,
+	0x1.0410410410410p-3, 0x1.03091b51f5e1ap-3, 0x1.0204081020408p-3, 0x1.0101010101010p-3,
+	0x1.0000000000000p-3, 0x1.fc07f01fc07f0p-4, 0x1.f81f81f81f820p-4, 0x1.f44659e4a4271p-4,
+	0x1.f07c1f07c1f08p-4, 0x1.ecc07b301ecc0p-4, 0x1.e9131abf0b767p-4, 0x1.e573ac901e574p-4,
+	0x1.e1e1e1e1e1e1ep-4, 0x1.de5d6e3f8868ap-4, 0x1.dae6076b981dbp-4, 0x1.d77b654b82c34p-4,
+	0x1.d41d41d41d41dp-4, 0x1.d0cb58f6ec074p-4, 0x1.cd85689039b0bp-4, 0x1.ca4b3055ee191p-4,
+	0x1.c71c71c71c71cp-4, 0x1.c3f8f01c3f8f0p-4, 0x1.c0e070381c0e0p-4, 0x1.bdd2b899406f7p-4,
+	0x1.bacf914c1bad0p-4, 0x1.b7d6c3dda338bp-4, 0x1.b4e81b4e81b4fp-4, 0x1.b2036406c80d9p-4,
+	0x1.af286bca1af28p-4, 0x1.ac5701ac5701bp-4, 0x1.a98ef606a63bep-4, 0x1.a6d01a6d01a6dp-4,
+	0x1.a41a41a41a41ap-4, 0x1.a16d3f97a4b02p-4, 0x1.9ec8e951033d9p-4, 0x1.9c2d14ee4a102p-4,
+};
+
+// 10^f for 0 <= f < 1, in [1, 10]
+inline auto pow10_frac(const double f) -> double {
+	constexpr const double C1 = 0x1.26bb1bbb55516p+1; // ln(10)^n / n!
+	constexpr const double C2 = 0x1.53524c73cea69p+1;
+	constexpr const double C3 = 0x1.0470591de2ca4p+1;
+	constexpr const double C4 = 0x1.2bd7609fd98c4p+0;
+	constexpr const double C5 = 0x1.1429ffd1d4d76p-1;
+	constexpr const double C6 = 0x1.a7ed70847c8b6p-3;
+
+	const auto j = static_cast<int64_t>(f * TABLE_SIZE + 0.5);
+	// exact, f and j / 128 are at most 1/256 apart
+	const auto r = f - static_cast<double>(j) * (1.0 / TABLE_SIZE);
+
+	// 10^r - 1
+	const auto q = r * (C1 + r * (C2 + r * (C3 + r * (C4 + r * (C5 + r * C6)))));
+
+	const auto hi = POW10_FRAC_HI[j];
+	return hi + (POW10_FRAC_LO[j] + hi * q);
+}
+
+// log10(m) for 1 <= m < 10, in [0, 1)
+inline auto log10_mantissa(const double m) -> double {
+	constexpr const double INV_LN10_HI = 0x1.bcb7b10000000p-2; // only 26 bits, see r_hi
+	constexpr const double INV_LN10_LO = 0x1.49b9438ca9aaep-28;
+	constexpr const double A2 = -0x1.bcb7b1526e50ep-3; // (-1)^(n + 1) / (n * ln(10))
+	constexpr const double A3 = 0x1.287a7636f435fp-3;
+	constexpr const double A4 = -0x1.bcb7b1526e50ep-4;
+	constexpr const double A5 = 0x1.63c62775250d8p-4;
+	constexpr const double A6 = -0x1.287a7636f435fp-4;
+	constexpr const double A7 = 0x1.fc3fa615105c7p-5;
+	constexpr const double A8 = -0x1.bcb7b1526e50ep-5;
+
+	// m = c * (1 + r), with c being m cut down to its top 7 mantissa bits, so
+	// 0 <= r < 1/128. The exponent and those bits are the table index.
+	uint64_t bits;
+	memcpy(&bits, &m, sizeof(bits));
+	const auto idx = static_cast<int64_t>((bits >> (52 - TABLE_BITS)) - (uint64_t(1023) << TABLE_BITS));
+	bits &= ~((uint64_t(1) << (52 - TABLE_BITS)) - 1);
+	double c;
+	memcpy(&c, &bits, sizeof(c));
+	const auto r = (m - c) * LOG10_TABLE_INV[idx];
+
+	// r_hi * INV_LN10_HI is exact, since both have at most 26 bits
+	double r_hi;
+	memcpy(&bits, &r, sizeof(bits));
+	bits &= ~((uint64_t(1) << 27) - 1);
+	memcpy(&r_hi, &bits, sizeof(r_hi));
+	const auto r_lo = r - r_hi;
+
+	// log10(1 + r) - r / ln(10)
+	const auto tail = r * r * (A2 + r * (A3 + r * (A4 + r * (A5 + r * (A6 + r * (A7 + r * A8))))));
+
+	// The table entry is either 0 or bigger than the other term, so the sum
+	// and its rounding error take a single two_sum.
+	const auto a = LOG10_TABLE_HI[idx];
+	const auto b = r_hi * INV_LN10_HI;
+	const auto hi = a + b;
+	const auto err = b - (hi - a);
+
+	const auto lo = err + LOG10_TABLE_LO[idx] + r_lo * INV_LN10_HI + r * INV_LN10_LO + tail;
+	return hi + lo;
+}
+
+} // namespace decimal_fastmath
@@ -0,0 +1,249 @@
+#pragma once
+
+// Display notations for decimals, meant for UI rather than round-tripping.
+// Like decimal_string.hpp (which this builds on), there's no Godot dependency
+// and everything is written into a caller-provided buffer.
+
+#include "decimal_core.hpp"
+#include "decimal_string.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace decimal_format {
+
+enum class Notation : uint8_t {
+	SCIENTIFIC,   // 1.23e+45
+	ENGINEERING,  // 123.45e+42, the exponent is always a multiple of 3
+	SUFFIX,       // 123.45aa, with K, M, B, T and then aa, ab, ... zz
+	LOGARITHMIC,  // e45.09, the base 10 logarithm
+};
+
+constexpr const int64_t MAX_PLACES = decimal_string::MAX_PLACES;
+constexpr const int64_t MIN_PLAIN_EXPONENT = -1;
+constexpr const int64_t MAX_PLAIN_EXPONENT = 15;
+
+// one letter suffixes for 1e3 to 1e12, two letter ones from there on
+constexpr const char SHORT_SUFFIXES[][2] = { "K", "M", "B", "T" };
+constexpr const int64_t SHORT_SUFFIX_COUNT = 4;
+constexpr const int64_t LETTER_SUFFIX_COUNT = 26 * 26;
+
+struct Settings {
+	Notation notation = Notation::SUFFIX;
+
+	// digits after the dot, in [0, MAX_PLACES]
+	int64_t places = 2;
+
+	// values below 10^(plain_max_exponent + 1) are written out plainly, as
+	// long as `places` digits are enough to show them (so 0.05 is plain with
+	// 2 places, but 0.001 isn't). -1 turns this off for everything above 1.
+	int64_t plain_max_exponent = 2;
+
+	// all of the above packed in 32 bits, for cache keys
+	constexpr auto key() const -> uint32_t {
+		return static_cast<uint32_t>(notation) |
+			(static_cast<uint32_t>(places) << 8) |
+			(static_cast<uint32_t>(plain_max_exponent - MIN_PLAIN_EXPONENT) << 16);
+	}
+};
+
+inline auto clamp_places(const int64_t places) -> int64_t {
+	return std::min(std::max(places, int64_t(0)), MAX_PLACES);
+}
+
+inline auto clamp_plain_max_exponent(const int64_t exp) -> int64_t {
+	return std::min(std::max(exp, MIN_PLAIN_EXPONENT), MAX_PLAIN_EXPONENT);
+}
+
+// floor(a / b) for b > 0
+constexpr auto floor_div(const int64_t a, const int64_t b) -> int64_t {
+	return a / b - ((a % b != 0 && a < 0) ? 1 : 0);
+}
+
+// Rounds to `places` digits after the dot once the value is scaled down by
+// 10^shift, i.e. the same spot write_fixed() cuts at. The exponent of the
+// result can end up one higher than the input's.
+inline auto round_at(const DecimalData &dec, const int64_t shift, const int64_t places) -> decimal_string::Digits {
+	const auto int_digits = dec.exponent - shift + 1;
+	const auto count = std::min(std::max(int_digits + places, int64_t(1)), decimal_string::MAX_PLACES + 1);
+	return decimal_string::fixed_digits(dec, count - 1);
+}
+
+// Writes d / 10^shift with exactly `places` digits after the dot (none, and no
+// dot, for 0 places). Missing digits are zeros, extra ones are dropped, so
+// `d` should have been rounded at the same spot already.
+inline auto write_fixed(char *buf, const decimal_string::Digits &d, const int64_t shift, const int64_t places) -> int64_t {
+	char digits[20] = {};
+	decimal_string::write_digits(digits, d.digits, d.count);
+
+	// digit `i` of `digits` sits at 10^(point - i)
+	const auto point = d.exponent - shift;
+	const auto digit_at = [&](const int64_t pos) -> char {
+		const auto i = point - pos;
+		return (i >= 0 && i < d.count) ? digits[i] : '0';
+	};
+
+	int64_t len = 0;
+	if (d.negative) {
+		buf[len++] = '-';
+	}
+
+	if (point < 0) {
+		buf[len++] = '0';
+	} else {
+		for (auto pos = point; pos >= 0; pos--) {
+			buf[len++] = digit_at(pos);
+		}
+	}
+
+	if (places > 0) {
+		buf[len++] = '.';
+		for (int64_t pos = -1; pos >= -places; pos--) {
+			buf[len++] = digit_at(pos);
+		}
+	}
+
+	buf[len] = '\0';
+	return len;
+}
+
+inline auto write_suffix(char *buf, const int64_t group) -> int64_t {
+	if (group <= SHORT_SUFFIX_COUNT) {
+		buf[0] = SHORT_SUFFIXES[group - 1][0];
+		buf[1] = '\0';
+		return 1;
+	}
+
+	const auto idx = group - SHORT_SUFFIX_COUNT - 1;
+	buf[0] = static_cast<char>('a' + idx / 26);
+	buf[1] = static_cast<char>('a' + idx % 26);
+	buf[2] = '\0';
+	return 2;
+}
+
+inline auto format_scientific(const DecimalData &dec, const int64_t places, char *buf) -> int64_t {
+	return decimal_string::write_exponential(buf, decimal_string::fixed_digits(dec, places));
+}
+
+// Engineering and suffix notation both write the mantissa scaled into
+// [1, 1000), they only differ in what comes after it.
+inline auto format_grouped(const DecimalData &dec, const Settings &s, char *buf) -> int64_t {
+	// the lowest group would start below INT64_MIN
+	if (DECIMAL_UNLIKELY(dec.exponent < INT64_MIN + 2)) {
+		return format_scientific(dec, s.places, buf);
+	}
+
+	auto group = floor_div(dec.exponent, 3);
+	auto d = round_at(dec, group * 3, s.places);
+
+	// 999.996 rounds up into the next group
+	if (d.exponent != dec.exponent && floor_div(d.exponent, 3) != group) {
+		group = floor_div(d.exponent, 3);
+	}
+
+	if (s.notation == Notation::SUFFIX) {
+		// past "zz", or small enough to need a negative suffix
+		if (group < 0 || group > SHORT_SUFFIX_COUNT + LETTER_SUFFIX_COUNT) {
+			return format_scientific(dec, s.places, buf);
+		}
+
+		auto len = write_fixed(buf, d, group * 3, s.places);
+		if (group > 0) {
+			len += write_suffix(buf + len, group);
+		}
+		return len;
+	}
+
+	auto len = write_fixed(buf, d, group * 3, s.places);
+	len += decimal_string::write_exponent(buf + len, group * 3);
+	buf[len] = '\0';
+	return len;
+}
+
+// "e" followed by log10(|dec|), with a "-" in front for negative values
+inline auto format_logarithmic(const DecimalData &dec, const int64_t places, char *buf) -> int64_t {
+	const auto d = decimal_string::prepare(dec);
+
+	// log10 = exponent + frac, where frac = log10(mantissa) is in [0, 1).
+	// Those two are kept apart, as a double couldn't hold both for exponents
+	// past 2^53.
+	const auto unit = decimal_string::POW10_U64[places];
+	auto frac = static_cast<uint64_t>(std::llround(std::log10(std::abs(d.mantissa)) * static_cast<double>(unit)));
+	const auto carry = frac >= unit;
+	if (carry) {
+		frac -= unit;
+	}
+
+	// for negative logs, -3 + 0.3 has to come out as -2.7 (unsigned math, so
+	// neither end of the exponent range overflows)
+	const auto negative_log = d.exponent < 0 && !(carry && d.exponent == -1);
+	auto int_part = negative_log ?
+		(0 - static_cast<uint64_t>(d.exponent)) - (carry ? 1 : 0) :
+		static_cast<uint64_t>(d.exponent) + (carry ? 1 : 0);
+	if (negative_log && frac != 0) {
+		int_part--;
+		frac = unit - frac;
+	}
+
+	int64_t len = 0;
+	if (std::signbit(d.mantissa)) {
+		buf[len++] = '-';
+	}
+	buf[len++] = 'e';
+	if (negative_log) {
+		buf[len++] = '-';
+	}
+
+	char tmp[20];
+	int64_t n = 0;
+	do {
+		tmp[n++] = static_cast<char>('0' + int_part % 10);
+		int_part /= 10;
+	} while (int_part != 0);
+	while (n > 0) {
+		buf[len++] = tmp[--n];
+	}
+
+	if (places > 0) {
+		buf[len++] = '.';
+		len += decimal_string::write_digits(buf + len, frac, places);
+	}
+
+	buf[len] = '\0';
+	return len;
+}
+
+// Writes `dec` in the notation from `s` (places and plain_max_exponent are
+// expected to be clamped already). Needs decimal_string::BUF_SIZE bytes.
+inline auto format(const DecimalData &dec, const Settings &s, char *buf) -> int64_t {
+	if (DECIMAL_UNLIKELY(!std::isfinite(dec.mantissa))) {
+		return decimal_string::write_non_finite(buf, dec.mantissa);
+	}
+
+	if (dec.mantissa == 0) {
+		return write_fixed(buf, decimal_string::Digits { 0, 1, 0, false }, 0, s.places);
+	}
+
+	const auto d = decimal_string::prepare(dec);
+
+	// plain if it still fits after rounding, 999.996 with 2 places doesn't.
+	// One digit too small can carry into range, 0.96 with 0 places is 1.
+	if (d.exponent >= -s.places - 1 && d.exponent <= s.plain_max_exponent) {
+		const auto rounded = round_at(d, 0, s.places);
+		if (rounded.exponent >= -s.places && rounded.exponent <= s.plain_max_exponent) {
+			return write_fixed(buf, rounded, 0, s.places);
+		}
+	}
+
+	switch (s.notation) {
+		case Notation::SCIENTIFIC: return format_scientific(d, s.places, buf);
+		case Notation::ENGINEERING: return format_grouped(d, s, buf);
+		case Notation::SUFFIX: return format_grouped(d, s, buf);
+		case Notation::LOGARITHMIC: return format_logarithmic(d, s.places, buf);
+	}
+	return format_scientific(d, s.places, buf);
+}
+
+} // namespace decimal_format
@@ -0,0 +1,167 @@
+#include "decimal_formatter.hpp"
+#include "decimal_string.hpp"
+#include "godot_cpp/core/error_macros.hpp"
+#include "godot_cpp/core/object.hpp"
+#include <cstdint>
+#include <cstring>
+#include <godot_cpp/core/class_db.hpp>
+
+using namespace godot;
+
+auto DecimalFormatter::_bind_methods() -> void {
+	ClassDB::bind_method(D_METHOD("set_notation", "notation"), &DecimalFormatter::set_notation);
+	ClassDB::bind_method(D_METHOD("get_notation"), &DecimalFormatter::get_notation);
+
+	ClassDB::bind_method(D_METHOD("set_places", "places"), &DecimalFormatter::set_places);
+	ClassDB::bind_method(D_METHOD("get_places"), &DecimalFormatter::get_places);
+
+	ClassDB::bind_method(D_METHOD("set_plain_max_exponent", "exp"), &DecimalFormatter::set_plain_max_exponent);
+	ClassDB::bind_method(D_METHOD("get_plain_max_exponent"), &DecimalFormatter::get_plain_max_exponent);
+
+	ClassDB::bind_method(D_METHOD("set_cache_size", "size"), &DecimalFormatter::set_cache_size);
+	ClassDB::bind_method(D_METHOD("get_cache_size"), &DecimalFormatter::get_cache_size);
+
+	ClassDB::bind_method(D_METHOD("format", "decimal"), &DecimalFormatter::format);
+	ClassDB::bind_method(D_METHOD("format_array", "values"), &DecimalFormatter::format_array);
+
+	ClassDB::bind_method(D_METHOD("clear_cache"), &DecimalFormatter::clear_cache);
+	ClassDB::bind_method(D_METHOD("get_cache_hits"), &DecimalFormatter::get_cache_hits);
+	ClassDB::bind_method(D_METHOD("get_cache_misses"), &DecimalFormatter::get_cache_misses);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "notation", PROPERTY_HINT_ENUM, "Scientific,Engineering,Suffix,Logarithmic"), "set_notation", "get_notation");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "places", PROPERTY_HINT_RANGE, "0,17"), "set_places", "get_places");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "plain_max_exponent", PROPERTY_HINT_RANGE, "-1,15"), "set_plain_max_exponent", "get_plain_max_exponent");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "cache_size"), "set_cache_size", "get_cache_size");
+
+	BIND_ENUM_CONSTANT(NOTATION_SCIENTIFIC);
+	BIND_ENUM_CONSTANT(NOTATION_ENGINEERING);
+	BIND_ENUM_CONSTANT(NOTATION_SUFFIX);
+	BIND_ENUM_CONSTANT(NOTATION_LOGARITHMIC);
+}
+
+DecimalFormatter::DecimalFormatter() {
+	set_cache_size(DEFAULT_CACHE_SIZE);
+}
+
+auto DecimalFormatter::set_notation(const Notation notation) -> void {
+	ERR_FAIL_COND_MSG(notation < NOTATION_SCIENTIFIC || notation > NOTATION_LOGARITHMIC,
+		"DecimalFormatter.set_notation() - unknown notation " + String::num_int64(notation) + "."
+	);
+	settings.notation = static_cast<decimal_format::Notation>(notation);
+}
+
+auto DecimalFormatter::get_notation() const -> Notation {
+	return static_cast<Notation>(settings.notation);
+}
+
+auto DecimalFormatter::set_places(const int64_t places) -> void {
+	settings.places = decimal_format::clamp_places(places);
+}
+
+auto DecimalFormatter::get_places() const -> int64_t {
+	return settings.places;
+}
+
+auto DecimalFormatter::set_plain_max_exponent(const int64_t exp) -> void {
+	settings.plain_max_exponent = decimal_format::clamp_plain_max_exponent(exp);
+}
+
+auto DecimalFormatter::get_plain_max_exponent() const -> int64_t {
+	return settings.plain_max_exponent;
+}
+
+auto DecimalFormatter::set_cache_size(const int64_t size) -> void {
+	ERR_FAIL_COND_MSG(size < 0 || size > MAX_CACHE_SIZE,
+		"DecimalFormatter.set_cache_size() - size has to be between 0 and " + String::num_int64(MAX_CACHE_SIZE) + "."
+	);
+
+	// rounded up to a power of 2, so that slots can be picked with a mask
+	int64_t slots = size > 0 ? 1 : 0;
+	while (slots < size) {
+		slots *= 2;
+	}
+
+	cache.clear();
+	cache.resize(slots);
+	cache_mask = slots > 0 ? static_cast<uint64_t>(slots - 1) : 0;
+}
+
+auto DecimalFormatter::get_cache_size() const -> int64_t {
+	return static_cast<int64_t>(cache.size());
+}
+
+auto DecimalFormatter::format_uncached(const DecimalData &dec) const -> String {
+	char buf[decimal_string::BUF_SIZE];
+	decimal_format::format(dec, settings, buf);
+	return String(buf);
+}
+
+static auto hash_key(const DecimalData &dec, const uint32_t settings_key) -> uint64_t {
+	uint64_t bits;
+	memcpy(&bits, &dec.mantissa, sizeof(bits));
+
+	// splitmix64's finalizer over both halves of the value and the settings
+	auto h = bits ^ (static_cast<uint64_t>(dec.exponent) * 0x9e3779b97f4a7c15ull) ^ settings_key;
+	h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+	h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+	return h ^ (h >> 31);
+}
+
+auto DecimalFormatter::format_into(const DecimalData *values, const int64_t count, String *out) -> void {
+	if (cache.empty()) {
+		for (int64_t i = 0; i < count; i++) {
+			out[i] = format_uncached(values[i]);
+		}
+		cache_misses += count;
+		return;
+	}
+
+	const auto key = settings.key();
+	for (int64_t i = 0; i < count; i++) {
+		auto &entry = cache[hash_key(values[i], key) & cache_mask];
+
+		// compared bytewise, so -0 and 0 (or two different NaNs) don't share an entry
+		if (entry.used && entry.settings_key == key && memcmp(&entry.value, &values[i], sizeof(DecimalData)) == 0) {
+			cache_hits++;
+		} else {
+			cache_misses++;
+			entry.value = values[i];
+			entry.settings_key = key;
+			entry.used = true;
+			entry.text = format_uncached(values[i]);
+		}
+		out[i] = entry.text;
+	}
+}
+
+auto DecimalFormatter::format(const Vector4i decimal) -> String {
+	const auto dec = to_decimal(decimal);
+	String res;
+	format_into(&dec, 1, &res);
+	return res;
+}
+
+auto DecimalFormatter::format_array(const Ref<DecimalArray> &values) -> PackedStringArray {
+	ERR_FAIL_COND_V_MSG(values.is_null(), PackedStringArray(), "DecimalFormatter.format_array() - `values` cannot be null.");
+
+	PackedStringArray res;
+	res.resize(values->size());
+	format_into(values->ptr(), values->size(), res.ptrw());
+	return res;
+}
+
+auto DecimalFormatter::clear_cache() -> void {
+	for (auto &entry : cache) {
+		entry = CacheEntry();
+	}
+	cache_hits = 0;
+	cache_misses = 0;
+}
+
+auto DecimalFormatter::get_cache_hits() const -> int64_t {
+	return cache_hits;
+}
+
+auto DecimalFormatter::get_cache_misses() const -> int64_t {
+	return cache_misses;
+}
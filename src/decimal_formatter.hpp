@@ -0,0 +1,87 @@
+#pragma once
+
+#include "godot_cpp/classes/ref_counted.hpp"
+#include "godot_cpp/core/binder_common.hpp"
+#include "godot_cpp/variant/packed_string_array.hpp"
+#include "godot_cpp/variant/string.hpp"
+#include "godot_cpp/variant/vector4i.hpp"
+
+#include "decimal_array.hpp"
+#include "decimal_format.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace godot;
+
+// Formats decimals for display, in one of the notations from decimal_format.hpp.
+//
+// HUDs tend to format the same handful of values every frame, so results are
+// kept in a small direct-mapped cache keyed by the raw 16 bytes of the value
+// plus the settings. A hit costs a hash and a String refcount bump. Changing
+// the settings doesn't throw anything away; the old entries just stop
+// matching until they're overwritten (or the settings are changed back).
+class DecimalFormatter : public RefCounted {
+
+	GDCLASS(DecimalFormatter, RefCounted)
+
+public:
+	enum Notation {
+		NOTATION_SCIENTIFIC = static_cast<int>(decimal_format::Notation::SCIENTIFIC),
+		NOTATION_ENGINEERING = static_cast<int>(decimal_format::Notation::ENGINEERING),
+		NOTATION_SUFFIX = static_cast<int>(decimal_format::Notation::SUFFIX),
+		NOTATION_LOGARITHMIC = static_cast<int>(decimal_format::Notation::LOGARITHMIC),
+	};
+
+protected:
+	static auto _bind_methods() -> void;
+
+private:
+	struct CacheEntry {
+		DecimalData value;
+		uint32_t settings_key = 0;
+		bool used = false;
+		String text;
+	};
+
+	decimal_format::Settings settings;
+
+	std::vector<CacheEntry> cache;
+	uint64_t cache_mask = 0;
+
+	int64_t cache_hits = 0;
+	int64_t cache_misses = 0;
+
+	auto format_uncached(const DecimalData &dec) const -> String;
+
+public:
+	static constexpr const int64_t DEFAULT_CACHE_SIZE = 256;
+	static constexpr const int64_t MAX_CACHE_SIZE = 1 << 20;
+
+	DecimalFormatter();
+	~DecimalFormatter() = default;
+
+	auto set_notation(const Notation notation) -> void;
+	auto get_notation() const -> Notation;
+
+	auto set_places(const int64_t places) -> void;
+	auto get_places() const -> int64_t;
+
+	auto set_plain_max_exponent(const int64_t exp) -> void;
+	auto get_plain_max_exponent() const -> int64_t;
+
+	auto set_cache_size(const int64_t size) -> void;
+	auto get_cache_size() const -> int64_t;
+
+	auto format(const Vector4i decimal) -> String;
+	auto format_array(const Ref<DecimalArray> &values) -> PackedStringArray;
+
+	// for C++ callers, `out` needs room for `count` Strings
+	auto format_into(const DecimalData *values, const int64_t count, String *out) -> void;
+
+	auto clear_cache() -> void;
+	auto get_cache_hits() const -> int64_t;
+	auto get_cache_misses() const -> int64_t;
+};
+
+VARIANT_ENUM_CAST(DecimalFormatter::Notation);
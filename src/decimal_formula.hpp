@@ -0,0 +1,650 @@
+#pragma once
+
+// Formulas like "base * 1.15^owned * (1 + prestige)^0.5", compiled once into a
+// small stack-machine program and then evaluated natively, for one set of
+// variables or for whole columns of them at a time.
+//
+// Compiling parses into a tree, folds everything that only depends on
+// constants, then emits postfix code. A few shapes get their own instruction:
+// a * b + c becomes a single MUL_ADD, and a power with a constant non-integer
+// exponent becomes a POW_NUM that calls pow_num() with a plain double.
+//
+// Batches run one instruction at a time over blocks of BLOCK rows, so the
+// dispatch is paid once per block instead of once per row, and add, sub, mul
+// go through the decimal_simd kernels.
+
+#include "decimal_core.hpp"
+#include "decimal_simd.hpp"
+#include "decimal_string.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace decimal_formula {
+
+enum class Op : uint8_t {
+	CONST,    // push constants[arg]
+	VAR,      // push variable arg
+	NEG,
+	ADD,
+	SUB,
+	MUL,
+	DIV,
+	POW,
+	POW_NUM,  // pow_num(a, numbers[arg])
+	MUL_ADD,  // a * b + c
+	ABS,
+	SQRT,
+	CBRT,
+	EXP,
+	LN,
+	LOG10,
+	FLOOR,
+	CEIL,
+	MIN,
+	MAX,
+};
+
+struct Instruction {
+	Op op;
+	int32_t arg;
+};
+
+struct Program {
+	std::vector<Instruction> code;
+	std::vector<DecimalData> constants;
+	std::vector<double> numbers;
+	int64_t variable_count = 0;
+	int64_t max_depth = 0;
+};
+
+struct CompileError {
+	const char *message = nullptr;  // nullptr on success
+	int64_t position = 0;           // byte offset into the formula
+};
+
+// rows per block in run()
+constexpr const int64_t BLOCK = 64;
+
+// formulas nested deeper than this are rejected instead of overflowing the
+// parser's call stack
+constexpr const int64_t MAX_NESTING = 256;
+
+struct Function {
+	const char *name;
+	Op op;
+	int64_t arg_count;
+};
+
+constexpr const Function FUNCTIONS[] = {
+	{ "abs", Op::ABS, 1 },
+	{ "cbrt", Op::CBRT, 1 },
+	{ "ceil", Op::CEIL, 1 },
+	{ "exp", Op::EXP, 1 },
+	{ "floor", Op::FLOOR, 1 },
+	{ "ln", Op::LN, 1 },
+	{ "log10", Op::LOG10, 1 },
+	{ "max", Op::MAX, 2 },
+	{ "min", Op::MIN, 2 },
+	{ "sqrt", Op::SQRT, 1 },
+};
+
+inline auto arity(const Op op) -> int64_t {
+	switch (op) {
+		case Op::CONST:
+		case Op::VAR:
+			return 0;
+		case Op::ADD:
+		case Op::SUB:
+		case Op::MUL:
+		case Op::DIV:
+		case Op::POW:
+		case Op::MIN:
+		case Op::MAX:
+			return 2;
+		case Op::MUL_ADD:
+			return 3;
+		default:
+			return 1;
+	}
+}
+
+// one instruction on one row, POW_NUM's exponent is passed as `num`
+inline auto apply(const Op op, const DecimalData &a, const DecimalData &b, const DecimalData &c, const double num) -> DecimalData {
+	namespace core = decimal_core;
+
+	switch (op) {
+		case Op::NEG: return core::neg(a);
+		case Op::ADD: return core::add(a, b);
+		case Op::SUB: return core::sub(a, b);
+		case Op::MUL: return core::mul(a, b);
+		case Op::DIV: return core::div(a, b);
+		case Op::POW: return core::pow(a, b);
+		case Op::POW_NUM: return core::pow_num(a, num);
+		case Op::MUL_ADD: return core::add(core::mul(a, b), c);
+		case Op::ABS: return core::abs(a);
+		case Op::SQRT: return core::sqrt(a);
+		case Op::CBRT: return core::cbrt(a);
+		case Op::EXP: return core::exp(a);
+		case Op::LN: return core::from_float(core::ln(a));
+		case Op::LOG10: return core::from_float(core::log10(a));
+		case Op::FLOOR: return core::floor(a);
+		case Op::CEIL: return core::ceil(a);
+		case Op::MIN: return core::min(a, b);
+		case Op::MAX: return core::max(a, b);
+		default: return core::DECIMAL_NAN;
+	}
+}
+
+class Compiler {
+	struct Node {
+		Op op;
+		int32_t children[3] = { -1, -1, -1 };
+		int32_t var = 0;
+		DecimalData value;
+	};
+
+	const char *text;
+	int64_t len;
+	int64_t pos = 0;
+	int64_t nesting = 0;
+	const std::vector<std::string> &names;
+
+	std::vector<Node> nodes;
+	CompileError error;
+
+	static auto is_space(const char c) -> bool {
+		return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+	}
+
+	static auto is_digit(const char c) -> bool {
+		return c >= '0' && c <= '9';
+	}
+
+	static auto is_ident_start(const char c) -> bool {
+		return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+	}
+
+	static auto is_ident(const char c) -> bool {
+		return is_ident_start(c) || is_digit(c);
+	}
+
+	auto skip_space() -> void {
+		while (pos < len && is_space(text[pos])) {
+			pos++;
+		}
+	}
+
+	auto peek() -> char {
+		skip_space();
+		return pos < len ? text[pos] : '\0';
+	}
+
+	auto fail(const char *message, const int64_t at) -> int32_t {
+		if (error.message == nullptr) {
+			error.message = message;
+			error.position = at;
+		}
+		return -1;
+	}
+
+	auto make_const(const DecimalData &value) -> int32_t {
+		Node n;
+		n.op = Op::CONST;
+		n.value = value;
+		nodes.push_back(n);
+		return static_cast<int32_t>(nodes.size() - 1);
+	}
+
+	// anything that only depends on constants is worked out right here
+	auto make(const Op op, const int32_t a, const int32_t b = -1) -> int32_t {
+		if (a < 0 || (arity(op) > 1 && b < 0)) return -1;
+
+		const auto const_a = nodes[a].op == Op::CONST;
+		const auto const_b = arity(op) < 2 || nodes[b].op == Op::CONST;
+		if (const_a && const_b) {
+			const auto &vb = arity(op) < 2 ? decimal_core::DECIMAL_ZERO : nodes[b].value;
+			return make_const(apply(op, nodes[a].value, vb, decimal_core::DECIMAL_ZERO, 0.0));
+		}
+
+		Node n;
+		n.op = op;
+		n.children[0] = a;
+		n.children[1] = b;
+		nodes.push_back(n);
+		return static_cast<int32_t>(nodes.size() - 1);
+	}
+
+	auto parse_number() -> int32_t {
+		const auto start = pos;
+		while (pos < len && (is_digit(text[pos]) || text[pos] == '.')) {
+			pos++;
+		}
+		// only an exponent if digits follow, "2e" is left for the error below
+		if (pos < len && (text[pos] == 'e' || text[pos] == 'E')) {
+			auto end = pos + 1;
+			if (end < len && (text[end] == '+' || text[end] == '-')) {
+				end++;
+			}
+			if (end < len && is_digit(text[end])) {
+				pos = end;
+				while (pos < len && is_digit(text[pos])) {
+					pos++;
+				}
+			}
+		}
+		if (pos < len && is_ident(text[pos])) {
+			return fail("Invalid number.", start);
+		}
+
+		DecimalData value;
+		const auto res = decimal_string::parse(text + start, pos - start, value);
+		if (res.error != decimal_string::ParseError::OK) {
+			return fail("Invalid number.", start);
+		}
+		return make_const(value);
+	}
+
+	auto parse_call(const Function &fn, const int64_t start) -> int32_t {
+		pos++; // (
+		int32_t args[2] = { -1, -1 };
+		int64_t count = 0;
+		if (peek() != ')') {
+			while (true) {
+				if (count == fn.arg_count) {
+					return fail("Too many arguments.", pos);
+				}
+				args[count++] = parse_sum();
+				if (args[count - 1] < 0) return -1;
+				if (peek() != ',') break;
+				pos++;
+			}
+		}
+		if (peek() != ')') {
+			return fail("Expected ')'.", pos);
+		}
+		pos++;
+		if (count != fn.arg_count) {
+			return fail("Wrong number of arguments.", start);
+		}
+		return make(fn.op, args[0], args[1]);
+	}
+
+	auto parse_primary() -> int32_t {
+		const auto c = peek();
+		const auto start = pos;
+
+		if (is_digit(c) || c == '.') {
+			return parse_number();
+		}
+
+		if (c == '(') {
+			pos++;
+			const auto inner = parse_sum();
+			if (inner < 0) return -1;
+			if (peek() != ')') {
+				return fail("Expected ')'.", pos);
+			}
+			pos++;
+			return inner;
+		}
+
+		if (is_ident_start(c)) {
+			while (pos < len && is_ident(text[pos])) {
+				pos++;
+			}
+			const auto word = std::string(text + start, pos - start);
+
+			if (peek() == '(') {
+				for (const auto &fn : FUNCTIONS) {
+					if (word == fn.name) {
+						return parse_call(fn, start);
+					}
+				}
+				return fail("Unknown function.", start);
+			}
+
+			for (size_t i = 0; i < names.size(); i++) {
+				if (names[i] == word) {
+					Node n;
+					n.op = Op::VAR;
+					n.var = static_cast<int32_t>(i);
+					nodes.push_back(n);
+					return static_cast<int32_t>(nodes.size() - 1);
+				}
+			}
+			return fail("Unknown variable.", start);
+		}
+
+		if (c == '\0') {
+			return fail("Unexpected end of formula.", pos);
+		}
+		return fail("Unexpected character.", pos);
+	}
+
+	// right-associative, and binds tighter than a leading minus on its
+	// left, so -2^2 is -4 and 2^-1 is 0.5
+	auto parse_power() -> int32_t {
+		const auto base = parse_primary();
+		if (base < 0) return -1;
+		if (peek() != '^') return base;
+		pos++;
+		return make(Op::POW, base, parse_unary());
+	}
+
+	auto parse_unary() -> int32_t {
+		if (++nesting > MAX_NESTING) {
+			return fail("Formula is nested too deeply.", pos);
+		}
+
+		int32_t res;
+		const auto c = peek();
+		if (c == '-' || c == '+') {
+			pos++;
+			const auto operand = parse_unary();
+			res = c == '-' ? make(Op::NEG, operand) : operand;
+		} else {
+			res = parse_power();
+		}
+
+		nesting--;
+		return res;
+	}
+
+	auto parse_product() -> int32_t {
+		auto lhs = parse_unary();
+		while (lhs >= 0 && (peek() == '*' || peek() == '/')) {
+			const auto op = text[pos++] == '*' ? Op::MUL : Op::DIV;
+			lhs = make(op, lhs, parse_unary());
+		}
+		return lhs;
+	}
+
+	auto parse_sum() -> int32_t {
+		auto lhs = parse_product();
+		while (lhs >= 0 && (peek() == '+' || peek() == '-')) {
+			const auto op = text[pos++] == '+' ? Op::ADD : Op::SUB;
+			lhs = make(op, lhs, parse_product());
+		}
+		return lhs;
+	}
+
+	auto is_integer(const DecimalData &value) -> bool {
+		return decimal_core::is_finite(value) && decimal_core::eq(decimal_core::trunc(value), value);
+	}
+
+	auto emit_op(Program &out, const Op op, const int32_t arg, int64_t &depth) -> void {
+		out.code.push_back({ op, arg });
+		depth += 1 - arity(op);
+		out.max_depth = std::max(out.max_depth, depth);
+	}
+
+	// the instruction a node ends up as, once its operands are on the stack
+	enum class Shape : uint8_t {
+		PLAIN,
+		MUL_ADD,  // a * b + c, either way around
+		POW_NUM,  // a constant non-integer exponent
+	};
+
+	auto shape(const Node &n) -> Shape {
+		const auto a = n.children[0];
+		const auto b = n.children[1];
+		if (n.op == Op::ADD && (nodes[a].op == Op::MUL || nodes[b].op == Op::MUL)) return Shape::MUL_ADD;
+		if (n.op == Op::POW && nodes[b].op == Op::CONST && !is_integer(nodes[b].value)) return Shape::POW_NUM;
+		return Shape::PLAIN;
+	}
+
+	// Postfix order, with an explicit stack: a long chain like x + x + ... + x
+	// is one left-leaning branch as deep as it has terms, which parsing
+	// doesn't limit, and recursing down it could overflow the call stack.
+	auto emit(Program &out, const int32_t root) -> void {
+		struct Step {
+			int32_t idx;
+			bool operands_done;
+		};
+		std::vector<Step> steps { { root, false } };
+		int64_t depth = 0;
+
+		while (!steps.empty()) {
+			const auto step = steps.back();
+			steps.pop_back();
+
+			const auto &n = nodes[step.idx];
+			const auto a = n.children[0];
+			const auto b = n.children[1];
+
+			if (n.op == Op::CONST) {
+				out.constants.push_back(n.value);
+				emit_op(out, Op::CONST, static_cast<int32_t>(out.constants.size() - 1), depth);
+				continue;
+			}
+			if (n.op == Op::VAR) {
+				emit_op(out, Op::VAR, n.var, depth);
+				continue;
+			}
+
+			const auto kind = shape(n);
+			if (step.operands_done) {
+				if (kind == Shape::MUL_ADD) {
+					emit_op(out, Op::MUL_ADD, 0, depth);
+				} else if (kind == Shape::POW_NUM) {
+					out.numbers.push_back(decimal_core::into_float_saturated(nodes[b].value));
+					emit_op(out, Op::POW_NUM, static_cast<int32_t>(out.numbers.size() - 1), depth);
+				} else {
+					emit_op(out, n.op, 0, depth);
+				}
+				continue;
+			}
+
+			// operands go on in reverse, so the first one comes off first
+			steps.push_back({ step.idx, true });
+			if (kind == Shape::MUL_ADD) {
+				const auto mul = nodes[a].op == Op::MUL ? a : b;
+				steps.push_back({ mul == a ? b : a, false });
+				steps.push_back({ nodes[mul].children[1], false });
+				steps.push_back({ nodes[mul].children[0], false });
+			} else if (kind == Shape::POW_NUM) {
+				steps.push_back({ a, false });
+			} else {
+				for (auto i = arity(n.op) - 1; i >= 0; i--) {
+					steps.push_back({ n.children[i], false });
+				}
+			}
+		}
+	}
+
+public:
+	Compiler(const char *text, const int64_t len, const std::vector<std::string> &names) :
+			text(text), len(len), names(names) {}
+
+	auto compile(Program &out) -> CompileError {
+		out = Program();
+		out.variable_count = static_cast<int64_t>(names.size());
+
+		for (size_t i = 0; i < names.size(); i++) {
+			for (size_t j = 0; j < i; j++) {
+				if (names[i] == names[j]) {
+					error.message = "Duplicate variable name.";
+					return error;
+				}
+			}
+		}
+
+		const auto root = parse_sum();
+		if (root >= 0 && peek() != '\0') {
+			fail("Unexpected character.", pos);
+		}
+		if (error.message != nullptr) {
+			out = Program();
+			return error;
+		}
+
+		emit(out, root);
+		return error;
+	}
+};
+
+inline auto compile(const char *text, const int64_t len, const std::vector<std::string> &names, Program &out) -> CompileError {
+	return Compiler(text, len, names).compile(out);
+}
+
+// The names a formula refers to as variables, once each, in order of first
+// appearance. Function names are left out. Doesn't check the formula is valid,
+// compile() still has to.
+inline auto variable_names(const char *text, const int64_t len) -> std::vector<std::string> {
+	const auto is_digit = [](const char c) { return c >= '0' && c <= '9'; };
+	const auto is_ident_start = [](const char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_'; };
+	const auto is_ident = [&](const char c) { return is_ident_start(c) || is_digit(c); };
+
+	std::vector<std::string> res;
+	int64_t pos = 0;
+	while (pos < len) {
+		const auto c = text[pos];
+
+		// numbers, with their exponent (see Compiler::parse_number())
+		if (is_digit(c) || c == '.') {
+			while (pos < len && (is_ident(text[pos]) || text[pos] == '.')) {
+				const auto e = text[pos] == 'e' || text[pos] == 'E';
+				pos++;
+				if (e && pos < len && (text[pos] == '+' || text[pos] == '-')) {
+					pos++;
+				}
+			}
+			continue;
+		}
+
+		if (!is_ident_start(c)) {
+			pos++;
+			continue;
+		}
+
+		const auto start = pos;
+		while (pos < len && is_ident(text[pos])) {
+			pos++;
+		}
+		auto next = pos;
+		while (next < len && (text[next] == ' ' || text[next] == '\t' || text[next] == '\n' || text[next] == '\r')) {
+			next++;
+		}
+		if (next < len && text[next] == '(') continue;
+
+		auto word = std::string(text + start, pos - start);
+		if (std::find(res.begin(), res.end(), word) == res.end()) {
+			res.push_back(std::move(word));
+		}
+	}
+	return res;
+}
+
+// Evaluates a single row, `values` has one entry per variable. Same results
+// as run(), minus the per-block overhead.
+inline auto run_one(const Program &p, const DecimalData *values, std::vector<DecimalData> &stack) -> DecimalData {
+	if (p.code.empty()) return decimal_core::DECIMAL_NAN;
+
+	const auto slots = static_cast<size_t>(p.max_depth + 2);
+	if (stack.size() < slots) {
+		stack.resize(slots);
+	}
+
+	DecimalData *top = stack.data();
+	for (const auto &ins : p.code) {
+		const auto args = arity(ins.op);
+		DecimalData *a = top - args;
+
+		switch (ins.op) {
+			case Op::CONST:
+				*top = p.constants[ins.arg];
+				break;
+			case Op::VAR:
+				*top = values[ins.arg];
+				break;
+			case Op::POW_NUM:
+				*a = decimal_core::pow_num(*a, p.numbers[ins.arg]);
+				break;
+			default:
+				*a = apply(ins.op, a[0], a[1], a[2], 0.0);
+				break;
+		}
+
+		top += 1 - args;
+	}
+	return stack[0];
+}
+
+// Evaluates rows [begin, end) into the same rows of `out`. `columns` has one
+// pointer per variable, each to the full column. `stack` is scratch space,
+// grown as needed. Rows don't depend on each other, so ranges can be split
+// across threads as long as each one has its own `stack`.
+inline auto run(
+	const Program &p,
+	const DecimalData *const *columns,
+	const int64_t begin,
+	const int64_t end,
+	DecimalData *out,
+	std::vector<DecimalData> &stack
+) -> void {
+	if (p.code.empty()) return;
+
+	// two spare blocks, so the unused operands of short instructions still
+	// point into the buffer
+	const auto slots = static_cast<size_t>((p.max_depth + 2) * BLOCK);
+	if (stack.size() < slots) {
+		stack.resize(slots);
+	}
+
+	for (auto start = begin; start < end; start += BLOCK) {
+		const auto n = std::min(BLOCK, end - start);
+		DecimalData *top = stack.data(); // one past the last slot in use
+
+		for (const auto &ins : p.code) {
+			const auto args = arity(ins.op);
+			DecimalData *a = top - args * BLOCK;
+			DecimalData *b = a + BLOCK;
+			DecimalData *c = b + BLOCK;
+
+			switch (ins.op) {
+				case Op::CONST:
+					std::fill(top, top + n, p.constants[ins.arg]);
+					break;
+				case Op::VAR:
+					std::memcpy(top, columns[ins.arg] + start, n * sizeof(DecimalData));
+					break;
+				case Op::ADD:
+					decimal_simd::add(a, b, a, n);
+					break;
+				case Op::SUB:
+					decimal_simd::sub(a, b, a, n);
+					break;
+				case Op::MUL:
+					decimal_simd::mul(a, b, a, n);
+					break;
+				case Op::MUL_ADD:
+					decimal_simd::mul(a, b, a, n);
+					decimal_simd::add(a, c, a, n);
+					break;
+				case Op::POW_NUM: {
+					const auto num = p.numbers[ins.arg];
+					for (int64_t i = 0; i < n; i++) {
+						a[i] = decimal_core::pow_num(a[i], num);
+					}
+					break;
+				}
+				default:
+					for (int64_t i = 0; i < n; i++) {
+						a[i] = apply(ins.op, a[i], b[i], c[i], 0.0);
+					}
+					break;
+			}
+
+			top += (1 - args) * BLOCK;
+		}
+
+		std::memcpy(out + start, stack.data(), n * sizeof(DecimalData));
+	}
+}
+
+} // namespace decimal_formula
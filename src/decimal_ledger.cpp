@@ -0,0 +1,260 @@
+#include "decimal_ledger.hpp"
+#include "decimal_core.hpp"
+#include "decimal_simd.hpp"
+#include "godot_cpp/core/error_macros.hpp"
+#include "godot_cpp/core/object.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <godot_cpp/core/class_db.hpp>
+
+using namespace godot;
+
+namespace core = decimal_core;
+
+auto DecimalLedger::_bind_methods() -> void {
+	ClassDB::bind_method(D_METHOD("add_entry", "name", "amount", "rate"), &DecimalLedger::add_entry, DEFVAL(Vector4i()), DEFVAL(Vector4i()));
+	ClassDB::bind_method(D_METHOD("find", "name"), &DecimalLedger::find);
+	ClassDB::bind_method(D_METHOD("has", "name"), &DecimalLedger::has);
+	ClassDB::bind_method(D_METHOD("get_entry_name", "idx"), &DecimalLedger::get_entry_name);
+
+	ClassDB::bind_method(D_METHOD("size"), &DecimalLedger::size);
+	ClassDB::bind_method(D_METHOD("clear"), &DecimalLedger::clear);
+
+	ClassDB::bind_method(D_METHOD("get_amount", "idx"), &DecimalLedger::get_amount);
+	ClassDB::bind_method(D_METHOD("set_amount", "idx", "amount"), &DecimalLedger::set_amount);
+	ClassDB::bind_method(D_METHOD("get_rate", "idx"), &DecimalLedger::get_rate);
+	ClassDB::bind_method(D_METHOD("set_rate", "idx", "rate"), &DecimalLedger::set_rate);
+
+	ClassDB::bind_method(D_METHOD("get_amount_named", "name"), &DecimalLedger::get_amount_named);
+	ClassDB::bind_method(D_METHOD("set_amount_named", "name", "amount"), &DecimalLedger::set_amount_named);
+	ClassDB::bind_method(D_METHOD("get_rate_named", "name"), &DecimalLedger::get_rate_named);
+	ClassDB::bind_method(D_METHOD("set_rate_named", "name", "rate"), &DecimalLedger::set_rate_named);
+
+	ClassDB::bind_method(D_METHOD("set_min", "idx", "min"), &DecimalLedger::set_min);
+	ClassDB::bind_method(D_METHOD("set_max", "idx", "max"), &DecimalLedger::set_max);
+	ClassDB::bind_method(D_METHOD("clear_min", "idx"), &DecimalLedger::clear_min);
+	ClassDB::bind_method(D_METHOD("clear_max", "idx"), &DecimalLedger::clear_max);
+
+	ClassDB::bind_method(D_METHOD("advance", "delta"), &DecimalLedger::advance);
+
+	ClassDB::bind_method(D_METHOD("get_amounts", "out"), &DecimalLedger::get_amounts);
+	ClassDB::bind_method(D_METHOD("get_rates", "out"), &DecimalLedger::get_rates);
+	ClassDB::bind_method(D_METHOD("set_amounts", "values"), &DecimalLedger::set_amounts);
+	ClassDB::bind_method(D_METHOD("set_rates", "values"), &DecimalLedger::set_rates);
+}
+
+auto DecimalLedger::index_of(const char *fn, const StringName &name) const -> int64_t {
+	const auto *idx = name_to_index.getptr(name);
+	ERR_FAIL_NULL_V_MSG(idx, -1, String("DecimalLedger.") + fn + "() - no entry named \"" + String(name) + "\".");
+	return *idx;
+}
+
+auto DecimalLedger::add_entry(const StringName &name, const Vector4i amount, const Vector4i rate) -> int64_t {
+	ERR_FAIL_COND_V_MSG(name_to_index.has(name), -1, "DecimalLedger.add_entry() - there's already an entry named \"" + String(name) + "\".");
+
+	const auto idx = size();
+	amounts.push_back(to_decimal(amount));
+	rates.push_back(to_decimal(rate));
+	cap_min.push_back(core::DECIMAL_ZERO);
+	cap_max.push_back(core::DECIMAL_ZERO);
+	cap_flags.push_back(0);
+	names.push_back(name);
+	name_to_index.insert(name, idx);
+	return idx;
+}
+
+auto DecimalLedger::find(const StringName &name) const -> int64_t {
+	const auto *idx = name_to_index.getptr(name);
+	return idx ? *idx : -1;
+}
+
+auto DecimalLedger::has(const StringName &name) const -> bool {
+	return name_to_index.has(name);
+}
+
+auto DecimalLedger::get_entry_name(const int64_t idx) const -> StringName {
+	ERR_FAIL_INDEX_V_MSG(idx, size(), StringName(), "DecimalLedger.get_entry_name() - index out of bounds.");
+	return names[idx];
+}
+
+auto DecimalLedger::size() const -> int64_t {
+	return static_cast<int64_t>(amounts.size());
+}
+
+auto DecimalLedger::clear() -> void {
+	amounts.clear();
+	rates.clear();
+	cap_min.clear();
+	cap_max.clear();
+	cap_flags.clear();
+	capped.clear();
+	names.clear();
+	name_to_index.clear();
+}
+
+auto DecimalLedger::get_amount(const int64_t idx) const -> Vector4i {
+	ERR_FAIL_INDEX_V_MSG(idx, size(), Vector4i(), "DecimalLedger.get_amount() - index out of bounds.");
+	return to_vector4i(amounts[idx]);
+}
+
+auto DecimalLedger::set_amount(const int64_t idx, const Vector4i amount) -> void {
+	ERR_FAIL_INDEX_MSG(idx, size(), "DecimalLedger.set_amount() - index out of bounds.");
+	amounts[idx] = to_decimal(amount);
+}
+
+auto DecimalLedger::get_rate(const int64_t idx) const -> Vector4i {
+	ERR_FAIL_INDEX_V_MSG(idx, size(), Vector4i(), "DecimalLedger.get_rate() - index out of bounds.");
+	return to_vector4i(rates[idx]);
+}
+
+auto DecimalLedger::set_rate(const int64_t idx, const Vector4i rate) -> void {
+	ERR_FAIL_INDEX_MSG(idx, size(), "DecimalLedger.set_rate() - index out of bounds.");
+	rates[idx] = to_decimal(rate);
+}
+
+auto DecimalLedger::get_amount_named(const StringName &name) const -> Vector4i {
+	const auto idx = index_of("get_amount_named", name);
+	if (idx < 0) return Vector4i();
+	return to_vector4i(amounts[idx]);
+}
+
+auto DecimalLedger::set_amount_named(const StringName &name, const Vector4i amount) -> void {
+	const auto idx = index_of("set_amount_named", name);
+	if (idx < 0) return;
+	amounts[idx] = to_decimal(amount);
+}
+
+auto DecimalLedger::get_rate_named(const StringName &name) const -> Vector4i {
+	const auto idx = index_of("get_rate_named", name);
+	if (idx < 0) return Vector4i();
+	return to_vector4i(rates[idx]);
+}
+
+auto DecimalLedger::set_rate_named(const StringName &name, const Vector4i rate) -> void {
+	const auto idx = index_of("set_rate_named", name);
+	if (idx < 0) return;
+	rates[idx] = to_decimal(rate);
+}
+
+auto DecimalLedger::set_cap_flag(const int64_t idx, const uint8_t flag, const bool enabled) -> void {
+	const auto was_capped = cap_flags[idx] != 0;
+	cap_flags[idx] = enabled ? (cap_flags[idx] | flag) : (cap_flags[idx] & ~flag);
+	const auto is_capped = cap_flags[idx] != 0;
+
+	if (is_capped && !was_capped) {
+		capped.push_back(idx);
+	} else if (was_capped && !is_capped) {
+		// order doesn't matter, caps are applied to each entry on its own
+		auto it = std::find(capped.begin(), capped.end(), idx);
+		*it = capped.back();
+		capped.pop_back();
+	}
+}
+
+auto DecimalLedger::set_min(const int64_t idx, const Vector4i min) -> void {
+	ERR_FAIL_INDEX_MSG(idx, size(), "DecimalLedger.set_min() - index out of bounds.");
+	const auto lo = to_decimal(min);
+	ERR_FAIL_COND_MSG((cap_flags[idx] & CAP_MAX) && core::gt(lo, cap_max[idx]),
+		"DecimalLedger.set_min() - `min` cannot be greater than the entry's max."
+	);
+
+	cap_min[idx] = lo;
+	set_cap_flag(idx, CAP_MIN, true);
+}
+
+auto DecimalLedger::set_max(const int64_t idx, const Vector4i max) -> void {
+	ERR_FAIL_INDEX_MSG(idx, size(), "DecimalLedger.set_max() - index out of bounds.");
+	const auto hi = to_decimal(max);
+	ERR_FAIL_COND_MSG((cap_flags[idx] & CAP_MIN) && core::lt(hi, cap_min[idx]),
+		"DecimalLedger.set_max() - `max` cannot be less than the entry's min."
+	);
+
+	cap_max[idx] = hi;
+	set_cap_flag(idx, CAP_MAX, true);
+}
+
+auto DecimalLedger::clear_min(const int64_t idx) -> void {
+	ERR_FAIL_INDEX_MSG(idx, size(), "DecimalLedger.clear_min() - index out of bounds.");
+	set_cap_flag(idx, CAP_MIN, false);
+}
+
+auto DecimalLedger::clear_max(const int64_t idx) -> void {
+	ERR_FAIL_INDEX_MSG(idx, size(), "DecimalLedger.clear_max() - index out of bounds.");
+	set_cap_flag(idx, CAP_MAX, false);
+}
+
+auto DecimalLedger::advance(const double delta) -> void {
+	const auto n = size();
+	auto *amount = amounts.data();
+	const auto *rate = rates.data();
+
+	DecimalData scratch[ADVANCE_BLOCK];
+	for (int64_t start = 0; start < n; start += ADVANCE_BLOCK) {
+		const auto count = std::min(ADVANCE_BLOCK, n - start);
+		decimal_simd::mul_num(rate + start, delta, scratch, count);
+		decimal_simd::add(amount + start, scratch, amount + start, count);
+	}
+
+	for (const auto idx : capped) {
+		auto value = amount[idx];
+		if ((cap_flags[idx] & CAP_MIN) && core::lt(value, cap_min[idx])) {
+			value = cap_min[idx];
+		}
+		if ((cap_flags[idx] & CAP_MAX) && core::gt(value, cap_max[idx])) {
+			value = cap_max[idx];
+		}
+		amount[idx] = value;
+	}
+}
+
+static auto copy_out(const char *fn, const std::vector<DecimalData> &src, const Ref<DecimalArray> &out) -> void {
+	ERR_FAIL_COND_MSG(out.is_null(), String("DecimalLedger.") + fn + "() - `out` cannot be null.");
+
+	const auto n = static_cast<int64_t>(src.size());
+	if (out->size() != n) {
+		out->resize(n);
+	}
+	if (n > 0) {
+		memcpy(out->ptrw(), src.data(), n * sizeof(DecimalData));
+	}
+}
+
+static auto copy_in(const char *fn, std::vector<DecimalData> &dst, const Ref<DecimalArray> &values) -> void {
+	ERR_FAIL_COND_MSG(values.is_null(), String("DecimalLedger.") + fn + "() - `values` cannot be null.");
+	ERR_FAIL_COND_MSG(values->size() != static_cast<int64_t>(dst.size()),
+		String("DecimalLedger.") + fn + "() - size mismatch (" + String::num_int64(values->size()) + " vs " + String::num_int64(dst.size()) + ")."
+	);
+
+	if (!dst.empty()) {
+		memcpy(dst.data(), values->ptr(), dst.size() * sizeof(DecimalData));
+	}
+}
+
+auto DecimalLedger::get_amounts(const Ref<DecimalArray> &out) const -> void {
+	copy_out("get_amounts", amounts, out);
+}
+
+auto DecimalLedger::get_rates(const Ref<DecimalArray> &out) const -> void {
+	copy_out("get_rates", rates, out);
+}
+
+auto DecimalLedger::set_amounts(const Ref<DecimalArray> &values) -> void {
+	copy_in("set_amounts", amounts, values);
+}
+
+auto DecimalLedger::set_rates(const Ref<DecimalArray> &values) -> void {
+	copy_in("set_rates", rates, values);
+}
+
+auto DecimalLedger::amounts_ptr() const -> const DecimalData * {
+	return amounts.data();
+}
+
+auto DecimalLedger::rates_ptr() const -> const DecimalData * {
+	return rates.data();
+}
+
+auto DecimalLedger::rates_ptrw() -> DecimalData * {
+	return rates.data();
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "godot_cpp/classes/ref_counted.hpp"
+#include "godot_cpp/templates/hash_map.hpp"
+#include "godot_cpp/variant/string_name.hpp"
+#include "godot_cpp/variant/vector4i.hpp"
+
+#include "decimal_array.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace godot;
+
+// A fixed set of named resources, each with an amount and a per-second rate.
+//
+// This is the usual idle game tick: `amount += rate * delta` for every
+// resource, every frame. Done from GDScript that's two calls into the
+// extension per resource plus the Vector4i round trips, while here it's one
+// call for all of them. Amounts and rates sit in their own contiguous arrays,
+// so advance() streams through both with the batch kernels from
+// decimal_simd.hpp. Caps are kept apart from the hot data, along with a list of
+// the entries that have any, so uncapped ledgers never touch them.
+class DecimalLedger : public RefCounted {
+
+	GDCLASS(DecimalLedger, RefCounted)
+
+protected:
+	static auto _bind_methods() -> void;
+
+private:
+	enum CapFlags : uint8_t {
+		CAP_MIN = 1 << 0,
+		CAP_MAX = 1 << 1,
+	};
+
+	// hot, touched by every advance()
+	std::vector<DecimalData> amounts;
+	std::vector<DecimalData> rates;
+
+	// cold, only looked at for the entries in `capped`
+	std::vector<DecimalData> cap_min;
+	std::vector<DecimalData> cap_max;
+	std::vector<uint8_t> cap_flags;
+	std::vector<int64_t> capped;
+
+	std::vector<StringName> names;
+	HashMap<StringName, int64_t> name_to_index;
+
+	auto index_of(const char *fn, const StringName &name) const -> int64_t;
+	auto set_cap_flag(const int64_t idx, const uint8_t flag, const bool enabled) -> void;
+
+public:
+	// advance() works through this many entries at a time, so the rate * delta
+	// scratch stays in L1 between the two passes
+	static constexpr const int64_t ADVANCE_BLOCK = 256;
+
+	auto add_entry(const StringName &name, const Vector4i amount, const Vector4i rate) -> int64_t;
+	auto find(const StringName &name) const -> int64_t;
+	auto has(const StringName &name) const -> bool;
+	auto get_entry_name(const int64_t idx) const -> StringName;
+
+	auto size() const -> int64_t;
+	auto clear() -> void;
+
+	auto get_amount(const int64_t idx) const -> Vector4i;
+	auto set_amount(const int64_t idx, const Vector4i amount) -> void;
+	auto get_rate(const int64_t idx) const -> Vector4i;
+	auto set_rate(const int64_t idx, const Vector4i rate) -> void;
+
+	auto get_amount_named(const StringName &name) const -> Vector4i;
+	auto set_amount_named(const StringName &name, const Vector4i amount) -> void;
+	auto get_rate_named(const StringName &name) const -> Vector4i;
+	auto set_rate_named(const StringName &name, const Vector4i rate) -> void;
+
+	auto set_min(const int64_t idx, const Vector4i min) -> void;
+	auto set_max(const int64_t idx, const Vector4i max) -> void;
+	auto clear_min(const int64_t idx) -> void;
+	auto clear_max(const int64_t idx) -> void;
+
+	auto advance(const double delta) -> void;
+
+	// whole-array copies, for drawing or saving everything at once
+	auto get_amounts(const Ref<DecimalArray> &out) const -> void;
+	auto get_rates(const Ref<DecimalArray> &out) const -> void;
+	auto set_amounts(const Ref<DecimalArray> &values) -> void;
+	auto set_rates(const Ref<DecimalArray> &values) -> void;
+
+	// direct access for the C++ side, these don't do any bounds checks
+	auto amounts_ptr() const -> const DecimalData *;
+	auto rates_ptr() const -> const DecimalData *;
+	auto rates_ptrw() -> DecimalData *;
+};
@@ -0,0 +1,280 @@
+#pragma once
+
+// Closed-form offline progress. Given every resource's amount, its own rate
+// (constant, polynomial or exponential in time) and which other resources
+// produce it (generator tiers), computes all amounts after T seconds without
+// stepping through time, so the result doesn't depend on any step size.
+//
+// Every amount is a sum of t^m terms and of E(λ, k, t) terms, the k-fold
+// integrals of e^(λt) from 0 (E(λ, 0, t) = e^(λt)). Integrating either kind
+// only shifts its coefficient up by one power, so going through the resources
+// in dependency order, each one's amount is its initial value plus the shifted
+// coefficients of its own rate and of its producers. That's exact as long as
+// producers don't form a cycle, which is checked when they are added.
+//
+// Like decimal_core.hpp, nothing in here reports errors. The binding layer is
+// expected to reject cycles and invalid growth factors before calling in.
+
+#include "decimal_core.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace decimal_offline {
+
+enum class RateKind : uint8_t {
+	CONSTANT,     // coefficients[0]
+	POLYNOMIAL,   // sum of coefficients[m] * t^m
+	EXPONENTIAL,  // coefficients[0] * growth^t
+};
+
+// `per_unit` of the target is made per second for every unit of `source`
+struct Feed {
+	int64_t source;
+	DecimalData per_unit;
+};
+
+struct Resource {
+	DecimalData amount;
+
+	RateKind kind = RateKind::CONSTANT;
+	std::vector<DecimalData> coefficients;
+	double growth = 1.0;
+
+	std::vector<Feed> feeds;
+};
+
+// Scratch space for simulate(), so repeated calls don't allocate.
+struct Workspace {
+	std::vector<int64_t> order;
+	std::vector<int64_t> poly_degree;
+	std::vector<int64_t> exp_degree;
+	std::vector<double> lambdas;
+	std::vector<int64_t> lambda_of;
+
+	// per resource: `poly_size` t^m coefficients, then `lambdas.size()` rows
+	// of `exp_size` E(λ, k) coefficients
+	std::vector<DecimalData> coefficients;
+	std::vector<DecimalData> exp_values;
+};
+
+// true if `to` is `from` or (indirectly) produces it
+inline auto produces(const std::vector<Resource> &resources, const int64_t from, const int64_t to) -> bool {
+	if (from == to) return true;
+
+	std::vector<int64_t> stack { to };
+	std::vector<bool> seen(resources.size(), false);
+	while (!stack.empty()) {
+		const auto idx = stack.back();
+		stack.pop_back();
+
+		for (const auto &feed : resources[idx].feeds) {
+			if (feed.source == from) return true;
+			if (!seen[feed.source]) {
+				seen[feed.source] = true;
+				stack.push_back(feed.source);
+			}
+		}
+	}
+	return false;
+}
+
+// producers before the resources they feed, assumes there are no cycles
+inline auto dependency_order(const std::vector<Resource> &resources, std::vector<int64_t> &order) -> void {
+	const auto n = static_cast<int64_t>(resources.size());
+	order.clear();
+
+	// 0 = not visited, 1 = on the stack, 2 = done
+	std::vector<uint8_t> state(n, 0);
+	std::vector<std::pair<int64_t, size_t>> stack;
+	for (int64_t root = 0; root < n; root++) {
+		if (state[root] != 0) continue;
+
+		stack.emplace_back(root, 0);
+		state[root] = 1;
+		while (!stack.empty()) {
+			auto &[idx, next] = stack.back();
+			const auto &feeds = resources[idx].feeds;
+			if (next < feeds.size()) {
+				const auto source = feeds[next++].source;
+				if (state[source] == 0) {
+					state[source] = 1;
+					stack.emplace_back(source, 0);
+				}
+			} else {
+				state[idx] = 2;
+				order.push_back(idx);
+				stack.pop_back();
+			}
+		}
+	}
+}
+
+// e^z for any finite z, as a decimal so it doesn't overflow
+inline auto exp_decimal(const double z) -> DecimalData {
+	const auto exp10 = z * 0.43429448190325182765;
+	if (DECIMAL_UNLIKELY(exp10 >= 9.0e18)) return decimal_core::DECIMAL_INF;
+	if (DECIMAL_UNLIKELY(exp10 <= -9.0e18)) return decimal_core::DECIMAL_ZERO;
+	return decimal_core::pow10_num(exp10);
+}
+
+// core::add(), but a zero on either side doesn't cost any precision. A zero
+// has exponent 0, so core::add() would round the other term at 1e-14 (or drop
+// it entirely), and the coefficients of deep producer chains are tiny.
+inline auto add_term(const DecimalData &sum, const DecimalData &term) -> DecimalData {
+	if (sum.mantissa == 0) return term;
+	if (term.mantissa == 0) return sum;
+	return decimal_core::add(sum, term);
+}
+
+// Fills out[k] = E(λ, k, t) for k in [0, count).
+//
+// E(k) = t^k / k! + λ E(k + 1), which is stepped forwards while |λt| > k + 1
+// (there the subtraction can't cancel much). Past that, the series
+// E(k) = t^k / k! * sum_j (λt)^j k! / (j + k)! converges fast and is used
+// instead, in doubles, as it's scaled by t^k / k! afterwards.
+inline auto exp_integrals(const double lambda, const double t, DecimalData *out, const int64_t count) -> void {
+	namespace core = decimal_core;
+
+	const auto z = lambda * t;
+	const auto t_dec = core::from_float(t);
+
+	out[0] = exp_decimal(z);
+	auto power = core::DECIMAL_ONE; // t^k / k!
+	for (int64_t k = 0; k + 1 < count; k++) {
+		const auto next_power = core::mul_num(core::mul(power, t_dec), 1.0 / static_cast<double>(k + 1));
+
+		if (std::abs(z) > static_cast<double>(k + 1)) {
+			out[k + 1] = core::mul_num(core::sub(out[k], power), 1.0 / lambda);
+		} else {
+			auto sum = 1.0;
+			auto term = 1.0;
+			for (int64_t j = 1; j < 1000; j++) {
+				term *= z / static_cast<double>(k + 1 + j);
+				sum += term;
+				if (std::abs(term) <= std::abs(sum) * 1e-17) break;
+			}
+			out[k + 1] = core::mul_num(next_power, sum);
+		}
+		power = next_power;
+	}
+}
+
+// Writes every amount after `seconds` into `out`. Producers must not form a
+// cycle and exponential growth factors must be positive.
+inline auto simulate(const std::vector<Resource> &resources, const double seconds, DecimalData *out, Workspace &ws) -> void {
+	namespace core = decimal_core;
+
+	const auto n = static_cast<int64_t>(resources.size());
+	if (n == 0) return;
+
+	// exponential rates with their own λ = ln(growth); growth = 1 is just constant
+	ws.lambdas.clear();
+	ws.lambda_of.assign(n, -1);
+	for (int64_t i = 0; i < n; i++) {
+		const auto &res = resources[i];
+		if (res.kind != RateKind::EXPONENTIAL || res.growth == 1.0) continue;
+
+		const auto lambda = std::log(res.growth);
+		const auto it = std::find(ws.lambdas.begin(), ws.lambdas.end(), lambda);
+		ws.lambda_of[i] = static_cast<int64_t>(it - ws.lambdas.begin());
+		if (it == ws.lambdas.end()) {
+			ws.lambdas.push_back(lambda);
+		}
+	}
+
+	// highest power each resource can end up with, to size the coefficients
+	dependency_order(resources, ws.order);
+	ws.poly_degree.assign(n, 0);
+	ws.exp_degree.assign(n, 0);
+	for (const auto idx : ws.order) {
+		const auto &res = resources[idx];
+		auto poly = res.kind == RateKind::POLYNOMIAL ? static_cast<int64_t>(res.coefficients.size()) : int64_t(1);
+		auto exp = ws.lambda_of[idx] >= 0 ? int64_t(1) : int64_t(0);
+		for (const auto &feed : res.feeds) {
+			poly = std::max(poly, ws.poly_degree[feed.source] + 1);
+			exp = std::max(exp, ws.exp_degree[feed.source] + (ws.exp_degree[feed.source] > 0 ? 1 : 0));
+		}
+		ws.poly_degree[idx] = poly;
+		ws.exp_degree[idx] = exp;
+	}
+
+	const auto poly_size = *std::max_element(ws.poly_degree.begin(), ws.poly_degree.end()) + 1;
+	const auto exp_size = *std::max_element(ws.exp_degree.begin(), ws.exp_degree.end()) + 1;
+	const auto lambda_count = static_cast<int64_t>(ws.lambdas.size());
+	const auto stride = poly_size + lambda_count * exp_size;
+
+	ws.coefficients.assign(n * stride, core::DECIMAL_ZERO);
+	const auto poly_of = [&](const int64_t idx) { return ws.coefficients.data() + idx * stride; };
+	const auto exp_of = [&](const int64_t idx, const int64_t l) { return poly_of(idx) + poly_size + l * exp_size; };
+
+	for (const auto idx : ws.order) {
+		const auto &res = resources[idx];
+		auto *poly = poly_of(idx);
+
+		poly[0] = res.amount;
+
+		// the integral of the resource's own rate
+		const auto &c = res.coefficients;
+		if (!c.empty()) {
+			if (res.kind == RateKind::POLYNOMIAL) {
+				for (size_t m = 0; m < c.size(); m++) {
+					poly[m + 1] = core::mul_num(c[m], 1.0 / static_cast<double>(m + 1));
+				}
+			} else if (ws.lambda_of[idx] >= 0) {
+				exp_of(idx, ws.lambda_of[idx])[1] = c[0];
+			} else {
+				poly[1] = c[0];
+			}
+		}
+
+		// and of every producer's amount, times how much each unit makes
+		for (const auto &feed : res.feeds) {
+			const auto *src = poly_of(feed.source);
+			for (int64_t m = 0; m <= ws.poly_degree[feed.source]; m++) {
+				if (src[m].mantissa == 0) continue;
+				const auto term = core::mul_num(core::mul(src[m], feed.per_unit), 1.0 / static_cast<double>(m + 1));
+				poly[m + 1] = add_term(poly[m + 1], term);
+			}
+
+			for (int64_t l = 0; l < lambda_count; l++) {
+				const auto *src_exp = exp_of(feed.source, l);
+				auto *dst_exp = exp_of(idx, l);
+				for (int64_t k = 0; k + 1 < exp_size; k++) {
+					if (src_exp[k].mantissa == 0) continue;
+					dst_exp[k + 1] = add_term(dst_exp[k + 1], core::mul(src_exp[k], feed.per_unit));
+				}
+			}
+		}
+	}
+
+	ws.exp_values.resize(lambda_count * exp_size);
+	for (int64_t l = 0; l < lambda_count; l++) {
+		exp_integrals(ws.lambdas[l], seconds, ws.exp_values.data() + l * exp_size, exp_size);
+	}
+
+	const auto t = core::from_float(seconds);
+	for (int64_t idx = 0; idx < n; idx++) {
+		const auto *poly = poly_of(idx);
+
+		auto sum = poly[ws.poly_degree[idx]];
+		for (auto m = ws.poly_degree[idx] - 1; m >= 0; m--) {
+			sum = add_term(core::mul(sum, t), poly[m]);
+		}
+
+		for (int64_t l = 0; l < lambda_count; l++) {
+			const auto *coef = exp_of(idx, l);
+			const auto *values = ws.exp_values.data() + l * exp_size;
+			for (int64_t k = 1; k <= ws.exp_degree[idx]; k++) {
+				if (coef[k].mantissa == 0) continue;
+				sum = add_term(sum, core::mul(coef[k], values[k]));
+			}
+		}
+
+		out[idx] = sum;
+	}
+}
+
+} // namespace decimal_offline
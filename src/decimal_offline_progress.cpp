@@ -0,0 +1,118 @@
+#include "decimal_offline_progress.hpp"
+#include "godot_cpp/core/error_macros.hpp"
+#include "godot_cpp/core/object.hpp"
+#include <cmath>
+#include <cstdint>
+#include <godot_cpp/core/class_db.hpp>
+
+using namespace godot;
+
+using decimal_offline::RateKind;
+
+auto DecimalOfflineProgress::_bind_methods() -> void {
+	ClassDB::bind_method(D_METHOD("add_resource", "name", "amount"), &DecimalOfflineProgress::add_resource, DEFVAL(Vector4i()));
+	ClassDB::bind_method(D_METHOD("find", "name"), &DecimalOfflineProgress::find);
+	ClassDB::bind_method(D_METHOD("size"), &DecimalOfflineProgress::size);
+	ClassDB::bind_method(D_METHOD("clear"), &DecimalOfflineProgress::clear);
+
+	ClassDB::bind_method(D_METHOD("get_amount", "idx"), &DecimalOfflineProgress::get_amount);
+	ClassDB::bind_method(D_METHOD("set_amount", "idx", "amount"), &DecimalOfflineProgress::set_amount);
+
+	ClassDB::bind_method(D_METHOD("set_constant_rate", "idx", "rate"), &DecimalOfflineProgress::set_constant_rate);
+	ClassDB::bind_method(D_METHOD("set_polynomial_rate", "idx", "coefficients"), &DecimalOfflineProgress::set_polynomial_rate);
+	ClassDB::bind_method(D_METHOD("set_exponential_rate", "idx", "rate", "growth"), &DecimalOfflineProgress::set_exponential_rate);
+
+	ClassDB::bind_method(D_METHOD("add_producer", "idx", "source", "per_unit"), &DecimalOfflineProgress::add_producer);
+	ClassDB::bind_method(D_METHOD("clear_producers", "idx"), &DecimalOfflineProgress::clear_producers);
+
+	ClassDB::bind_method(D_METHOD("simulate", "seconds", "out"), &DecimalOfflineProgress::simulate);
+}
+
+auto DecimalOfflineProgress::add_resource(const StringName &name, const Vector4i amount) -> int64_t {
+	ERR_FAIL_COND_V_MSG(name_to_index.has(name), -1, "DecimalOfflineProgress.add_resource() - there's already a resource named \"" + String(name) + "\".");
+
+	const auto idx = size();
+	decimal_offline::Resource res;
+	res.amount = to_decimal(amount);
+	resources.push_back(res);
+	name_to_index.insert(name, idx);
+	return idx;
+}
+
+auto DecimalOfflineProgress::find(const StringName &name) const -> int64_t {
+	const auto *idx = name_to_index.getptr(name);
+	return idx ? *idx : -1;
+}
+
+auto DecimalOfflineProgress::size() const -> int64_t {
+	return static_cast<int64_t>(resources.size());
+}
+
+auto DecimalOfflineProgress::clear() -> void {
+	resources.clear();
+	name_to_index.clear();
+}
+
+auto DecimalOfflineProgress::get_amount(const int64_t idx) const -> Vector4i {
+	ERR_FAIL_INDEX_V_MSG(idx, size(), Vector4i(), "DecimalOfflineProgress.get_amount() - index out of bounds.");
+	return to_vector4i(resources[idx].amount);
+}
+
+auto DecimalOfflineProgress::set_amount(const int64_t idx, const Vector4i amount) -> void {
+	ERR_FAIL_INDEX_MSG(idx, size(), "DecimalOfflineProgress.set_amount() - index out of bounds.");
+	resources[idx].amount = to_decimal(amount);
+}
+
+auto DecimalOfflineProgress::set_constant_rate(const int64_t idx, const Vector4i rate) -> void {
+	ERR_FAIL_INDEX_MSG(idx, size(), "DecimalOfflineProgress.set_constant_rate() - index out of bounds.");
+
+	auto &res = resources[idx];
+	res.kind = RateKind::CONSTANT;
+	res.coefficients.assign(1, to_decimal(rate));
+	res.growth = 1.0;
+}
+
+auto DecimalOfflineProgress::set_polynomial_rate(const int64_t idx, const Ref<DecimalArray> &coefficients) -> void {
+	ERR_FAIL_INDEX_MSG(idx, size(), "DecimalOfflineProgress.set_polynomial_rate() - index out of bounds.");
+	ERR_FAIL_COND_MSG(coefficients.is_null(), "DecimalOfflineProgress.set_polynomial_rate() - `coefficients` cannot be null.");
+
+	auto &res = resources[idx];
+	res.kind = RateKind::POLYNOMIAL;
+	res.coefficients.assign(coefficients->ptr(), coefficients->ptr() + coefficients->size());
+	res.growth = 1.0;
+}
+
+auto DecimalOfflineProgress::set_exponential_rate(const int64_t idx, const Vector4i rate, const double growth) -> void {
+	ERR_FAIL_INDEX_MSG(idx, size(), "DecimalOfflineProgress.set_exponential_rate() - index out of bounds.");
+	ERR_FAIL_COND_MSG(!(growth > 0.0) || !std::isfinite(growth), "DecimalOfflineProgress.set_exponential_rate() - `growth` has to be positive.");
+
+	auto &res = resources[idx];
+	res.kind = RateKind::EXPONENTIAL;
+	res.coefficients.assign(1, to_decimal(rate));
+	res.growth = growth;
+}
+
+auto DecimalOfflineProgress::add_producer(const int64_t idx, const int64_t source, const Vector4i per_unit) -> void {
+	ERR_FAIL_INDEX_MSG(idx, size(), "DecimalOfflineProgress.add_producer() - index out of bounds.");
+	ERR_FAIL_INDEX_MSG(source, size(), "DecimalOfflineProgress.add_producer() - `source` out of bounds.");
+	ERR_FAIL_COND_MSG(decimal_offline::produces(resources, idx, source),
+		"DecimalOfflineProgress.add_producer() - resource " + String::num_int64(idx) + " already produces " + String::num_int64(source) + ", producers cannot form a cycle."
+	);
+
+	resources[idx].feeds.push_back({ source, to_decimal(per_unit) });
+}
+
+auto DecimalOfflineProgress::clear_producers(const int64_t idx) -> void {
+	ERR_FAIL_INDEX_MSG(idx, size(), "DecimalOfflineProgress.clear_producers() - index out of bounds.");
+	resources[idx].feeds.clear();
+}
+
+auto DecimalOfflineProgress::simulate(const double seconds, const Ref<DecimalArray> &out) -> void {
+	ERR_FAIL_COND_MSG(out.is_null(), "DecimalOfflineProgress.simulate() - `out` cannot be null.");
+	ERR_FAIL_COND_MSG(!(seconds >= 0.0) || !std::isfinite(seconds), "DecimalOfflineProgress.simulate() - `seconds` has to be a finite, non-negative number.");
+
+	if (out->size() != size()) {
+		out->resize(size());
+	}
+	decimal_offline::simulate(resources, seconds, out->ptrw(), workspace);
+}
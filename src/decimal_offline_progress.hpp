@@ -0,0 +1,48 @@
+#pragma once
+
+#include "godot_cpp/classes/ref_counted.hpp"
+#include "godot_cpp/templates/hash_map.hpp"
+#include "godot_cpp/variant/string_name.hpp"
+#include "godot_cpp/variant/vector4i.hpp"
+
+#include "decimal_array.hpp"
+#include "decimal_offline.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace godot;
+
+// Computes where every resource ends up after some time away, in closed form
+// (see decimal_offline.hpp). Resources are set up once, like a DecimalLedger,
+// and simulate() can then be called for any duration without touching them.
+class DecimalOfflineProgress : public RefCounted {
+
+	GDCLASS(DecimalOfflineProgress, RefCounted)
+
+protected:
+	static auto _bind_methods() -> void;
+
+private:
+	std::vector<decimal_offline::Resource> resources;
+	HashMap<StringName, int64_t> name_to_index;
+	decimal_offline::Workspace workspace;
+
+public:
+	auto add_resource(const StringName &name, const Vector4i amount) -> int64_t;
+	auto find(const StringName &name) const -> int64_t;
+	auto size() const -> int64_t;
+	auto clear() -> void;
+
+	auto get_amount(const int64_t idx) const -> Vector4i;
+	auto set_amount(const int64_t idx, const Vector4i amount) -> void;
+
+	auto set_constant_rate(const int64_t idx, const Vector4i rate) -> void;
+	auto set_polynomial_rate(const int64_t idx, const Ref<DecimalArray> &coefficients) -> void;
+	auto set_exponential_rate(const int64_t idx, const Vector4i rate, const double growth) -> void;
+
+	auto add_producer(const int64_t idx, const int64_t source, const Vector4i per_unit) -> void;
+	auto clear_producers(const int64_t idx) -> void;
+
+	auto simulate(const double seconds, const Ref<DecimalArray> &out) -> void;
+};
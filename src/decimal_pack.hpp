@@ -0,0 +1,305 @@
+#pragma once
+
+// Binary serialization for arrays of decimals, without any Godot dependency.
+//
+// Layout (version 1), everything little-endian:
+//
+//   offset  size  field
+//   0       4     magic, the ASCII bytes "DECM"
+//   4       1     version, currently 1
+//   5       1     encoding, 0 = raw, 1 = compact
+//   6       2     reserved, always 0
+//   8       8     element count, uint64
+//   16      ...   payload
+//
+// Raw payload: `count` elements of 16 bytes, an IEEE 754 double mantissa
+// followed by an int64 exponent. That's exactly DecimalData on every
+// little-endian platform, so loading it is a single memcpy. The header is 16
+// bytes too, so the payload stays 16-byte aligned relative to the buffer.
+//
+// Compact payload, per element:
+// - one control byte: the high nibble is how many of the top bytes, the low
+//   nibble how many of the bottom bytes of (mantissa bits XOR the previous
+//   mantissa bits) are zero
+// - the remaining bytes of that XOR, lowest first
+// - the exponent minus the previous exponent, zigzagged into an unsigned
+//   LEB128 varint
+// The "previous" element starts out as 0 mantissa bits and a 0 exponent.
+// Neighbouring values that share their top mantissa bits (sorted data, time
+// series) or round values with trailing zero bits take a lot fewer than 16
+// bytes, and small exponents take a single byte.
+
+#include "decimal_core.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+namespace decimal_pack {
+
+constexpr const uint8_t MAGIC[4] = { 'D', 'E', 'C', 'M' };
+constexpr const uint8_t VERSION = 1;
+constexpr const int64_t HEADER_SIZE = 16;
+constexpr const int64_t RAW_ELEMENT_SIZE = 16;
+
+// control byte + 8 mantissa bytes + 10 varint bytes
+constexpr const int64_t COMPACT_ELEMENT_MAX = 19;
+
+enum class Encoding : uint8_t {
+	RAW = 0,
+	COMPACT = 1,
+};
+
+enum class UnpackError {
+	OK,
+	TOO_SHORT,
+	BAD_MAGIC,
+	UNSUPPORTED_VERSION,
+	UNKNOWN_ENCODING,
+	SIZE_MISMATCH,
+	TRUNCATED,
+	CORRUPT,
+	TRAILING_BYTES,
+};
+
+inline auto get_unpack_error_message(const UnpackError error) -> const char * {
+	switch (error) {
+		case UnpackError::OK: return "no error";
+		case UnpackError::TOO_SHORT: return "not enough bytes for the header";
+		case UnpackError::BAD_MAGIC: return "doesn't start with \"DECM\", this isn't packed decimal data";
+		case UnpackError::UNSUPPORTED_VERSION: return "made by a newer version of the plugin";
+		case UnpackError::UNKNOWN_ENCODING: return "unknown encoding";
+		case UnpackError::SIZE_MISMATCH: return "payload size doesn't match the element count";
+		case UnpackError::TRUNCATED: return "data ends in the middle of an element";
+		case UnpackError::CORRUPT: return "invalid compact element";
+		case UnpackError::TRAILING_BYTES: return "unexpected bytes after the last element";
+	}
+	return "unknown error";
+}
+
+struct Header {
+	uint8_t version;
+	Encoding encoding;
+	uint64_t count;
+};
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr const bool HOST_LITTLE_ENDIAN = false;
+#else
+constexpr const bool HOST_LITTLE_ENDIAN = true;
+#endif
+
+inline auto store_u64(uint8_t *dst, const uint64_t v) -> void {
+	for (int i = 0; i < 8; i++) {
+		dst[i] = static_cast<uint8_t>(v >> (i * 8));
+	}
+}
+
+inline auto load_u64(const uint8_t *src) -> uint64_t {
+	uint64_t v = 0;
+	for (int i = 0; i < 8; i++) {
+		v |= static_cast<uint64_t>(src[i]) << (i * 8);
+	}
+	return v;
+}
+
+inline auto mantissa_bits(const double m) -> uint64_t {
+	uint64_t bits;
+	memcpy(&bits, &m, sizeof(bits));
+	return bits;
+}
+
+inline auto mantissa_from_bits(const uint64_t bits) -> double {
+	double m;
+	memcpy(&m, &bits, sizeof(m));
+	return m;
+}
+
+// How many bytes pack() needs at most.
+inline auto max_packed_size(const int64_t count, const Encoding encoding) -> int64_t {
+	return HEADER_SIZE + count * (encoding == Encoding::RAW ? RAW_ELEMENT_SIZE : COMPACT_ELEMENT_MAX);
+}
+
+inline auto write_header(uint8_t *dst, const Encoding encoding, const int64_t count) -> void {
+	memcpy(dst, MAGIC, sizeof(MAGIC));
+	dst[4] = VERSION;
+	dst[5] = static_cast<uint8_t>(encoding);
+	dst[6] = 0;
+	dst[7] = 0;
+	store_u64(dst + 8, static_cast<uint64_t>(count));
+}
+
+inline auto read_header(const uint8_t *src, const int64_t len, Header &out) -> UnpackError {
+	if (len < HEADER_SIZE) return UnpackError::TOO_SHORT;
+	if (memcmp(src, MAGIC, sizeof(MAGIC)) != 0) return UnpackError::BAD_MAGIC;
+	if (src[4] == 0 || src[4] > VERSION) return UnpackError::UNSUPPORTED_VERSION;
+	if (src[5] > static_cast<uint8_t>(Encoding::COMPACT)) return UnpackError::UNKNOWN_ENCODING;
+
+	out.version = src[4];
+	out.encoding = static_cast<Encoding>(src[5]);
+	out.count = load_u64(src + 8);
+	return UnpackError::OK;
+}
+
+// Checks the element count against the payload size, so that a broken header
+// can't make the caller allocate more than the data could possibly hold.
+inline auto check_count(const Header &header, const int64_t payload_len) -> UnpackError {
+	if (header.encoding == Encoding::RAW) {
+		const auto max = static_cast<uint64_t>(payload_len / RAW_ELEMENT_SIZE);
+		if (header.count > max || static_cast<int64_t>(header.count) * RAW_ELEMENT_SIZE != payload_len) {
+			return UnpackError::SIZE_MISMATCH;
+		}
+	} else {
+		// a compact element is at least a control byte and a varint byte
+		if (header.count > static_cast<uint64_t>(payload_len / 2)) return UnpackError::TRUNCATED;
+	}
+	return UnpackError::OK;
+}
+
+inline auto zigzag(const uint64_t v) -> uint64_t {
+	return (v << 1) ^ (0 - (v >> 63));
+}
+
+inline auto unzigzag(const uint64_t v) -> uint64_t {
+	return (v >> 1) ^ (0 - (v & 1));
+}
+
+inline auto leading_zero_bytes(const uint64_t v) -> int {
+	int n = 0;
+	while (n < 8 && ((v >> (56 - n * 8)) & 0xff) == 0) n++;
+	return n;
+}
+
+inline auto trailing_zero_bytes(const uint64_t v) -> int {
+	int n = 0;
+	while (n < 8 && ((v >> (n * 8)) & 0xff) == 0) n++;
+	return n;
+}
+
+inline auto pack_raw(const DecimalData *src, const int64_t count, uint8_t *dst) -> int64_t {
+	// (an empty array's pointer can be null, which memcpy doesn't allow even
+	// for 0 bytes)
+	if (count == 0) return 0;
+
+	if (HOST_LITTLE_ENDIAN) {
+		memcpy(dst, static_cast<const void *>(src), count * RAW_ELEMENT_SIZE);
+	} else {
+		for (int64_t i = 0; i < count; i++) {
+			store_u64(dst + i * RAW_ELEMENT_SIZE, mantissa_bits(src[i].mantissa));
+			store_u64(dst + i * RAW_ELEMENT_SIZE + 8, static_cast<uint64_t>(src[i].exponent));
+		}
+	}
+	return count * RAW_ELEMENT_SIZE;
+}
+
+inline auto pack_compact(const DecimalData *src, const int64_t count, uint8_t *dst) -> int64_t {
+	uint64_t prev_bits = 0;
+	uint64_t prev_exp = 0;
+	int64_t len = 0;
+
+	for (int64_t i = 0; i < count; i++) {
+		const auto bits = mantissa_bits(src[i].mantissa);
+		const auto x = bits ^ prev_bits;
+
+		// all-zero is written as 8 leading zero bytes and nothing else
+		const auto lead = leading_zero_bytes(x);
+		const auto trail = x == 0 ? 0 : trailing_zero_bytes(x);
+		dst[len++] = static_cast<uint8_t>((lead << 4) | trail);
+		for (int b = trail; b < 8 - lead; b++) {
+			dst[len++] = static_cast<uint8_t>(x >> (b * 8));
+		}
+
+		// unsigned math, so that deltas across the whole int64 range wrap instead of overflowing
+		const auto exp = static_cast<uint64_t>(src[i].exponent);
+		auto v = zigzag(exp - prev_exp);
+		while (v >= 0x80) {
+			dst[len++] = static_cast<uint8_t>(v | 0x80);
+			v >>= 7;
+		}
+		dst[len++] = static_cast<uint8_t>(v);
+
+		prev_bits = bits;
+		prev_exp = exp;
+	}
+	return len;
+}
+
+// Writes the header and `count` elements to `dst`, which needs room for
+// max_packed_size(count, encoding) bytes. Returns the number of bytes written.
+inline auto pack(const DecimalData *src, const int64_t count, const Encoding encoding, uint8_t *dst) -> int64_t {
+	write_header(dst, encoding, count);
+	return HEADER_SIZE + (encoding == Encoding::RAW ?
+		pack_raw(src, count, dst + HEADER_SIZE) :
+		pack_compact(src, count, dst + HEADER_SIZE));
+}
+
+inline auto unpack_raw(const uint8_t *src, const int64_t len, DecimalData *dst, const int64_t count) -> UnpackError {
+	if (len != count * RAW_ELEMENT_SIZE) return UnpackError::SIZE_MISMATCH;
+	if (count == 0) return UnpackError::OK;
+
+	if (HOST_LITTLE_ENDIAN) {
+		memcpy(static_cast<void *>(dst), src, len);
+	} else {
+		for (int64_t i = 0; i < count; i++) {
+			dst[i].mantissa = mantissa_from_bits(load_u64(src + i * RAW_ELEMENT_SIZE));
+			dst[i].exponent = static_cast<int64_t>(load_u64(src + i * RAW_ELEMENT_SIZE + 8));
+		}
+	}
+	return UnpackError::OK;
+}
+
+inline auto unpack_compact(const uint8_t *src, const int64_t len, DecimalData *dst, const int64_t count) -> UnpackError {
+	uint64_t prev_bits = 0;
+	uint64_t prev_exp = 0;
+	int64_t pos = 0;
+
+	for (int64_t i = 0; i < count; i++) {
+		if (pos >= len) return UnpackError::TRUNCATED;
+
+		const auto control = src[pos++];
+		const int lead = control >> 4;
+		const int trail = control & 0x0f;
+		if (lead + trail > 8) return UnpackError::CORRUPT;
+		if (pos + (8 - lead - trail) > len) return UnpackError::TRUNCATED;
+
+		uint64_t x = 0;
+		for (int b = trail; b < 8 - lead; b++) {
+			x |= static_cast<uint64_t>(src[pos++]) << (b * 8);
+		}
+
+		uint64_t v = 0;
+		for (int shift = 0;; shift += 7) {
+			if (shift > 63) return UnpackError::CORRUPT;
+			if (pos >= len) return UnpackError::TRUNCATED;
+			const auto byte = src[pos++];
+			v |= static_cast<uint64_t>(byte & 0x7f) << shift;
+			if ((byte & 0x80) == 0) break;
+		}
+
+		prev_bits ^= x;
+		prev_exp += unzigzag(v);
+		dst[i] = DecimalData(mantissa_from_bits(prev_bits), static_cast<int64_t>(prev_exp));
+	}
+
+	return pos == len ? UnpackError::OK : UnpackError::TRAILING_BYTES;
+}
+
+// Reads `header.count` elements from the payload (the bytes after the header)
+// into `dst`. check_count() should have passed first.
+inline auto unpack(const Header &header, const uint8_t *payload, const int64_t len, DecimalData *dst) -> UnpackError {
+	const auto count = static_cast<int64_t>(header.count);
+	return header.encoding == Encoding::RAW ?
+		unpack_raw(payload, len, dst, count) :
+		unpack_compact(payload, len, dst, count);
+}
+
+// Raw payloads can be used without copying at all, as long as the host is
+// little-endian and the buffer happens to be 8-byte aligned. Returns nullptr
+// when that isn't the case, unpack() has to be used then.
+inline auto view_raw(const Header &header, const uint8_t *payload, const int64_t len) -> const DecimalData * {
+	if (!HOST_LITTLE_ENDIAN || header.encoding != Encoding::RAW) return nullptr;
+	if (len != static_cast<int64_t>(header.count) * RAW_ELEMENT_SIZE) return nullptr;
+	if (reinterpret_cast<uintptr_t>(payload) % alignof(DecimalData) != 0) return nullptr;
+	return reinterpret_cast<const DecimalData *>(payload);
+}
+
+} // namespace decimal_pack
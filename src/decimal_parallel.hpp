@@ -0,0 +1,183 @@
+#pragma once
+
+// Splitting large element-wise batches across threads.
+//
+// Arrays are cut into fixed CHUNK_SIZE pieces no matter how many threads there
+// are, and every element is computed on its own, so the results are the same
+// bit for bit whether one thread runs all chunks or sixteen threads share
+// them. A chunk is 8192 decimals (128 KiB per array), which keeps the inputs
+// and output of one chunk within L2, and is a multiple of 4 so neighbouring
+// chunks don't write to the same 64-byte cache line (as long as the array
+// itself starts on one).
+//
+// Inside the extension the chunks run on Godot's WorkerThreadPool (see
+// DecimalArray::for_each_chunk()). ThreadPool below is the same thing on plain
+// std::thread, for using the core without Godot, like in the bench.
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace decimal_parallel {
+
+constexpr const int64_t CHUNK_SIZE = 8192;
+
+// below this many elements, handing chunks to other threads costs more than
+// it saves
+constexpr const int64_t DEFAULT_THRESHOLD = 65536;
+
+struct Range {
+	int64_t begin;
+	int64_t end;
+};
+
+inline auto chunk_count(const int64_t n) -> int64_t {
+	return (n + CHUNK_SIZE - 1) / CHUNK_SIZE;
+}
+
+inline auto chunk_range(const int64_t idx, const int64_t n) -> Range {
+	const auto begin = idx * CHUNK_SIZE;
+	return { begin, std::min(begin + CHUNK_SIZE, n) };
+}
+
+// A fixed set of worker threads that run the chunks of one batch at a time.
+// The calling thread works on chunks too, and run() returns once all of them
+// are done.
+class ThreadPool {
+	using Task = void (*)(void *userdata, int64_t chunk);
+
+	// lives on the stack of run(), which doesn't return before every worker
+	// that picked it up is done with it
+	struct Batch {
+		Task task;
+		void *userdata;
+		int64_t chunks;
+		std::atomic<int64_t> next_chunk{ 0 };
+	};
+
+	std::vector<std::thread> workers;
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable finished;
+
+	// guarded by `mutex`
+	Batch *current = nullptr;
+	uint64_t generation = 0;
+	int64_t busy = 0;
+	bool stopping = false;
+
+	static auto work(Batch &batch) -> void {
+		for (auto idx = batch.next_chunk.fetch_add(1); idx < batch.chunks; idx = batch.next_chunk.fetch_add(1)) {
+			batch.task(batch.userdata, idx);
+		}
+	}
+
+	auto worker_loop() -> void {
+		uint64_t seen = 0;
+		while (true) {
+			Batch *batch;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				wake.wait(lock, [&] { return stopping || (current != nullptr && generation != seen); });
+				if (stopping) return;
+				seen = generation;
+				batch = current;
+				busy++;
+			}
+
+			work(*batch);
+
+			std::lock_guard<std::mutex> lock(mutex);
+			if (--busy == 0) {
+				finished.notify_all();
+			}
+		}
+	}
+
+public:
+	// 0 threads means one per hardware thread, the caller being one of them
+	explicit ThreadPool(int64_t threads = 0) {
+		if (threads <= 0) {
+			threads = std::max<int64_t>(1, std::thread::hardware_concurrency());
+		}
+		for (int64_t i = 1; i < threads; i++) {
+			workers.emplace_back([this] { worker_loop(); });
+		}
+	}
+
+	~ThreadPool() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		wake.notify_all();
+		for (auto &w : workers) {
+			w.join();
+		}
+	}
+
+	ThreadPool(const ThreadPool &) = delete;
+	auto operator=(const ThreadPool &) -> ThreadPool & = delete;
+
+	auto thread_count() const -> int64_t {
+		return static_cast<int64_t>(workers.size()) + 1;
+	}
+
+	// not reentrant, one batch at a time per pool
+	auto run(const int64_t count, const Task fn, void *data) -> void {
+		if (count <= 0) return;
+		if (workers.empty() || count == 1) {
+			for (int64_t i = 0; i < count; i++) {
+				fn(data, i);
+			}
+			return;
+		}
+
+		Batch batch;
+		batch.task = fn;
+		batch.userdata = data;
+		batch.chunks = count;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			current = &batch;
+			generation++;
+		}
+		wake.notify_all();
+
+		work(batch);
+
+		// every chunk has been claimed, wait for the ones still running
+		std::unique_lock<std::mutex> lock(mutex);
+		finished.wait(lock, [&] { return busy == 0; });
+		current = nullptr;
+	}
+};
+
+// Calls fn(begin, end) for every chunk of [0, n), on `pool` once n reaches
+// `threshold`, otherwise once for the whole range on the calling thread.
+template <typename F>
+inline auto for_each_chunk(ThreadPool &pool, const int64_t n, F &&fn, const int64_t threshold = DEFAULT_THRESHOLD) -> void {
+	if (n < threshold || pool.thread_count() == 1) {
+		fn(int64_t(0), n);
+		return;
+	}
+
+	struct Job {
+		std::remove_reference_t<F> *fn;
+		int64_t n;
+	};
+	Job job = { &fn, n };
+
+	pool.run(chunk_count(n), [](void *data, const int64_t idx) {
+		auto *job = static_cast<Job *>(data);
+		const auto r = chunk_range(idx, job->n);
+		(*job->fn)(r.begin, r.end);
+	}, &job);
+}
+
+} // namespace decimal_parallel
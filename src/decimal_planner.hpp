@@ -0,0 +1,222 @@
+#pragma once
+
+// Picks which upgrades to buy, and in what order, by repeatedly taking the one
+// with the best (lowest) decimal_core::efficiency_of_purchase() score that's
+// still affordable.
+//
+// The score is cost / rps + cost / delta_rps. With x = 1 / rps, that's a line
+// a*x + b per upgrade (a = cost, b = cost / delta_rps), and buying anything
+// only ever moves x down. So instead of rescoring every upgrade after each
+// purchase, the upgrades sit in a kinetic tournament tree: every node keeps
+// the winner of its subtree along with the x below which that winner could
+// lose. After a purchase, only the bought upgrade's path and the nodes whose
+// x got crossed are recomputed.
+//
+// Like decimal_core.hpp, nothing in here reports errors.
+
+#include "decimal_core.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace decimal_planner {
+
+enum class Curve : uint8_t {
+	GEOMETRIC,   // price_start * price_step^owned
+	ARITHMETIC,  // price_start + price_step * owned
+};
+
+struct Upgrade {
+	Curve curve = Curve::GEOMETRIC;
+	DecimalData price_start;
+	DecimalData price_step;
+	DecimalData delta_rps;
+	int64_t owned = 0;
+};
+
+inline auto cost_at(const Upgrade &up, const int64_t owned) -> DecimalData {
+	namespace core = decimal_core;
+
+	if (up.curve == Curve::GEOMETRIC) {
+		return core::mul(up.price_start, core::pow_num(up.price_step, static_cast<double>(owned)));
+	}
+	return core::add(up.price_start, core::mul_num(up.price_step, static_cast<double>(owned)));
+}
+
+inline auto next_cost(const Upgrade &up, const DecimalData &cost) -> DecimalData {
+	namespace core = decimal_core;
+
+	return up.curve == Curve::GEOMETRIC ? core::mul(cost, up.price_step) : core::add(cost, up.price_step);
+}
+
+class Tournament {
+	struct Leaf {
+		DecimalData cost; // a
+		DecimalData payback; // b, cost / delta_rps
+		bool active = false;
+	};
+
+	struct Node {
+		int64_t winner = -1;
+		DecimalData expires; // recompute once x drops below this, 0 = never
+	};
+
+	std::vector<Leaf> leaves;
+	std::vector<Node> nodes;
+	int64_t base = 1;
+	DecimalData x;
+
+	auto score(const int64_t idx) const -> DecimalData {
+		const auto &leaf = leaves[idx];
+		return decimal_core::add(decimal_core::mul(leaf.cost, x), leaf.payback);
+	}
+
+	auto combine(const int64_t node) -> void {
+		namespace core = decimal_core;
+
+		const auto &left = nodes[node * 2];
+		const auto &right = nodes[node * 2 + 1];
+		auto &res = nodes[node];
+
+		if (left.winner < 0 || right.winner < 0) {
+			res = left.winner < 0 ? right : left;
+			return;
+		}
+
+		// ties go to the lower index, so plans are deterministic
+		const auto order = core::cmp(score(left.winner), score(right.winner));
+		const auto left_wins = order < 0 || (order == 0 && left.winner < right.winner);
+		const auto w = left_wins ? left.winner : right.winner;
+		const auto l = left_wins ? right.winner : left.winner;
+
+		res.winner = w;
+		res.expires = core::max(left.expires, right.expires);
+
+		// the loser only catches up if its line is steeper, at
+		// x = (b_w - b_l) / (a_l - a_w)
+		const auto slope = core::sub(leaves[l].cost, leaves[w].cost);
+		const auto offset = core::sub(leaves[w].payback, leaves[l].payback);
+		if (core::sign(slope) > 0 && core::sign(offset) > 0) {
+			res.expires = core::max(res.expires, core::div(offset, slope));
+		}
+	}
+
+	auto refresh(const int64_t node) -> void {
+		if (node >= base || !decimal_core::lt(x, nodes[node].expires)) return;
+
+		refresh(node * 2);
+		refresh(node * 2 + 1);
+		combine(node);
+	}
+
+public:
+	auto build(const std::vector<DecimalData> &costs, const std::vector<Upgrade> &upgrades, const DecimalData &rps) -> void {
+		const auto n = static_cast<int64_t>(upgrades.size());
+		base = 1;
+		while (base < n) {
+			base *= 2;
+		}
+
+		x = decimal_core::recip(rps);
+		leaves.assign(base, Leaf());
+		nodes.assign(base * 2, Node());
+		for (int64_t i = 0; i < n; i++) {
+			set_leaf(i, costs[i], upgrades[i].delta_rps);
+		}
+		for (auto node = base - 1; node >= 1; node--) {
+			combine(node);
+		}
+	}
+
+	// upgrades that add nothing (or can't be priced) are never picked
+	auto set_leaf(const int64_t idx, const DecimalData &cost, const DecimalData &delta_rps) -> void {
+		namespace core = decimal_core;
+
+		auto &leaf = leaves[idx];
+		leaf.cost = cost;
+		leaf.payback = core::div(cost, delta_rps);
+		leaf.active = core::sign(delta_rps) > 0 && core::sign(cost) >= 0 && core::is_finite(cost);
+		nodes[base + idx].winner = leaf.active ? idx : -1;
+	}
+
+	// call after set_leaf() to bring the path up to the root back in order
+	auto update(const int64_t idx) -> void {
+		for (auto node = (base + idx) / 2; node >= 1; node /= 2) {
+			combine(node);
+		}
+	}
+
+	auto deactivate(const int64_t idx) -> void {
+		leaves[idx].active = false;
+		nodes[base + idx].winner = -1;
+		update(idx);
+	}
+
+	// x can only go down, the score of everything drops with it
+	auto set_rps(const DecimalData &rps) -> void {
+		x = decimal_core::recip(rps);
+		refresh(1);
+	}
+
+	auto winner() const -> int64_t {
+		return nodes[1].winner;
+	}
+};
+
+struct Plan {
+	std::vector<int64_t> purchases;
+	DecimalData spent;
+	DecimalData rps;
+};
+
+// Buys greedily from `budget` until nothing affordable is left or
+// `max_purchases` is reached. `rps` has to be positive.
+//
+// An upgrade that's too expensive once is dropped for good, the budget only
+// shrinks and its price doesn't change until it's bought.
+inline auto plan(
+	const std::vector<Upgrade> &upgrades,
+	const DecimalData &budget,
+	const DecimalData &rps,
+	const int64_t max_purchases,
+	Tournament &tree,
+	Plan &out
+) -> void {
+	namespace core = decimal_core;
+
+	out.purchases.clear();
+	out.spent = core::DECIMAL_ZERO;
+	out.rps = rps;
+
+	const auto n = static_cast<int64_t>(upgrades.size());
+	if (n == 0) return;
+
+	std::vector<DecimalData> costs(n);
+	for (int64_t i = 0; i < n; i++) {
+		costs[i] = cost_at(upgrades[i], upgrades[i].owned);
+	}
+	tree.build(costs, upgrades, rps);
+
+	auto left = budget;
+	while (static_cast<int64_t>(out.purchases.size()) < max_purchases) {
+		const auto best = tree.winner();
+		if (best < 0) break;
+
+		if (core::gt(costs[best], left)) {
+			tree.deactivate(best);
+			continue;
+		}
+
+		left = core::sub(left, costs[best]);
+		out.spent = core::add(out.spent, costs[best]);
+		out.rps = core::add(out.rps, upgrades[best].delta_rps);
+		out.purchases.push_back(best);
+
+		costs[best] = next_cost(upgrades[best], costs[best]);
+		tree.set_leaf(best, costs[best], upgrades[best].delta_rps);
+		tree.update(best);
+		tree.set_rps(out.rps);
+	}
+}
+
+} // namespace decimal_planner
@@ -0,0 +1,481 @@
+#pragma once
+
+// The decimal math of decimal_core.hpp, templated on the type of the mantissa:
+//
+// - float: about 7 significant digits, for big counts that don't need more.
+// - double: the regular DecimalData. Every op forwards to decimal_core, so the
+//   results are bit for bit the same as Decimal's.
+// - DoubleDouble: an unevaluated sum of two doubles, about 31 digits. Long
+//   running totals don't drift the way they do with 17 digits.
+//
+// Everything that depends on the mantissa type (how many digits it holds, the
+// powers of 10, rounding...) comes from its MantissaPolicy. Exponents are
+// int64_t for all of them. Logarithms and pow10_num() go through doubles for
+// every type, their input is a double anyway.
+
+#include "decimal_core.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace decimal_precision {
+
+namespace core = decimal_core;
+
+// hi + lo, with |lo| <= half an ulp of hi. The usual error-free transforms,
+// see Dekker (1971) and the QD library by Hida, Li and Bailey.
+struct DoubleDouble {
+	double hi = 0.0;
+	double lo = 0.0;
+
+	constexpr DoubleDouble() = default;
+	constexpr DoubleDouble(const double h) : hi(h) {}
+	constexpr DoubleDouble(const double h, const double l) : hi(h), lo(l) {}
+};
+
+// a + b, for |a| >= |b|. Every op below ends with this, so it's also where
+// infinities and NaN get through without turning the low part into NaN.
+inline auto quick_two_sum(const double a, const double b) -> DoubleDouble {
+	const auto s = a + b;
+	if (DECIMAL_UNLIKELY(!std::isfinite(s))) {
+		return DoubleDouble(std::isfinite(a) ? s : a);
+	}
+	return DoubleDouble(s, b - (s - a));
+}
+
+inline auto two_sum(const double a, const double b) -> DoubleDouble {
+	const auto s = a + b;
+	const auto bb = s - a;
+	return DoubleDouble(s, (a - (s - bb)) + (b - bb));
+}
+
+inline auto two_prod(const double a, const double b) -> DoubleDouble {
+	const auto p = a * b;
+	return DoubleDouble(p, std::fma(a, b, -p));
+}
+
+inline auto operator-(const DoubleDouble &a) -> DoubleDouble {
+	return DoubleDouble(-a.hi, -a.lo);
+}
+
+inline auto operator+(const DoubleDouble &a, const DoubleDouble &b) -> DoubleDouble {
+	auto s = two_sum(a.hi, b.hi);
+	const auto t = two_sum(a.lo, b.lo);
+	s.lo += t.hi;
+	s = quick_two_sum(s.hi, s.lo);
+	s.lo += t.lo;
+	return quick_two_sum(s.hi, s.lo);
+}
+
+inline auto operator-(const DoubleDouble &a, const DoubleDouble &b) -> DoubleDouble {
+	return a + -b;
+}
+
+inline auto operator*(const DoubleDouble &a, const DoubleDouble &b) -> DoubleDouble {
+	auto p = two_prod(a.hi, b.hi);
+	p.lo += a.hi * b.lo + a.lo * b.hi;
+	return quick_two_sum(p.hi, p.lo);
+}
+
+inline auto operator/(const DoubleDouble &a, const DoubleDouble &b) -> DoubleDouble {
+	// long division, one double worth of quotient at a time
+	const auto q1 = a.hi / b.hi;
+	if (DECIMAL_UNLIKELY(!std::isfinite(q1) || !std::isfinite(b.hi))) {
+		return DoubleDouble(q1);
+	}
+	auto r = a - b * DoubleDouble(q1);
+	const auto q2 = r.hi / b.hi;
+	r = r - b * DoubleDouble(q2);
+	const auto q3 = r.hi / b.hi;
+	return quick_two_sum(q1, q2) + DoubleDouble(q3);
+}
+
+// a / b for a plain double, a lot cheaper than the full division above
+inline auto div_double(const DoubleDouble &a, const double b) -> DoubleDouble {
+	const auto q1 = a.hi / b;
+	if (DECIMAL_UNLIKELY(!std::isfinite(q1) || !std::isfinite(b))) {
+		return DoubleDouble(q1);
+	}
+	const auto p = two_prod(q1, b);
+	auto r = two_sum(a.hi, -p.hi);
+	r.lo = r.lo - p.lo + a.lo;
+	const auto q2 = (r.hi + r.lo) / b;
+	return quick_two_sum(q1, q2);
+}
+
+inline auto operator==(const DoubleDouble &a, const DoubleDouble &b) -> bool { return a.hi == b.hi && a.lo == b.lo; }
+inline auto operator!=(const DoubleDouble &a, const DoubleDouble &b) -> bool { return !(a == b); }
+inline auto operator<(const DoubleDouble &a, const DoubleDouble &b) -> bool { return a.hi < b.hi || (a.hi == b.hi && a.lo < b.lo); }
+inline auto operator>(const DoubleDouble &a, const DoubleDouble &b) -> bool { return b < a; }
+inline auto operator<=(const DoubleDouble &a, const DoubleDouble &b) -> bool { return !(b < a); }
+inline auto operator>=(const DoubleDouble &a, const DoubleDouble &b) -> bool { return !(a < b); }
+
+template <typename M>
+struct MantissaPolicy;
+
+template <>
+struct MantissaPolicy<float> {
+	// add() drops the smaller number this many orders of magnitude down, and
+	// rounds the sum to ADD_SCALE_EXP digits after the leading one
+	static constexpr const int64_t DIGITS = 9;
+	static constexpr const int64_t ADD_SCALE_EXP = 6;
+
+	// 1e-45 is the smallest subnormal
+	static constexpr const int64_t POW10_OFFSET = 45;
+	static constexpr const int64_t POW10_MAX = 38;
+
+	static constexpr const auto POW10_LOOKUP = [] {
+		std::array<float, POW10_OFFSET + POW10_MAX + 1> table {};
+		for (int64_t i = 0; i < static_cast<int64_t>(table.size()); i++) {
+			table[i] = static_cast<float>(::POW10_LOOKUP[i - POW10_OFFSET + ::POW10_OFFSET]);
+		}
+		return table;
+	}();
+
+	static auto pow10(const int64_t exp) -> float {
+		const auto idx = static_cast<uint64_t>(exp + POW10_OFFSET);
+		if (DECIMAL_UNLIKELY(idx >= POW10_LOOKUP.size())) {
+			return std::numeric_limits<float>::quiet_NaN();
+		}
+		return POW10_LOOKUP[idx];
+	}
+
+	// m * 10^-k. Done in doubles, since 10^-k doesn't fit in a float for most
+	// subnormal m. Unlike core::scale_pow10() it can always multiply: the
+	// error of the reciprocal is far below what a float can hold.
+	static auto scale_pow10(const float m, const int64_t k) -> float {
+		return static_cast<float>(m * ::POW10_LOOKUP[-k + ::POW10_OFFSET]);
+	}
+
+	static auto from_double(const double d) -> float { return static_cast<float>(d); }
+	static auto to_double(const float m) -> double { return m; }
+	static auto round(const float m) -> float { return std::round(m); }
+	static auto sqrt(const float m) -> float { return std::sqrt(m); }
+	static auto log10(const float m) -> double { return core::mantissa_log10(m); }
+};
+
+template <>
+struct MantissaPolicy<double> {
+	static constexpr const int64_t DIGITS = MAX_SIGNIFICANT_DIGITS;
+	static constexpr const int64_t ADD_SCALE_EXP = 14;
+
+	static auto pow10(const int64_t exp) -> double { return core::pow10(exp); }
+	static auto scale_pow10(const double m, const int64_t k) -> double { return core::scale_pow10(m, k); }
+
+	static auto from_double(const double d) -> double { return d; }
+	static auto to_double(const double m) -> double { return m; }
+	static auto round(const double m) -> double { return std::round(m); }
+	static auto sqrt(const double m) -> double { return std::sqrt(m); }
+	static auto log10(const double m) -> double { return core::mantissa_log10(m); }
+};
+
+template <>
+struct MantissaPolicy<DoubleDouble> {
+	// 10^31 still fits in the 106 bits of the two mantissas, exactly
+	static constexpr const int64_t DIGITS = 33;
+	static constexpr const int64_t ADD_SCALE_EXP = 30;
+
+	// 10^k is exact in a DoubleDouble while 5^k < 2^106 (up to 10^45), and
+	// the product of two exact doubles up to 10^44
+	static constexpr const int64_t POW10_EXACT_MAX = 44;
+
+	// Built by repeated multiplication, which is exact up to POW10_EXACT_MAX
+	// and loses about an ulp (of the low part) per step after it. The negative
+	// powers are divided from the positive ones. Below 1e-292 the low parts
+	// become subnormal, so those entries get less precise.
+	static inline const auto POW10_LOOKUP = [] {
+		std::array<DoubleDouble, ::POW10_OFFSET + DOUBLE_EXP_MAX + 1> table {};
+		DoubleDouble p(1.0);
+		table[::POW10_OFFSET] = p;
+		for (int64_t k = 1; k <= DOUBLE_EXP_MAX; k++) {
+			p = p * DoubleDouble(10.0);
+			table[k + ::POW10_OFFSET] = p;
+		}
+		for (int64_t k = 1; k <= ::POW10_OFFSET; k++) {
+			table[::POW10_OFFSET - k] = k <= DOUBLE_EXP_MAX ?
+				DoubleDouble(1.0) / table[k + ::POW10_OFFSET] :
+				DoubleDouble(::POW10_LOOKUP[::POW10_OFFSET - k]);
+		}
+		return table;
+	}();
+
+	static auto pow10(const int64_t exp) -> DoubleDouble {
+		const auto idx = static_cast<uint64_t>(exp + ::POW10_OFFSET);
+		if (DECIMAL_UNLIKELY(idx >= POW10_LOOKUP.size())) {
+			return DoubleDouble(std::numeric_limits<double>::quiet_NaN());
+		}
+		return POW10_LOOKUP[idx];
+	}
+
+	// Like core::scale_pow10(), dividing by the exact powers and multiplying
+	// by the rest. The exact ones are split into powers that fit in a double,
+	// since dividing by those is a lot cheaper.
+	static auto scale_pow10(const DoubleDouble &m, const int64_t k) -> DoubleDouble {
+		if (k > 0 && k <= core::POW10_EXACT_MAX) {
+			return div_double(m, core::pow10(k));
+		}
+		if (k > 0 && k <= POW10_EXACT_MAX) {
+			return div_double(div_double(m, core::pow10(core::POW10_EXACT_MAX)), core::pow10(k - core::POW10_EXACT_MAX));
+		}
+		return m * pow10(-k);
+	}
+
+	static auto from_double(const double d) -> DoubleDouble { return DoubleDouble(d); }
+
+	// hi is lo + hi rounded to the nearest double already, and it's the only
+	// part that stays meaningful for infinities
+	static auto to_double(const DoubleDouble &m) -> double { return m.hi; }
+
+	// half away from zero, like std::round()
+	static auto round(const DoubleDouble &m) -> DoubleDouble {
+		const auto hi = std::round(m.hi);
+		if (hi == m.hi) {
+			return quick_two_sum(hi, std::round(m.lo));
+		}
+		// hi was exactly halfway, lo decides which way
+		if (hi - m.hi == 0.5 && m.lo < 0.0) return DoubleDouble(hi - 1.0);
+		if (hi - m.hi == -0.5 && m.lo > 0.0) return DoubleDouble(hi + 1.0);
+		return DoubleDouble(hi);
+	}
+
+	// one Newton step from the double square root
+	static auto sqrt(const DoubleDouble &m) -> DoubleDouble {
+		if (m.hi <= 0.0) return DoubleDouble(std::sqrt(m.hi));
+		const auto x = std::sqrt(m.hi);
+		const auto r = m - two_prod(x, x);
+		return quick_two_sum(x, r.hi * (0.5 / x));
+	}
+
+	static auto log10(const DoubleDouble &m) -> double {
+		constexpr const double LN_10 = 2.302585092994046;
+		return std::log10(m.hi) + m.lo / (m.hi * LN_10);
+	}
+};
+
+template <typename M>
+inline constexpr const bool IS_DOUBLE = std::is_same_v<M, double>;
+
+template <typename M>
+inline auto is_finite(const BasicDecimal<M> &dec) -> bool {
+	return std::isfinite(MantissaPolicy<M>::to_double(dec.mantissa));
+}
+
+template <typename M>
+inline auto sign(const BasicDecimal<M> &dec) -> int64_t {
+	const auto m = MantissaPolicy<M>::to_double(dec.mantissa);
+	return m > 0 ? +1 : m < 0 ? -1 : 0;
+}
+
+template <typename M>
+inline auto neg(const BasicDecimal<M> &dec) -> BasicDecimal<M> {
+	return BasicDecimal<M>(-dec.mantissa, dec.exponent);
+}
+
+template <typename M>
+inline auto abs(const BasicDecimal<M> &dec) -> BasicDecimal<M> {
+	return sign(dec) < 0 ? neg(dec) : dec;
+}
+
+template <typename M>
+inline auto normalize(const BasicDecimal<M> &dec) -> BasicDecimal<M> {
+	using P = MantissaPolicy<M>;
+	if constexpr (IS_DOUBLE<M>) {
+		return core::normalize(dec);
+	} else {
+		DECIMAL_COUNT(NORMALIZE);
+
+		const auto approx = std::abs(P::to_double(dec.mantissa));
+		if (approx == 0) {
+			return BasicDecimal<M>();
+		}
+		if (DECIMAL_UNLIKELY(!std::isfinite(approx))) {
+			return dec;
+		}
+
+		auto m = dec.mantissa;
+		auto exp = dec.exponent;
+		if (DECIMAL_UNLIKELY(approx < std::numeric_limits<double>::min())) {
+			m = m * M(core::SUBNORMAL_SCALE);
+			exp -= core::SUBNORMAL_SCALE_EXP;
+		}
+
+		// the estimate comes from the leading double only, so it can be one
+		// off in both directions once the rest of the mantissa is counted in
+		const auto k = core::floor_log10(std::abs(P::to_double(m)));
+		auto res = P::scale_pow10(m, k);
+		exp += k;
+
+		const auto res_abs = res < M(0.0) ? -res : res;
+		if (DECIMAL_UNLIKELY(res_abs >= M(10.0))) {
+			res = res / M(10.0);
+			exp++;
+		} else if (DECIMAL_UNLIKELY(res_abs < M(1.0))) {
+			res = res * M(10.0);
+			exp--;
+		}
+		return BasicDecimal<M>(res, exp);
+	}
+}
+
+// from and to the regular DecimalData
+template <typename M>
+inline auto from_decimal(const DecimalData &dec) -> BasicDecimal<M> {
+	if constexpr (IS_DOUBLE<M>) {
+		return dec;
+	} else {
+		// a mantissa just under 10 can round up to 10 in a float
+		return normalize(BasicDecimal<M>(MantissaPolicy<M>::from_double(dec.mantissa), dec.exponent));
+	}
+}
+
+template <typename M>
+inline auto to_decimal(const BasicDecimal<M> &dec) -> DecimalData {
+	if constexpr (IS_DOUBLE<M>) {
+		return dec;
+	} else {
+		return core::normalize(DecimalData(MantissaPolicy<M>::to_double(dec.mantissa), dec.exponent));
+	}
+}
+
+template <typename M>
+inline auto from_float(const double num) -> BasicDecimal<M> {
+	return from_decimal<M>(core::from_float(num));
+}
+
+template <typename M>
+inline auto into_float(const BasicDecimal<M> &dec) -> double {
+	return core::into_float(to_decimal(dec));
+}
+
+template <typename M>
+inline auto add(const BasicDecimal<M> &d1, const BasicDecimal<M> &d2) -> BasicDecimal<M> {
+	using P = MantissaPolicy<M>;
+	if constexpr (IS_DOUBLE<M>) {
+		return core::add(d1, d2);
+	} else {
+		// a zero has exponent 0, so the other operand would be rounded at
+		// ADD_SCALE_EXP digits below that (or dropped entirely) further down
+		if (P::to_double(d1.mantissa) == 0) return d2;
+		if (P::to_double(d2.mantissa) == 0) return d1;
+
+		const auto &d_bigger  = d1.exponent > d2.exponent ? d1 : d2;
+		const auto &d_smaller = d1.exponent > d2.exponent ? d2 : d1;
+
+		// same as core::add(), with the type's own digits
+		const auto diff = static_cast<uint64_t>(d_bigger.exponent) - static_cast<uint64_t>(d_smaller.exponent);
+		if (diff >= P::DIGITS) {
+			DECIMAL_COUNT(ADD_EARLY_EXIT);
+			return d_bigger;
+		}
+
+		const auto scale = P::pow10(P::ADD_SCALE_EXP);
+		return normalize(BasicDecimal<M>(
+			P::round(scale * d_bigger.mantissa + scale * d_smaller.mantissa * P::pow10(-static_cast<int64_t>(diff))),
+			d_bigger.exponent - P::ADD_SCALE_EXP
+		));
+	}
+}
+
+template <typename M>
+inline auto sub(const BasicDecimal<M> &d1, const BasicDecimal<M> &d2) -> BasicDecimal<M> {
+	return add(d1, neg(d2));
+}
+
+template <typename M>
+inline auto mul(const BasicDecimal<M> &d1, const BasicDecimal<M> &d2) -> BasicDecimal<M> {
+	if constexpr (IS_DOUBLE<M>) {
+		return core::mul(d1, d2);
+	} else {
+		return normalize(BasicDecimal<M>(d1.mantissa * d2.mantissa, d1.exponent + d2.exponent));
+	}
+}
+
+template <typename M>
+inline auto mul_num(const BasicDecimal<M> &d1, const double d2) -> BasicDecimal<M> {
+	if constexpr (IS_DOUBLE<M>) {
+		return core::mul_num(d1, d2);
+	} else {
+		// d2 can be out of the type's range (1e300 as a float), so it goes
+		// through a normalized decimal first
+		return mul(d1, from_float<M>(d2));
+	}
+}
+
+template <typename M>
+inline auto div(const BasicDecimal<M> &d1, const BasicDecimal<M> &d2) -> BasicDecimal<M> {
+	if constexpr (IS_DOUBLE<M>) {
+		return core::div(d1, d2);
+	} else {
+		return normalize(BasicDecimal<M>(d1.mantissa / d2.mantissa, d1.exponent - d2.exponent));
+	}
+}
+
+template <typename M>
+inline auto cmp(const BasicDecimal<M> &d1, const BasicDecimal<M> &d2) -> int64_t {
+	if constexpr (IS_DOUBLE<M>) {
+		return core::cmp(d1, d2);
+	} else {
+		const auto s1 = sign(d1);
+		const auto s2 = sign(d2);
+
+		if (DECIMAL_UNLIKELY(s1 * s2 != 1)) {
+			return s1 > s2 ? +1 :
+			       s1 < s2 ? -1 :
+			                  0;
+		}
+
+		const auto flip = s1;
+
+		return
+			d1.exponent > d2.exponent ? +1 * flip :
+			d1.exponent < d2.exponent ? -1 * flip :
+			d1.mantissa > d2.mantissa ? +1 :
+			d1.mantissa < d2.mantissa ? -1 :
+			                             0;
+	}
+}
+
+template <typename M>
+inline auto log10(const BasicDecimal<M> &dec) -> double {
+	return dec.exponent + MantissaPolicy<M>::log10(dec.mantissa);
+}
+
+template <typename M>
+inline auto abs_log10(const BasicDecimal<M> &dec) -> double {
+	return log10(abs(dec));
+}
+
+template <typename M>
+inline auto pow10_num(const double exp) -> BasicDecimal<M> {
+	return from_decimal<M>(core::pow10_num(exp));
+}
+
+template <typename M>
+inline auto pow_num(const BasicDecimal<M> &base, const double exp) -> BasicDecimal<M> {
+	if constexpr (IS_DOUBLE<M>) {
+		return core::pow_num(base, exp);
+	} else {
+		return from_decimal<M>(core::pow_num(to_decimal(base), exp));
+	}
+}
+
+template <typename M>
+inline auto sqrt(const BasicDecimal<M> &dec) -> BasicDecimal<M> {
+	using P = MantissaPolicy<M>;
+	if constexpr (IS_DOUBLE<M>) {
+		return core::sqrt(dec);
+	} else {
+		if (sign(dec) < 0) return from_decimal<M>(core::DECIMAL_NAN);
+
+		// an odd exponent moves a 10 into the mantissa, [10, 100) -> [~3.16, 10)
+		if (dec.exponent % 2 != 0) {
+			return BasicDecimal<M>(P::sqrt(dec.mantissa * M(10.0)), (dec.exponent - 1) / 2);
+		}
+		return BasicDecimal<M>(P::sqrt(dec.mantissa), dec.exponent / 2);
+	}
+}
+
+} // namespace decimal_precision
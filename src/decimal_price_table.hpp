@@ -0,0 +1,189 @@
+#pragma once
+
+// The cumulative cost of a decimal_curves::Curve, written down for the first
+// `limit` purchases, so "what do owned a to b cost" is one subtraction and
+// "how many can I afford" a binary search, instead of a pow_num() and a
+// division on every query. Past the end of the table, the queries fall back
+// to the closed forms in decimal_curves.hpp.
+//
+// The table is filled lazily, CHUNK entries at a time, only as far as the
+// queries have needed so far. The running totals are kept with a double-double
+// mantissa (see decimal_precision.hpp): subtracting two big totals to get a
+// small range cancels a lot of digits, and the extra ones keep the difference
+// at full double precision.
+
+#include "decimal_core.hpp"
+#include "decimal_curves.hpp"
+#include "decimal_precision.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace decimal_price_table {
+
+namespace core = decimal_core;
+namespace precision = decimal_precision;
+
+using Total = BasicDecimal<precision::DoubleDouble>;
+
+constexpr const int64_t CHUNK = 128;
+
+struct Table {
+	decimal_curves::Curve curve;
+
+	// owned counts the table covers, 0 to limit. It gets cut short, and
+	// `overflowed` set, when the prices stop being finite.
+	int64_t limit = 0;
+	bool overflowed = false;
+
+	// every purchase costs price_start (a ratio of 1 or nothing added), where
+	// the closed forms divide by zero
+	bool constant = false;
+
+	// totals[i] is what the first i purchases cost together, totals[0] = 0
+	std::vector<Total> totals;
+};
+
+// Prices have to be positive, so that the totals only ever go up, and can't
+// go down from one purchase to the next: a price far below the total so far
+// is lost when it's added, and the difference of two totals is then off by
+// all of it. (A geometric ratio below 1 does exactly that.)
+inline auto make(const decimal_curves::Curve &curve, const int64_t limit) -> Table {
+	Table t;
+	t.curve = curve;
+	t.limit = limit;
+	t.constant = curve.kind == decimal_curves::Kind::GEOMETRIC ?
+		core::eq(curve.price_step, core::DECIMAL_ONE) :
+		curve.price_step.mantissa == 0;
+	t.totals.push_back(Total());
+	return t;
+}
+
+// What the next purchase costs with `owned` already bought. Same as
+// decimal_curves::ratio_pow() for a positive ratio, but saturating, so the
+// table can see where the prices run off to infinity.
+inline auto price(const decimal_curves::Curve &c, const int64_t owned) -> DecimalData {
+	if (c.kind == decimal_curves::Kind::GEOMETRIC) {
+		return core::mul(c.price_start, core::pow10_saturated(static_cast<double>(owned) * c.abs_log10_ratio));
+	}
+	return core::add(c.price_start, core::mul(c.price_step, core::from_float(static_cast<double>(owned))));
+}
+
+inline auto filled(const Table &t) -> int64_t {
+	return static_cast<int64_t>(t.totals.size()) - 1;
+}
+
+// Makes sure totals[n] exists, filling up to the end of its chunk.
+inline auto fill(Table &t, const int64_t n) -> void {
+	if (n <= filled(t)) return;
+
+	const auto end = std::min(t.limit, (n / CHUNK + 1) * CHUNK);
+	t.totals.reserve(end + 1);
+	for (auto i = filled(t); i < end; i++) {
+		const auto p = price(t.curve, i);
+		if (DECIMAL_UNLIKELY(!core::is_finite(p))) {
+			t.limit = i;
+			t.overflowed = true;
+			break;
+		}
+		t.totals.push_back(precision::add(t.totals[i], precision::from_decimal<precision::DoubleDouble>(p)));
+	}
+}
+
+// what buying `num_items` more costs with `owned` already bought, both >= 0
+inline auto cost(Table &t, const int64_t num_items, const int64_t owned) -> DecimalData {
+	if (owned <= t.limit && num_items <= t.limit - owned) {
+		fill(t, owned + num_items);
+		// the fill can cut the limit short
+		if (owned + num_items <= filled(t)) {
+			return precision::to_decimal(precision::sub(t.totals[owned + num_items], t.totals[owned]));
+		}
+	}
+	if (t.overflowed && num_items > 0) {
+		return core::DECIMAL_INF;
+	}
+	if (t.constant) {
+		return core::mul(t.curve.price_start, core::from_float(static_cast<double>(num_items)));
+	}
+	return decimal_curves::cost(t.curve, num_items, owned);
+}
+
+// afford() for an `owned` at or past the end of the table
+inline auto past_table(const Table &t, const DecimalData &res_available, const int64_t owned) -> int64_t {
+	// the prices from here on are infinite
+	if (t.overflowed && owned >= t.limit) {
+		return 0;
+	}
+	if (t.constant) {
+		return decimal_curves::to_count(core::into_float_saturated(core::floor(core::div(res_available, t.curve.price_start))));
+	}
+	return std::max<int64_t>(0, decimal_curves::afford(t.curve, res_available, owned));
+}
+
+// a total rounded to a plain decimal, the double-double's high part
+inline auto rounded(const Total &total) -> DecimalData {
+	return DecimalData(total.mantissa.hi, total.exponent);
+}
+
+// whether buying owned to k costs no more than `budget`, at full precision
+inline auto within(const Table &t, const int64_t owned, const int64_t k, const Total &budget) -> bool {
+	return precision::cmp(precision::sub(t.totals[k], t.totals[owned]), budget) <= 0;
+}
+
+// How many more can be bought with `res_available`, `owned` >= 0. Within the
+// table, that's the exact count for the summed up prices; whatever's left at
+// its end goes to the closed form.
+inline auto afford(Table &t, const DecimalData &res_available, const int64_t owned) -> int64_t {
+	if (DECIMAL_UNLIKELY(!(res_available.mantissa >= 0))) {
+		return 0;
+	}
+	// (infinities don't compare right against the totals, see core::cmp())
+	if (owned >= t.limit || DECIMAL_UNLIKELY(!core::is_finite(res_available))) {
+		return past_table(t, res_available, owned);
+	}
+
+	fill(t, owned);
+	if (owned > filled(t)) {
+		return past_table(t, res_available, owned);
+	}
+
+	// the total that can be reached, then only as much of the table as it
+	// takes. (core::add() would round a tiny budget away against a zero total,
+	// which has exponent 0.)
+	const auto start = rounded(t.totals[owned]);
+	const auto target = start.mantissa == 0 ? res_available : core::add(start, res_available);
+	while (filled(t) < t.limit && core::cmp(rounded(t.totals.back()), target) <= 0) {
+		fill(t, filled(t) + 1);
+	}
+
+	// the last k with totals[k] <= target, totals[owned] always is
+	const auto begin = t.totals.begin() + owned;
+	const auto it = std::upper_bound(begin, t.totals.end(), target, [](const DecimalData &x, const Total &y) {
+		return core::cmp(x, rounded(y)) < 0;
+	});
+	auto k = owned + (it - begin) - 1;
+
+	// The search went by rounded totals, which can be an ulp or two off right
+	// at a boundary. Those get settled with the exact ones.
+	constexpr const auto CLOSE = DecimalData(1.0, -14);
+	const auto budget = precision::from_decimal<precision::DoubleDouble>(res_available);
+	while (k > owned && core::eq_tolerance_rel(rounded(t.totals[k]), target, CLOSE) && !within(t, owned, k, budget)) {
+		k--;
+	}
+	while (k < filled(t) && core::eq_tolerance_rel(rounded(t.totals[k + 1]), target, CLOSE) && within(t, owned, k + 1, budget)) {
+		k++;
+	}
+
+	const auto count = k - owned;
+	if (k < t.limit) {
+		return count;
+	}
+
+	// affordable up to the end of the table, the rest of the budget goes on
+	const auto left = precision::to_decimal(precision::sub(budget, precision::sub(t.totals[k], t.totals[owned])));
+	const auto more = past_table(t, left, k);
+	return more > INT64_MAX - count ? INT64_MAX : count + more;
+}
+
+} // namespace decimal_price_table
@@ -0,0 +1,110 @@
+#include "decimal_purchase_planner.hpp"
+#include "godot_cpp/core/error_macros.hpp"
+#include "godot_cpp/core/object.hpp"
+#include <cstdint>
+#include <godot_cpp/core/class_db.hpp>
+
+using namespace godot;
+
+namespace core = decimal_core;
+
+using decimal_planner::Curve;
+
+auto DecimalPurchasePlanner::_bind_methods() -> void {
+	ClassDB::bind_method(D_METHOD("add_geometric", "price_start", "price_ratio", "delta_rps", "owned"), &DecimalPurchasePlanner::add_geometric, DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("add_arithmetic", "price_start", "price_add", "delta_rps", "owned"), &DecimalPurchasePlanner::add_arithmetic, DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("size"), &DecimalPurchasePlanner::size);
+	ClassDB::bind_method(D_METHOD("clear"), &DecimalPurchasePlanner::clear);
+
+	ClassDB::bind_method(D_METHOD("get_owned", "idx"), &DecimalPurchasePlanner::get_owned);
+	ClassDB::bind_method(D_METHOD("set_owned", "idx", "owned"), &DecimalPurchasePlanner::set_owned);
+	ClassDB::bind_method(D_METHOD("get_delta_rps", "idx"), &DecimalPurchasePlanner::get_delta_rps);
+	ClassDB::bind_method(D_METHOD("set_delta_rps", "idx", "delta_rps"), &DecimalPurchasePlanner::set_delta_rps);
+	ClassDB::bind_method(D_METHOD("get_cost", "idx"), &DecimalPurchasePlanner::get_cost);
+
+	ClassDB::bind_method(D_METHOD("plan", "budget", "current_rps", "max_purchases"), &DecimalPurchasePlanner::plan, DEFVAL(1000));
+	ClassDB::bind_method(D_METHOD("get_planned_cost"), &DecimalPurchasePlanner::get_planned_cost);
+	ClassDB::bind_method(D_METHOD("get_planned_rps"), &DecimalPurchasePlanner::get_planned_rps);
+}
+
+auto DecimalPurchasePlanner::add_upgrade(const Curve curve, const Vector4i price_start, const Vector4i price_step, const Vector4i delta_rps, const int64_t owned) -> int64_t {
+	decimal_planner::Upgrade up;
+	up.curve = curve;
+	up.price_start = to_decimal(price_start);
+	up.price_step = to_decimal(price_step);
+	up.delta_rps = to_decimal(delta_rps);
+	up.owned = owned;
+
+	upgrades.push_back(up);
+	return size() - 1;
+}
+
+auto DecimalPurchasePlanner::add_geometric(const Vector4i price_start, const Vector4i price_ratio, const Vector4i delta_rps, const int64_t owned) -> int64_t {
+	ERR_FAIL_COND_V_MSG(owned < 0, -1, "DecimalPurchasePlanner.add_geometric() - `owned` cannot be negative.");
+	return add_upgrade(Curve::GEOMETRIC, price_start, price_ratio, delta_rps, owned);
+}
+
+auto DecimalPurchasePlanner::add_arithmetic(const Vector4i price_start, const Vector4i price_add, const Vector4i delta_rps, const int64_t owned) -> int64_t {
+	ERR_FAIL_COND_V_MSG(owned < 0, -1, "DecimalPurchasePlanner.add_arithmetic() - `owned` cannot be negative.");
+	return add_upgrade(Curve::ARITHMETIC, price_start, price_add, delta_rps, owned);
+}
+
+auto DecimalPurchasePlanner::size() const -> int64_t {
+	return static_cast<int64_t>(upgrades.size());
+}
+
+auto DecimalPurchasePlanner::clear() -> void {
+	upgrades.clear();
+}
+
+auto DecimalPurchasePlanner::get_owned(const int64_t idx) const -> int64_t {
+	ERR_FAIL_INDEX_V_MSG(idx, size(), 0, "DecimalPurchasePlanner.get_owned() - index out of bounds.");
+	return upgrades[idx].owned;
+}
+
+auto DecimalPurchasePlanner::set_owned(const int64_t idx, const int64_t owned) -> void {
+	ERR_FAIL_INDEX_MSG(idx, size(), "DecimalPurchasePlanner.set_owned() - index out of bounds.");
+	ERR_FAIL_COND_MSG(owned < 0, "DecimalPurchasePlanner.set_owned() - `owned` cannot be negative.");
+	upgrades[idx].owned = owned;
+}
+
+auto DecimalPurchasePlanner::get_delta_rps(const int64_t idx) const -> Vector4i {
+	ERR_FAIL_INDEX_V_MSG(idx, size(), Vector4i(), "DecimalPurchasePlanner.get_delta_rps() - index out of bounds.");
+	return to_vector4i(upgrades[idx].delta_rps);
+}
+
+auto DecimalPurchasePlanner::set_delta_rps(const int64_t idx, const Vector4i delta_rps) -> void {
+	ERR_FAIL_INDEX_MSG(idx, size(), "DecimalPurchasePlanner.set_delta_rps() - index out of bounds.");
+	upgrades[idx].delta_rps = to_decimal(delta_rps);
+}
+
+auto DecimalPurchasePlanner::get_cost(const int64_t idx) const -> Vector4i {
+	ERR_FAIL_INDEX_V_MSG(idx, size(), Vector4i(), "DecimalPurchasePlanner.get_cost() - index out of bounds.");
+	return to_vector4i(decimal_planner::cost_at(upgrades[idx], upgrades[idx].owned));
+}
+
+auto DecimalPurchasePlanner::plan(const Vector4i budget, const Vector4i current_rps, const int64_t max_purchases) -> PackedInt64Array {
+	const auto rps = to_decimal(current_rps);
+	ERR_FAIL_COND_V_MSG(core::sign(rps) <= 0 || !core::is_finite(rps), PackedInt64Array(),
+		"DecimalPurchasePlanner.plan() - `current_rps` has to be positive."
+	);
+	ERR_FAIL_COND_V_MSG(max_purchases < 0, PackedInt64Array(), "DecimalPurchasePlanner.plan() - `max_purchases` cannot be negative.");
+
+	decimal_planner::plan(upgrades, to_decimal(budget), rps, max_purchases, tree, last_plan);
+
+	PackedInt64Array res;
+	res.resize(static_cast<int64_t>(last_plan.purchases.size()));
+	auto *dst = res.ptrw();
+	for (size_t i = 0; i < last_plan.purchases.size(); i++) {
+		dst[i] = last_plan.purchases[i];
+	}
+	return res;
+}
+
+auto DecimalPurchasePlanner::get_planned_cost() const -> Vector4i {
+	return to_vector4i(last_plan.spent);
+}
+
+auto DecimalPurchasePlanner::get_planned_rps() const -> Vector4i {
+	return to_vector4i(last_plan.rps);
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "godot_cpp/classes/ref_counted.hpp"
+#include "godot_cpp/variant/packed_int64_array.hpp"
+#include "godot_cpp/variant/vector4i.hpp"
+
+#include "decimal.hpp"
+#include "decimal_planner.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace godot;
+
+// Works out what an auto-buyer should buy with a given budget, in order (see
+// decimal_planner.hpp for how). The upgrades are registered once, and only
+// their owned counts and rps gains need updating as the game goes on.
+class DecimalPurchasePlanner : public RefCounted {
+
+	GDCLASS(DecimalPurchasePlanner, RefCounted)
+
+protected:
+	static auto _bind_methods() -> void;
+
+private:
+	std::vector<decimal_planner::Upgrade> upgrades;
+	decimal_planner::Tournament tree;
+	decimal_planner::Plan last_plan;
+
+	auto add_upgrade(const decimal_planner::Curve curve, const Vector4i price_start, const Vector4i price_step, const Vector4i delta_rps, const int64_t owned) -> int64_t;
+
+public:
+	auto add_geometric(const Vector4i price_start, const Vector4i price_ratio, const Vector4i delta_rps, const int64_t owned) -> int64_t;
+	auto add_arithmetic(const Vector4i price_start, const Vector4i price_add, const Vector4i delta_rps, const int64_t owned) -> int64_t;
+	auto size() const -> int64_t;
+	auto clear() -> void;
+
+	auto get_owned(const int64_t idx) const -> int64_t;
+	auto set_owned(const int64_t idx, const int64_t owned) -> void;
+	auto get_delta_rps(const int64_t idx) const -> Vector4i;
+	auto set_delta_rps(const int64_t idx, const Vector4i delta_rps) -> void;
+	auto get_cost(const int64_t idx) const -> Vector4i;
+
+	auto plan(const Vector4i budget, const Vector4i current_rps, const int64_t max_purchases) -> PackedInt64Array;
+	auto get_planned_cost() const -> Vector4i;
+	auto get_planned_rps() const -> Vector4i;
+};
@@ -0,0 +1,917 @@
+#include "decimal_simd.hpp"
+#include "decimal_constants.hpp"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#if !defined(DECIMAL_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(__clang__))
+	#define DECIMAL_SIMD_X86 1
+	#include <immintrin.h>
+
+	#define DECIMAL_TARGET_SSE42 __attribute__((target("sse4.2")))
+	#define DECIMAL_TARGET_AVX2 __attribute__((target("avx2")))
+	#define DECIMAL_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+	#define DECIMAL_SIMD_X86 0
+#endif
+
+// If the compiler fuses a multiply and an add in one path but not the
+// other, the results stop being bit-identical. So the builds turn that off
+// with -ffp-contract=off, for every file: the scalar path is the inline
+// decimal_core code, and all copies of it have to compile the same way.
+
+namespace decimal_simd {
+
+namespace {
+
+using decimal_core::LOG10_2_MUL;
+using decimal_core::LOG10_2_SHIFT;
+using decimal_core::LOG10_2_BIAS;
+using decimal_core::DOUBLE_BIAS;
+using decimal_core::DOUBLE_EXP_SPECIAL;
+using decimal_core::POW10_EXACT_MAX;
+
+constexpr const double ADD_SCALE = 1e14;
+constexpr const int64_t ADD_SCALE_EXP = 14;
+
+// The scalar paths are the core functions themselves, which is what every
+// SIMD path has to match bit for bit.
+inline auto normalize_one(const DecimalData &dec) -> DecimalData {
+	return decimal_core::normalize(dec);
+}
+
+inline auto add_one(const DecimalData &d1, const DecimalData &d2) -> DecimalData {
+	return decimal_core::add(d1, d2);
+}
+
+auto normalize_scalar(const DecimalData *src, DecimalData *dst, const int64_t n) -> void {
+	for (int64_t i = 0; i < n; i++) {
+		dst[i] = normalize_one(src[i]);
+	}
+}
+
+auto add_scalar(const DecimalData *a, const DecimalData *b, DecimalData *dst, const int64_t n, const bool negate_b) -> void {
+	for (int64_t i = 0; i < n; i++) {
+		const auto rhs = negate_b ? DecimalData(-b[i].mantissa, b[i].exponent) : b[i];
+		dst[i] = add_one(a[i], rhs);
+	}
+}
+
+auto mul_scalar(const DecimalData *a, const DecimalData *b, DecimalData *dst, const int64_t n) -> void {
+	for (int64_t i = 0; i < n; i++) {
+		dst[i] = normalize_one(DecimalData(
+			a[i].mantissa * b[i].mantissa,
+			a[i].exponent + b[i].exponent
+		));
+	}
+}
+
+auto mul_num_scalar(const DecimalData *a, const double b, DecimalData *dst, const int64_t n) -> void {
+	for (int64_t i = 0; i < n; i++) {
+		dst[i] = normalize_one(DecimalData(
+			a[i].mantissa * b,
+			a[i].exponent
+		));
+	}
+}
+
+
+// `b` is a single value when `broadcast` is set, and `reverse` compares
+// b >= a instead. `a` and `mask` start on a byte boundary of the mask. The compiler already turns the exponent and
+// mantissa compares of cmp() into conditional moves here, which measured
+// faster than spelling out the lane logic below with flags.
+auto ge_mask_scalar(const DecimalData *a, const DecimalData *b, const bool broadcast, const bool reverse, uint8_t *mask, const int64_t n) -> void {
+	const auto step = broadcast ? 0 : 1;
+	for (int64_t i = 0; i < n; i += 8) {
+		const auto count = n - i < 8 ? n - i : 8;
+		uint32_t bits = 0;
+		for (int64_t j = 0; j < count; j++) {
+			const auto &lhs = a[i + j];
+			const auto &rhs = b[(i + j) * step];
+			bits |= static_cast<uint32_t>(reverse ? decimal_core::ge(rhs, lhs) : decimal_core::ge(lhs, rhs)) << j;
+		}
+		mask[i / 8] = static_cast<uint8_t>(bits);
+	}
+}
+
+#if DECIMAL_SIMD_X86
+
+// ----------------------------------------------------------------------------
+// SSE4.2 (2 lanes). 4.2 is the first one with a 64-bit integer compare.
+// ----------------------------------------------------------------------------
+
+DECIMAL_TARGET_SSE42 inline auto load_sse42(const DecimalData *p, __m128d &m, __m128i &e) -> void {
+	const auto *d = reinterpret_cast<const double *>(p);
+	const auto lo = _mm_loadu_pd(d);
+	const auto hi = _mm_loadu_pd(d + 2);
+	m = _mm_unpacklo_pd(lo, hi);
+	e = _mm_castpd_si128(_mm_unpackhi_pd(lo, hi));
+}
+
+DECIMAL_TARGET_SSE42 inline auto store_sse42(DecimalData *p, const __m128d m, const __m128i e) -> void {
+	auto *d = reinterpret_cast<double *>(p);
+	const auto e_pd = _mm_castsi128_pd(e);
+	_mm_storeu_pd(d, _mm_unpacklo_pd(m, e_pd));
+	_mm_storeu_pd(d + 2, _mm_unpackhi_pd(m, e_pd));
+}
+
+DECIMAL_TARGET_SSE42 inline auto pow10_sse42(const __m128i idx) -> __m128d {
+	// no gather instructions here
+	return _mm_set_pd(
+		POW10_LOOKUP[_mm_extract_epi64(idx, 1)],
+		POW10_LOOKUP[_mm_cvtsi128_si64(idx)]
+	);
+}
+
+// std::round() rounds halfway cases away from zero, which no SIMD rounding mode does
+DECIMAL_TARGET_SSE42 inline auto round_sse42(const __m128d x) -> __m128d {
+	const auto sign = _mm_set1_pd(-0.0);
+	const auto t = _mm_round_pd(x, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+	const auto frac = _mm_andnot_pd(sign, _mm_sub_pd(x, t));
+	const auto step = _mm_or_pd(_mm_and_pd(x, sign), _mm_set1_pd(1.0));
+	return _mm_blendv_pd(t, _mm_add_pd(t, step), _mm_cmpge_pd(frac, _mm_set1_pd(0.5)));
+}
+
+// Returns a lane mask of the lanes that have to go through the scalar path.
+DECIMAL_TARGET_SSE42 inline auto normalize_lanes_sse42(__m128d &m, __m128i &e) -> int {
+	const auto abs = _mm_andnot_pd(_mm_set1_pd(-0.0), m);
+	const auto bexp = _mm_srli_epi64(_mm_castpd_si128(abs), 52);
+	const auto special = _mm_or_si128(
+		_mm_cmpeq_epi64(bexp, _mm_setzero_si128()),
+		_mm_cmpeq_epi64(bexp, _mm_set1_epi64x(DOUBLE_EXP_SPECIAL))
+	);
+
+	// keep special lanes from indexing outside of the table, their results get discarded anyway
+	const auto clamped = _mm_max_epi32(_mm_min_epi32(bexp, _mm_set1_epi64x(DOUBLE_EXP_SPECIAL - 1)), _mm_set1_epi64x(1));
+	const auto exp2 = _mm_sub_epi64(clamped, _mm_set1_epi64x(DOUBLE_BIAS));
+	const auto prod = _mm_add_epi64(
+		_mm_mul_epi32(exp2, _mm_set1_epi64x(LOG10_2_MUL)),
+		_mm_set1_epi64x(LOG10_2_BIAS << LOG10_2_SHIFT)
+	);
+	auto exp10 = _mm_sub_epi64(_mm_srli_epi64(prod, LOG10_2_SHIFT), _mm_set1_epi64x(LOG10_2_BIAS));
+
+	const auto upper = pow10_sse42(_mm_add_epi64(exp10, _mm_set1_epi64x(POW10_OFFSET + 1)));
+	exp10 = _mm_sub_epi64(exp10, _mm_castpd_si128(_mm_cmpge_pd(abs, upper)));
+
+	// same split as decimal_core::scale_pow10()
+	const auto exact = _mm_and_si128(
+		_mm_cmpgt_epi64(exp10, _mm_setzero_si128()),
+		_mm_cmpgt_epi64(_mm_set1_epi64x(POW10_EXACT_MAX + 1), exp10)
+	);
+	// 10^k for the lanes that divide, 10^-k for the ones that multiply
+	const auto scale = pow10_sse42(_mm_add_epi64(
+		_mm_set1_epi64x(POW10_OFFSET),
+		_mm_blendv_epi8(_mm_sub_epi64(_mm_setzero_si128(), exp10), exp10, exact)
+	));
+	m = _mm_blendv_pd(_mm_mul_pd(m, scale), _mm_div_pd(m, scale), _mm_castsi128_pd(exact));
+	e = _mm_add_epi64(e, exp10);
+
+	// mantissas that got rounded out of [1, 10) are fixed up by the scalar path
+	const auto res_abs = _mm_andnot_pd(_mm_set1_pd(-0.0), m);
+	const auto out_of_range = _mm_or_pd(
+		_mm_cmplt_pd(res_abs, _mm_set1_pd(1.0)),
+		_mm_cmpge_pd(res_abs, _mm_set1_pd(10.0))
+	);
+
+	return _mm_movemask_pd(_mm_or_pd(_mm_castsi128_pd(special), out_of_range));
+}
+
+DECIMAL_TARGET_SSE42 auto normalize_sse42(const DecimalData *src, DecimalData *dst, const int64_t n) -> void {
+	int64_t i = 0;
+	for (; i + 2 <= n; i += 2) {
+		__m128d m;
+		__m128i e;
+		load_sse42(src + i, m, e);
+
+		if (normalize_lanes_sse42(m, e)) {
+			normalize_scalar(src + i, dst + i, 2);
+			continue;
+		}
+		store_sse42(dst + i, m, e);
+	}
+	normalize_scalar(src + i, dst + i, n - i);
+}
+
+DECIMAL_TARGET_SSE42 auto add_sse42(const DecimalData *a, const DecimalData *b, DecimalData *dst, const int64_t n, const bool negate_b) -> void {
+	const auto flip = negate_b ? _mm_set1_pd(-0.0) : _mm_setzero_pd();
+
+	int64_t i = 0;
+	for (; i + 2 <= n; i += 2) {
+		__m128d m1, m2;
+		__m128i e1, e2;
+		load_sse42(a + i, m1, e1);
+		load_sse42(b + i, m2, e2);
+		m2 = _mm_xor_pd(m2, flip);
+
+		const auto first_bigger = _mm_cmpgt_epi64(e1, e2);
+		const auto first_bigger_pd = _mm_castsi128_pd(first_bigger);
+
+		const auto big_m = _mm_blendv_pd(m2, m1, first_bigger_pd);
+		const auto small_m = _mm_blendv_pd(m1, m2, first_bigger_pd);
+		const auto big_e = _mm_blendv_epi8(e2, e1, first_bigger);
+		const auto small_e = _mm_blendv_epi8(e1, e2, first_bigger);
+
+		// unsigned diff >= MAX_SIGNIFICANT_DIGITS, done with a signed compare
+		const auto diff = _mm_sub_epi64(big_e, small_e);
+		const auto far = _mm_cmpgt_epi64(
+			_mm_xor_si128(diff, _mm_set1_epi64x(INT64_MIN)),
+			_mm_set1_epi64x(INT64_MIN + MAX_SIGNIFICANT_DIGITS - 1)
+		);
+
+		const auto idx = _mm_blendv_epi8(
+			_mm_sub_epi64(_mm_set1_epi64x(POW10_OFFSET), diff),
+			_mm_set1_epi64x(POW10_OFFSET),
+			far
+		);
+
+		const auto scale = _mm_set1_pd(ADD_SCALE);
+		auto m = round_sse42(_mm_add_pd(
+			_mm_mul_pd(scale, big_m),
+			_mm_mul_pd(_mm_mul_pd(scale, small_m), pow10_sse42(idx))
+		));
+		auto e = _mm_sub_epi64(big_e, _mm_set1_epi64x(ADD_SCALE_EXP));
+
+		const auto far_mask = _mm_movemask_pd(_mm_castsi128_pd(far));
+		if (normalize_lanes_sse42(m, e) & ~far_mask) {
+			add_scalar(a + i, b + i, dst + i, 2, negate_b);
+			continue;
+		}
+
+		m = _mm_blendv_pd(m, big_m, _mm_castsi128_pd(far));
+		e = _mm_blendv_epi8(e, big_e, far);
+		store_sse42(dst + i, m, e);
+	}
+	add_scalar(a + i, b + i, dst + i, n - i, negate_b);
+}
+
+DECIMAL_TARGET_SSE42 auto mul_sse42(const DecimalData *a, const DecimalData *b, DecimalData *dst, const int64_t n) -> void {
+	int64_t i = 0;
+	for (; i + 2 <= n; i += 2) {
+		__m128d m1, m2;
+		__m128i e1, e2;
+		load_sse42(a + i, m1, e1);
+		load_sse42(b + i, m2, e2);
+
+		auto m = _mm_mul_pd(m1, m2);
+		auto e = _mm_add_epi64(e1, e2);
+
+		if (normalize_lanes_sse42(m, e)) {
+			mul_scalar(a + i, b + i, dst + i, 2);
+			continue;
+		}
+		store_sse42(dst + i, m, e);
+	}
+	mul_scalar(a + i, b + i, dst + i, n - i);
+}
+
+DECIMAL_TARGET_SSE42 auto mul_num_sse42(const DecimalData *a, const double b, DecimalData *dst, const int64_t n) -> void {
+	const auto factor = _mm_set1_pd(b);
+
+	int64_t i = 0;
+	for (; i + 2 <= n; i += 2) {
+		__m128d m;
+		__m128i e;
+		load_sse42(a + i, m, e);
+
+		m = _mm_mul_pd(m, factor);
+
+		if (normalize_lanes_sse42(m, e)) {
+			mul_num_scalar(a + i, b, dst + i, 2);
+			continue;
+		}
+		store_sse42(dst + i, m, e);
+	}
+	mul_num_scalar(a + i, b, dst + i, n - i);
+}
+
+// decimal_core::ge() without branches, one bit per lane: the signs decide
+// unless they're equal and non-zero, then the exponents decide unless they're
+// equal (flipped for negatives), then the mantissas do. The ordered compares
+// make NaN count as zero, like sign() does in cmp().
+DECIMAL_TARGET_SSE42 inline auto ge_lanes_sse42(const __m128d m1, const __m128i e1, const __m128d m2, const __m128i e2) -> int {
+	const auto zero = _mm_setzero_pd();
+	const auto ones = _mm_set1_epi64x(-1);
+	const auto pos1 = _mm_castpd_si128(_mm_cmpgt_pd(m1, zero));
+	const auto neg1 = _mm_castpd_si128(_mm_cmplt_pd(m1, zero));
+	const auto pos2 = _mm_castpd_si128(_mm_cmpgt_pd(m2, zero));
+	const auto neg2 = _mm_castpd_si128(_mm_cmplt_pd(m2, zero));
+
+	const auto sign_gt = _mm_or_si128(_mm_andnot_si128(pos2, pos1), _mm_andnot_si128(neg1, neg2));
+	const auto sign_eq = _mm_andnot_si128(_mm_or_si128(_mm_xor_si128(pos1, pos2), _mm_xor_si128(neg1, neg2)), ones);
+	const auto both_zero = _mm_andnot_si128(_mm_or_si128(pos1, neg1), ones);
+
+	const auto exp_eq = _mm_cmpeq_epi64(e1, e2);
+	const auto exp_gt = _mm_cmpgt_epi64(e1, e2);
+	const auto mant_lt = _mm_castpd_si128(_mm_cmplt_pd(m1, m2));
+	const auto magnitude_ge = _mm_or_si128(
+		_mm_andnot_si128(mant_lt, exp_eq),
+		_mm_andnot_si128(_mm_or_si128(exp_eq, _mm_xor_si128(exp_gt, pos1)), ones)
+	);
+
+	const auto ge = _mm_or_si128(sign_gt, _mm_and_si128(sign_eq, _mm_or_si128(both_zero, magnitude_ge)));
+	return _mm_movemask_pd(_mm_castsi128_pd(ge));
+}
+
+DECIMAL_TARGET_SSE42 auto ge_mask_sse42(const DecimalData *a, const DecimalData *b, const bool broadcast, const bool reverse, uint8_t *mask, const int64_t n) -> void {
+	auto m2 = _mm_set1_pd(b->mantissa);
+	auto e2 = _mm_set1_epi64x(b->exponent);
+
+	int64_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		int bits = 0;
+		for (int lane = 0; lane < 8; lane += 2) {
+			__m128d m1;
+			__m128i e1;
+			load_sse42(a + i + lane, m1, e1);
+			if (!broadcast) {
+				load_sse42(b + i + lane, m2, e2);
+			}
+			bits |= (reverse ? ge_lanes_sse42(m2, e2, m1, e1) : ge_lanes_sse42(m1, e1, m2, e2)) << lane;
+		}
+		mask[i / 8] = static_cast<uint8_t>(bits);
+	}
+	ge_mask_scalar(a + i, broadcast ? b : b + i, broadcast, reverse, mask + i / 8, n - i);
+}
+
+// ----------------------------------------------------------------------------
+// AVX2 (4 lanes). Unpacking within 128-bit halves shuffles the element order
+// to 0 2 1 3, which doesn't matter since every lane is independent and the
+// store undoes it.
+// ----------------------------------------------------------------------------
+
+DECIMAL_TARGET_AVX2 inline auto load_avx2(const DecimalData *p, __m256d &m, __m256i &e) -> void {
+	const auto *d = reinterpret_cast<const double *>(p);
+	const auto lo = _mm256_loadu_pd(d);
+	const auto hi = _mm256_loadu_pd(d + 4);
+	m = _mm256_unpacklo_pd(lo, hi);
+	e = _mm256_castpd_si256(_mm256_unpackhi_pd(lo, hi));
+}
+
+DECIMAL_TARGET_AVX2 inline auto store_avx2(DecimalData *p, const __m256d m, const __m256i e) -> void {
+	auto *d = reinterpret_cast<double *>(p);
+	const auto e_pd = _mm256_castsi256_pd(e);
+	_mm256_storeu_pd(d, _mm256_unpacklo_pd(m, e_pd));
+	_mm256_storeu_pd(d + 4, _mm256_unpackhi_pd(m, e_pd));
+}
+
+DECIMAL_TARGET_AVX2 inline auto pow10_avx2(const __m256i idx) -> __m256d {
+	return _mm256_i64gather_pd(POW10_LOOKUP, idx, sizeof(double));
+}
+
+DECIMAL_TARGET_AVX2 inline auto round_avx2(const __m256d x) -> __m256d {
+	const auto sign = _mm256_set1_pd(-0.0);
+	const auto t = _mm256_round_pd(x, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+	const auto frac = _mm256_andnot_pd(sign, _mm256_sub_pd(x, t));
+	const auto step = _mm256_or_pd(_mm256_and_pd(x, sign), _mm256_set1_pd(1.0));
+	return _mm256_blendv_pd(t, _mm256_add_pd(t, step), _mm256_cmp_pd(frac, _mm256_set1_pd(0.5), _CMP_GE_OQ));
+}
+
+DECIMAL_TARGET_AVX2 inline auto normalize_lanes_avx2(__m256d &m, __m256i &e) -> int {
+	const auto abs = _mm256_andnot_pd(_mm256_set1_pd(-0.0), m);
+	const auto bexp = _mm256_srli_epi64(_mm256_castpd_si256(abs), 52);
+	const auto special = _mm256_or_si256(
+		_mm256_cmpeq_epi64(bexp, _mm256_setzero_si256()),
+		_mm256_cmpeq_epi64(bexp, _mm256_set1_epi64x(DOUBLE_EXP_SPECIAL))
+	);
+
+	const auto clamped = _mm256_max_epi32(_mm256_min_epi32(bexp, _mm256_set1_epi64x(DOUBLE_EXP_SPECIAL - 1)), _mm256_set1_epi64x(1));
+	const auto exp2 = _mm256_sub_epi64(clamped, _mm256_set1_epi64x(DOUBLE_BIAS));
+	const auto prod = _mm256_add_epi64(
+		_mm256_mul_epi32(exp2, _mm256_set1_epi64x(LOG10_2_MUL)),
+		_mm256_set1_epi64x(LOG10_2_BIAS << LOG10_2_SHIFT)
+	);
+	auto exp10 = _mm256_sub_epi64(_mm256_srli_epi64(prod, LOG10_2_SHIFT), _mm256_set1_epi64x(LOG10_2_BIAS));
+
+	const auto upper = pow10_avx2(_mm256_add_epi64(exp10, _mm256_set1_epi64x(POW10_OFFSET + 1)));
+	exp10 = _mm256_sub_epi64(exp10, _mm256_castpd_si256(_mm256_cmp_pd(abs, upper, _CMP_GE_OQ)));
+
+	const auto exact = _mm256_and_si256(
+		_mm256_cmpgt_epi64(exp10, _mm256_setzero_si256()),
+		_mm256_cmpgt_epi64(_mm256_set1_epi64x(POW10_EXACT_MAX + 1), exp10)
+	);
+	const auto scale = pow10_avx2(_mm256_add_epi64(
+		_mm256_set1_epi64x(POW10_OFFSET),
+		_mm256_blendv_epi8(_mm256_sub_epi64(_mm256_setzero_si256(), exp10), exp10, exact)
+	));
+	m = _mm256_blendv_pd(_mm256_mul_pd(m, scale), _mm256_div_pd(m, scale), _mm256_castsi256_pd(exact));
+	e = _mm256_add_epi64(e, exp10);
+
+	const auto res_abs = _mm256_andnot_pd(_mm256_set1_pd(-0.0), m);
+	const auto out_of_range = _mm256_or_pd(
+		_mm256_cmp_pd(res_abs, _mm256_set1_pd(1.0), _CMP_LT_OQ),
+		_mm256_cmp_pd(res_abs, _mm256_set1_pd(10.0), _CMP_GE_OQ)
+	);
+
+	return _mm256_movemask_pd(_mm256_or_pd(_mm256_castsi256_pd(special), out_of_range));
+}
+
+DECIMAL_TARGET_AVX2 auto normalize_avx2(const DecimalData *src, DecimalData *dst, const int64_t n) -> void {
+	int64_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m256d m;
+		__m256i e;
+		load_avx2(src + i, m, e);
+
+		if (normalize_lanes_avx2(m, e)) {
+			normalize_scalar(src + i, dst + i, 4);
+			continue;
+		}
+		store_avx2(dst + i, m, e);
+	}
+	normalize_scalar(src + i, dst + i, n - i);
+}
+
+DECIMAL_TARGET_AVX2 auto add_avx2(const DecimalData *a, const DecimalData *b, DecimalData *dst, const int64_t n, const bool negate_b) -> void {
+	const auto flip = negate_b ? _mm256_set1_pd(-0.0) : _mm256_setzero_pd();
+
+	int64_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m256d m1, m2;
+		__m256i e1, e2;
+		load_avx2(a + i, m1, e1);
+		load_avx2(b + i, m2, e2);
+		m2 = _mm256_xor_pd(m2, flip);
+
+		const auto first_bigger = _mm256_cmpgt_epi64(e1, e2);
+		const auto first_bigger_pd = _mm256_castsi256_pd(first_bigger);
+
+		const auto big_m = _mm256_blendv_pd(m2, m1, first_bigger_pd);
+		const auto small_m = _mm256_blendv_pd(m1, m2, first_bigger_pd);
+		const auto big_e = _mm256_blendv_epi8(e2, e1, first_bigger);
+		const auto small_e = _mm256_blendv_epi8(e1, e2, first_bigger);
+
+		const auto diff = _mm256_sub_epi64(big_e, small_e);
+		const auto far = _mm256_cmpgt_epi64(
+			_mm256_xor_si256(diff, _mm256_set1_epi64x(INT64_MIN)),
+			_mm256_set1_epi64x(INT64_MIN + MAX_SIGNIFICANT_DIGITS - 1)
+		);
+
+		const auto idx = _mm256_blendv_epi8(
+			_mm256_sub_epi64(_mm256_set1_epi64x(POW10_OFFSET), diff),
+			_mm256_set1_epi64x(POW10_OFFSET),
+			far
+		);
+
+		const auto scale = _mm256_set1_pd(ADD_SCALE);
+		auto m = round_avx2(_mm256_add_pd(
+			_mm256_mul_pd(scale, big_m),
+			_mm256_mul_pd(_mm256_mul_pd(scale, small_m), pow10_avx2(idx))
+		));
+		auto e = _mm256_sub_epi64(big_e, _mm256_set1_epi64x(ADD_SCALE_EXP));
+
+		const auto far_mask = _mm256_movemask_pd(_mm256_castsi256_pd(far));
+		if (normalize_lanes_avx2(m, e) & ~far_mask) {
+			add_scalar(a + i, b + i, dst + i, 4, negate_b);
+			continue;
+		}
+
+		m = _mm256_blendv_pd(m, big_m, _mm256_castsi256_pd(far));
+		e = _mm256_blendv_epi8(e, big_e, far);
+		store_avx2(dst + i, m, e);
+	}
+	add_scalar(a + i, b + i, dst + i, n - i, negate_b);
+}
+
+DECIMAL_TARGET_AVX2 auto mul_avx2(const DecimalData *a, const DecimalData *b, DecimalData *dst, const int64_t n) -> void {
+	int64_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m256d m1, m2;
+		__m256i e1, e2;
+		load_avx2(a + i, m1, e1);
+		load_avx2(b + i, m2, e2);
+
+		auto m = _mm256_mul_pd(m1, m2);
+		auto e = _mm256_add_epi64(e1, e2);
+
+		if (normalize_lanes_avx2(m, e)) {
+			mul_scalar(a + i, b + i, dst + i, 4);
+			continue;
+		}
+		store_avx2(dst + i, m, e);
+	}
+	mul_scalar(a + i, b + i, dst + i, n - i);
+}
+
+DECIMAL_TARGET_AVX2 auto mul_num_avx2(const DecimalData *a, const double b, DecimalData *dst, const int64_t n) -> void {
+	const auto factor = _mm256_set1_pd(b);
+
+	int64_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m256d m;
+		__m256i e;
+		load_avx2(a + i, m, e);
+
+		m = _mm256_mul_pd(m, factor);
+
+		if (normalize_lanes_avx2(m, e)) {
+			mul_num_scalar(a + i, b, dst + i, 4);
+			continue;
+		}
+		store_avx2(dst + i, m, e);
+	}
+	mul_num_scalar(a + i, b, dst + i, n - i);
+}
+
+DECIMAL_TARGET_AVX2 inline auto ge_lanes_avx2(const __m256d m1, const __m256i e1, const __m256d m2, const __m256i e2) -> int {
+	const auto zero = _mm256_setzero_pd();
+	const auto ones = _mm256_set1_epi64x(-1);
+	const auto pos1 = _mm256_castpd_si256(_mm256_cmp_pd(m1, zero, _CMP_GT_OQ));
+	const auto neg1 = _mm256_castpd_si256(_mm256_cmp_pd(m1, zero, _CMP_LT_OQ));
+	const auto pos2 = _mm256_castpd_si256(_mm256_cmp_pd(m2, zero, _CMP_GT_OQ));
+	const auto neg2 = _mm256_castpd_si256(_mm256_cmp_pd(m2, zero, _CMP_LT_OQ));
+
+	const auto sign_gt = _mm256_or_si256(_mm256_andnot_si256(pos2, pos1), _mm256_andnot_si256(neg1, neg2));
+	const auto sign_eq = _mm256_andnot_si256(_mm256_or_si256(_mm256_xor_si256(pos1, pos2), _mm256_xor_si256(neg1, neg2)), ones);
+	const auto both_zero = _mm256_andnot_si256(_mm256_or_si256(pos1, neg1), ones);
+
+	const auto exp_eq = _mm256_cmpeq_epi64(e1, e2);
+	const auto exp_gt = _mm256_cmpgt_epi64(e1, e2);
+	const auto mant_lt = _mm256_castpd_si256(_mm256_cmp_pd(m1, m2, _CMP_LT_OQ));
+	const auto magnitude_ge = _mm256_or_si256(
+		_mm256_andnot_si256(mant_lt, exp_eq),
+		_mm256_andnot_si256(_mm256_or_si256(exp_eq, _mm256_xor_si256(exp_gt, pos1)), ones)
+	);
+
+	const auto ge = _mm256_or_si256(sign_gt, _mm256_and_si256(sign_eq, _mm256_or_si256(both_zero, magnitude_ge)));
+
+	// load_avx2() leaves the lanes in element order 0, 2, 1, 3
+	const auto bits = _mm256_movemask_pd(_mm256_castsi256_pd(ge));
+	return (bits & 0x9) | ((bits & 0x2) << 1) | ((bits & 0x4) >> 1);
+}
+
+DECIMAL_TARGET_AVX2 auto ge_mask_avx2(const DecimalData *a, const DecimalData *b, const bool broadcast, const bool reverse, uint8_t *mask, const int64_t n) -> void {
+	auto m2 = _mm256_set1_pd(b->mantissa);
+	auto e2 = _mm256_set1_epi64x(b->exponent);
+
+	int64_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		int bits = 0;
+		for (int lane = 0; lane < 8; lane += 4) {
+			__m256d m1;
+			__m256i e1;
+			load_avx2(a + i + lane, m1, e1);
+			if (!broadcast) {
+				load_avx2(b + i + lane, m2, e2);
+			}
+			bits |= (reverse ? ge_lanes_avx2(m2, e2, m1, e1) : ge_lanes_avx2(m1, e1, m2, e2)) << lane;
+		}
+		mask[i / 8] = static_cast<uint8_t>(bits);
+	}
+	ge_mask_scalar(a + i, broadcast ? b : b + i, broadcast, reverse, mask + i / 8, n - i);
+}
+
+// ----------------------------------------------------------------------------
+// AVX-512F (8 lanes). Has proper mask registers, 64-bit min/max and unsigned
+// compares, so this one needs fewer tricks than the others.
+// ----------------------------------------------------------------------------
+
+DECIMAL_TARGET_AVX512 inline auto load_avx512(const DecimalData *p, __m512d &m, __m512i &e) -> void {
+	const auto *d = reinterpret_cast<const double *>(p);
+	const auto lo = _mm512_loadu_pd(d);
+	const auto hi = _mm512_loadu_pd(d + 8);
+	m = _mm512_unpacklo_pd(lo, hi);
+	e = _mm512_castpd_si512(_mm512_unpackhi_pd(lo, hi));
+}
+
+DECIMAL_TARGET_AVX512 inline auto store_avx512(DecimalData *p, const __m512d m, const __m512i e) -> void {
+	auto *d = reinterpret_cast<double *>(p);
+	const auto e_pd = _mm512_castsi512_pd(e);
+	_mm512_storeu_pd(d, _mm512_unpacklo_pd(m, e_pd));
+	_mm512_storeu_pd(d + 8, _mm512_unpackhi_pd(m, e_pd));
+}
+
+DECIMAL_TARGET_AVX512 inline auto pow10_avx512(const __m512i idx) -> __m512d {
+	return _mm512_i64gather_pd(idx, POW10_LOOKUP, sizeof(double));
+}
+
+// the float and/or/xor ops need AVX512DQ, so go through the integer ones
+DECIMAL_TARGET_AVX512 inline auto round_avx512(const __m512d x) -> __m512d {
+	const auto sign = _mm512_set1_epi64(INT64_MIN);
+	const auto t = _mm512_roundscale_pd(x, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+	const auto frac = _mm512_abs_pd(_mm512_sub_pd(x, t));
+	const auto step = _mm512_castsi512_pd(_mm512_or_si512(
+		_mm512_and_si512(_mm512_castpd_si512(x), sign),
+		_mm512_castpd_si512(_mm512_set1_pd(1.0))
+	));
+	const auto halfway = _mm512_cmp_pd_mask(frac, _mm512_set1_pd(0.5), _CMP_GE_OQ);
+	return _mm512_mask_add_pd(t, halfway, t, step);
+}
+
+DECIMAL_TARGET_AVX512 inline auto normalize_lanes_avx512(__m512d &m, __m512i &e) -> __mmask8 {
+	const auto abs = _mm512_abs_pd(m);
+	const auto bexp = _mm512_srli_epi64(_mm512_castpd_si512(abs), 52);
+	const auto special =
+		_mm512_cmpeq_epi64_mask(bexp, _mm512_setzero_si512()) |
+		_mm512_cmpeq_epi64_mask(bexp, _mm512_set1_epi64(DOUBLE_EXP_SPECIAL));
+
+	const auto clamped = _mm512_max_epi64(_mm512_min_epi64(bexp, _mm512_set1_epi64(DOUBLE_EXP_SPECIAL - 1)), _mm512_set1_epi64(1));
+	const auto exp2 = _mm512_sub_epi64(clamped, _mm512_set1_epi64(DOUBLE_BIAS));
+	const auto prod = _mm512_add_epi64(
+		_mm512_mul_epi32(exp2, _mm512_set1_epi64(LOG10_2_MUL)),
+		_mm512_set1_epi64(LOG10_2_BIAS << LOG10_2_SHIFT)
+	);
+	auto exp10 = _mm512_sub_epi64(_mm512_srli_epi64(prod, LOG10_2_SHIFT), _mm512_set1_epi64(LOG10_2_BIAS));
+
+	const auto upper = pow10_avx512(_mm512_add_epi64(exp10, _mm512_set1_epi64(POW10_OFFSET + 1)));
+	const auto too_small = _mm512_cmp_pd_mask(abs, upper, _CMP_GE_OQ);
+	exp10 = _mm512_mask_add_epi64(exp10, too_small, exp10, _mm512_set1_epi64(1));
+
+	const auto exact =
+		_mm512_cmpgt_epi64_mask(exp10, _mm512_setzero_si512()) &
+		_mm512_cmple_epi64_mask(exp10, _mm512_set1_epi64(POW10_EXACT_MAX));
+	const auto scale = pow10_avx512(_mm512_add_epi64(
+		_mm512_set1_epi64(POW10_OFFSET),
+		_mm512_mask_sub_epi64(exp10, ~exact, _mm512_setzero_si512(), exp10)
+	));
+	m = _mm512_mask_div_pd(_mm512_mul_pd(m, scale), exact, m, scale);
+	e = _mm512_add_epi64(e, exp10);
+
+	const auto res_abs = _mm512_abs_pd(m);
+	const auto out_of_range =
+		_mm512_cmp_pd_mask(res_abs, _mm512_set1_pd(1.0), _CMP_LT_OQ) |
+		_mm512_cmp_pd_mask(res_abs, _mm512_set1_pd(10.0), _CMP_GE_OQ);
+
+	return special | out_of_range;
+}
+
+DECIMAL_TARGET_AVX512 auto normalize_avx512(const DecimalData *src, DecimalData *dst, const int64_t n) -> void {
+	int64_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m512d m;
+		__m512i e;
+		load_avx512(src + i, m, e);
+
+		if (normalize_lanes_avx512(m, e)) {
+			normalize_scalar(src + i, dst + i, 8);
+			continue;
+		}
+		store_avx512(dst + i, m, e);
+	}
+	normalize_scalar(src + i, dst + i, n - i);
+}
+
+DECIMAL_TARGET_AVX512 auto add_avx512(const DecimalData *a, const DecimalData *b, DecimalData *dst, const int64_t n, const bool negate_b) -> void {
+	const auto flip = _mm512_set1_epi64(negate_b ? INT64_MIN : 0);
+
+	int64_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m512d m1, m2;
+		__m512i e1, e2;
+		load_avx512(a + i, m1, e1);
+		load_avx512(b + i, m2, e2);
+		m2 = _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(m2), flip));
+
+		const auto first_bigger = _mm512_cmpgt_epi64_mask(e1, e2);
+
+		const auto big_m = _mm512_mask_blend_pd(first_bigger, m2, m1);
+		const auto small_m = _mm512_mask_blend_pd(first_bigger, m1, m2);
+		const auto big_e = _mm512_mask_blend_epi64(first_bigger, e2, e1);
+		const auto small_e = _mm512_mask_blend_epi64(first_bigger, e1, e2);
+
+		const auto diff = _mm512_sub_epi64(big_e, small_e);
+		const auto far = _mm512_cmpgt_epu64_mask(diff, _mm512_set1_epi64(MAX_SIGNIFICANT_DIGITS - 1));
+
+		const auto idx = _mm512_mask_blend_epi64(far,
+			_mm512_sub_epi64(_mm512_set1_epi64(POW10_OFFSET), diff),
+			_mm512_set1_epi64(POW10_OFFSET)
+		);
+
+		const auto scale = _mm512_set1_pd(ADD_SCALE);
+		auto m = round_avx512(_mm512_add_pd(
+			_mm512_mul_pd(scale, big_m),
+			_mm512_mul_pd(_mm512_mul_pd(scale, small_m), pow10_avx512(idx))
+		));
+		auto e = _mm512_sub_epi64(big_e, _mm512_set1_epi64(ADD_SCALE_EXP));
+
+		if (normalize_lanes_avx512(m, e) & ~far) {
+			add_scalar(a + i, b + i, dst + i, 8, negate_b);
+			continue;
+		}
+
+		m = _mm512_mask_blend_pd(far, m, big_m);
+		e = _mm512_mask_blend_epi64(far, e, big_e);
+		store_avx512(dst + i, m, e);
+	}
+	add_scalar(a + i, b + i, dst + i, n - i, negate_b);
+}
+
+DECIMAL_TARGET_AVX512 auto mul_avx512(const DecimalData *a, const DecimalData *b, DecimalData *dst, const int64_t n) -> void {
+	int64_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m512d m1, m2;
+		__m512i e1, e2;
+		load_avx512(a + i, m1, e1);
+		load_avx512(b + i, m2, e2);
+
+		auto m = _mm512_mul_pd(m1, m2);
+		auto e = _mm512_add_epi64(e1, e2);
+
+		if (normalize_lanes_avx512(m, e)) {
+			mul_scalar(a + i, b + i, dst + i, 8);
+			continue;
+		}
+		store_avx512(dst + i, m, e);
+	}
+	mul_scalar(a + i, b + i, dst + i, n - i);
+}
+
+DECIMAL_TARGET_AVX512 auto mul_num_avx512(const DecimalData *a, const double b, DecimalData *dst, const int64_t n) -> void {
+	const auto factor = _mm512_set1_pd(b);
+
+	int64_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m512d m;
+		__m512i e;
+		load_avx512(a + i, m, e);
+
+		m = _mm512_mul_pd(m, factor);
+
+		if (normalize_lanes_avx512(m, e)) {
+			mul_num_scalar(a + i, b, dst + i, 8);
+			continue;
+		}
+		store_avx512(dst + i, m, e);
+	}
+	mul_num_scalar(a + i, b, dst + i, n - i);
+}
+
+DECIMAL_TARGET_AVX512 inline auto ge_lanes_avx512(const __m512d m1, const __m512i e1, const __m512d m2, const __m512i e2) -> int {
+	const auto zero = _mm512_setzero_pd();
+	const int pos1 = _mm512_cmp_pd_mask(m1, zero, _CMP_GT_OQ);
+	const int neg1 = _mm512_cmp_pd_mask(m1, zero, _CMP_LT_OQ);
+	const int pos2 = _mm512_cmp_pd_mask(m2, zero, _CMP_GT_OQ);
+	const int neg2 = _mm512_cmp_pd_mask(m2, zero, _CMP_LT_OQ);
+
+	const auto sign_gt = (pos1 & ~pos2) | (~neg1 & neg2);
+	const auto sign_eq = ~((pos1 ^ pos2) | (neg1 ^ neg2));
+	const auto both_zero = ~(pos1 | neg1);
+
+	const int exp_eq = _mm512_cmpeq_epi64_mask(e1, e2);
+	const int exp_gt = _mm512_cmpgt_epi64_mask(e1, e2);
+	const int mant_lt = _mm512_cmp_pd_mask(m1, m2, _CMP_LT_OQ);
+	const auto magnitude_ge = (exp_eq & ~mant_lt) | ~(exp_eq | (exp_gt ^ pos1));
+
+	const auto bits = sign_gt | (sign_eq & (both_zero | magnitude_ge));
+
+	// load_avx512() leaves the lanes in element order 0, 4, 1, 5, 2, 6, 3, 7
+	const auto gather = [](int x) {
+		x &= 0x55;
+		x = (x | (x >> 1)) & 0x33;
+		return (x | (x >> 2)) & 0x0F;
+	};
+	return gather(bits) | (gather(bits >> 1) << 4);
+}
+
+DECIMAL_TARGET_AVX512 auto ge_mask_avx512(const DecimalData *a, const DecimalData *b, const bool broadcast, const bool reverse, uint8_t *mask, const int64_t n) -> void {
+	auto m2 = _mm512_set1_pd(b->mantissa);
+	auto e2 = _mm512_set1_epi64(b->exponent);
+
+	int64_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m512d m1;
+		__m512i e1;
+		load_avx512(a + i, m1, e1);
+		if (!broadcast) {
+			load_avx512(b + i, m2, e2);
+		}
+		mask[i / 8] = static_cast<uint8_t>(reverse ? ge_lanes_avx512(m2, e2, m1, e1) : ge_lanes_avx512(m1, e1, m2, e2));
+	}
+	ge_mask_scalar(a + i, broadcast ? b : b + i, broadcast, reverse, mask + i / 8, n - i);
+}
+
+#endif // DECIMAL_SIMD_X86
+
+struct Kernels {
+	Level level;
+	const char *name;
+	void (*normalize)(const DecimalData *, DecimalData *, int64_t);
+	void (*add)(const DecimalData *, const DecimalData *, DecimalData *, int64_t, bool);
+	void (*mul)(const DecimalData *, const DecimalData *, DecimalData *, int64_t);
+	void (*mul_num)(const DecimalData *, double, DecimalData *, int64_t);
+	void (*ge_mask)(const DecimalData *, const DecimalData *, bool, bool, uint8_t *, int64_t);
+};
+
+constexpr const Kernels KERNELS_SCALAR = { Level::SCALAR, "scalar", normalize_scalar, add_scalar, mul_scalar, mul_num_scalar, ge_mask_scalar };
+
+#if DECIMAL_SIMD_X86
+constexpr const Kernels KERNELS_SSE42 = { Level::SSE42, "sse4.2", normalize_sse42, add_sse42, mul_sse42, mul_num_sse42, ge_mask_sse42 };
+constexpr const Kernels KERNELS_AVX2 = { Level::AVX2, "avx2", normalize_avx2, add_avx2, mul_avx2, mul_num_avx2, ge_mask_avx2 };
+constexpr const Kernels KERNELS_AVX512 = { Level::AVX512, "avx512", normalize_avx512, add_avx512, mul_avx512, mul_num_avx512, ge_mask_avx512 };
+#endif
+
+// only written once while the extension loads
+Kernels active = KERNELS_SCALAR;
+
+} // namespace
+
+auto detect() -> Level {
+#if DECIMAL_SIMD_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f")) return Level::AVX512;
+	if (__builtin_cpu_supports("avx2")) return Level::AVX2;
+	if (__builtin_cpu_supports("sse4.2")) return Level::SSE42;
+#endif
+	return Level::SCALAR;
+}
+
+auto init(const Level level) -> void {
+	const auto supported = detect();
+	const auto chosen = static_cast<int>(level) < static_cast<int>(supported) ? level : supported;
+
+	switch (chosen) {
+#if DECIMAL_SIMD_X86
+		case Level::AVX512: active = KERNELS_AVX512; break;
+		case Level::AVX2:   active = KERNELS_AVX2;   break;
+		case Level::SSE42:  active = KERNELS_SSE42;  break;
+#endif
+		default:            active = KERNELS_SCALAR; break;
+	}
+}
+
+auto get_level() -> Level {
+	return active.level;
+}
+
+auto get_level_name() -> const char * {
+	return active.name;
+}
+
+auto normalize(const DecimalData *src, DecimalData *dst, const int64_t n) -> void {
+	active.normalize(src, dst, n);
+}
+
+auto add(const DecimalData *a, const DecimalData *b, DecimalData *dst, const int64_t n) -> void {
+	active.add(a, b, dst, n, false);
+}
+
+auto sub(const DecimalData *a, const DecimalData *b, DecimalData *dst, const int64_t n) -> void {
+	active.add(a, b, dst, n, true);
+}
+
+auto mul(const DecimalData *a, const DecimalData *b, DecimalData *dst, const int64_t n) -> void {
+	active.mul(a, b, dst, n);
+}
+
+auto mul_num(const DecimalData *a, const double b, DecimalData *dst, const int64_t n) -> void {
+	active.mul_num(a, b, dst, n);
+}
+
+auto ge_mask(const DecimalData *a, const DecimalData *b, uint8_t *mask, const int64_t n) -> void {
+	// the SIMD paths read b[0] up front
+	if (n <= 0) return;
+	active.ge_mask(a, b, false, false, mask, n);
+}
+
+auto ge_scalar_mask(const DecimalData *a, const DecimalData &b, uint8_t *mask, const int64_t n) -> void {
+	if (n <= 0) return;
+	active.ge_mask(a, &b, true, false, mask, n);
+}
+
+auto le_scalar_mask(const DecimalData *a, const DecimalData &b, uint8_t *mask, const int64_t n) -> void {
+	if (n <= 0) return;
+	active.ge_mask(a, &b, true, true, mask, n);
+}
+
+auto mask_count(const uint8_t *mask, const int64_t len) -> int64_t {
+	int64_t count = 0;
+	int64_t i = 0;
+	for (; i + 8 <= len; i += 8) {
+		uint64_t x;
+		std::memcpy(&x, mask + i, sizeof(x));
+		// bits per 2, 4, then 8 bits, and a multiply to add up the bytes
+		x = x - ((x >> 1) & 0x5555555555555555);
+		x = (x & 0x3333333333333333) + ((x >> 2) & 0x3333333333333333);
+		x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0F;
+		count += static_cast<int64_t>((x * 0x0101010101010101) >> 56);
+	}
+	for (; i < len; i++) {
+		for (auto x = mask[i]; x != 0; x &= x - 1) {
+			count++;
+		}
+	}
+	return count;
+}
+
+auto mask_find(const uint8_t *mask, const int64_t len, const int64_t from) -> int64_t {
+	const auto start = from < 0 ? 0 : from;
+
+	for (auto i = start / 8; i < len; i++) {
+		// bits before `start` only matter in its own byte
+		auto bits = static_cast<uint32_t>(mask[i]);
+		if (i == start / 8) {
+			bits &= 0xFFu << (start % 8);
+		}
+		if (bits == 0) continue;
+
+		int64_t bit = 0;
+		while ((bits & 1) == 0) {
+			bits >>= 1;
+			bit++;
+		}
+		return i * 8 + bit;
+	}
+	return -1;
+}
+
+} // namespace decimal_simd
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "decimal_core.hpp"
+
+#include <cstdint>
+
+// Batch kernels for the hottest element-wise ops.
+//
+// Storage stays array-of-structs (DecimalData is 16 bytes), so the SIMD paths
+// split each chunk into separate mantissa and exponent lanes in registers and
+// interleave them back when storing. The widest path the CPU supports is picked
+// once at load time with `init()`.
+//
+// All paths give results bit-identical to the matching decimal_core functions.
+// Chunks that contain zero, subnormal or non-finite mantissas (or a mantissa
+// that needs the rounding fix-up in decimal_core::normalize) are handed over to
+// the scalar path as a whole.
+//
+// `dst` may alias any of the inputs.
+namespace decimal_simd {
+
+enum class Level {
+	SCALAR,
+	SSE42,
+	AVX2,
+	AVX512,
+};
+
+// highest level supported by both the build and the CPU we're running on
+auto detect() -> Level;
+
+// levels above detect() are clamped down
+auto init(const Level level) -> void;
+
+auto get_level() -> Level;
+auto get_level_name() -> const char *;
+
+auto normalize(const DecimalData *src, DecimalData *dst, const int64_t n) -> void;
+
+auto add(const DecimalData *a, const DecimalData *b, DecimalData *dst, const int64_t n) -> void;
+auto sub(const DecimalData *a, const DecimalData *b, DecimalData *dst, const int64_t n) -> void;
+
+auto mul(const DecimalData *a, const DecimalData *b, DecimalData *dst, const int64_t n) -> void;
+auto mul_num(const DecimalData *a, const double b, DecimalData *dst, const int64_t n) -> void;
+
+// Bitmasks of a[i] >= b[i], a[i] >= b and a[i] <= b, with the same results as
+// decimal_core::ge() and le(). Bit i is bit (i % 8) of byte (i / 8), and the
+// unused bits of the last of the (n + 7) / 8 bytes are cleared.
+auto ge_mask(const DecimalData *a, const DecimalData *b, uint8_t *mask, const int64_t n) -> void;
+auto ge_scalar_mask(const DecimalData *a, const DecimalData &b, uint8_t *mask, const int64_t n) -> void;
+auto le_scalar_mask(const DecimalData *a, const DecimalData &b, uint8_t *mask, const int64_t n) -> void;
+
+// set bits in the first `len` bytes of a mask
+auto mask_count(const uint8_t *mask, const int64_t len) -> int64_t;
+
+// index of the first set bit at or after bit `from`, -1 if there's none
+auto mask_find(const uint8_t *mask, const int64_t len, const int64_t from) -> int64_t;
+
+} // namespace decimal_simd
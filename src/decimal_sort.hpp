@@ -0,0 +1,232 @@
+#pragma once
+
+// Sorting decimals by mapping each one to a 128-bit unsigned key that orders
+// the same way the values do, so ordering is plain integer comparison and
+// sorting can be an LSD radix sort instead of calls to cmp().
+//
+// For |x|, the key is 120 bits: a 2-bit class (0 for zero, 1 for finite, 2
+// for infinity), the exponent with its sign bit flipped, then the bits of the
+// mantissa as a double minus the bits of 1.0. Mantissas in [1, 10) are
+// positive doubles, whose bit patterns order the same way as their values,
+// so the 54 bits left after the subtraction do too. Positive values get the
+// top bit set on top of that, negative values get the bitwise complement
+// (larger magnitudes sort lower). NaN gets the highest key, above +inf, and
+// -0 shares the key of 0.
+
+#include "decimal_core.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace decimal_sort {
+
+struct SortKey {
+	uint64_t hi;
+	uint64_t lo;
+};
+
+inline auto operator<(const SortKey &a, const SortKey &b) -> bool {
+	return a.hi < b.hi || (a.hi == b.hi && a.lo < b.lo);
+}
+
+inline auto operator==(const SortKey &a, const SortKey &b) -> bool {
+	return a.hi == b.hi && a.lo == b.lo;
+}
+
+inline auto sort_key(const DecimalData &value) -> SortKey {
+	constexpr const uint64_t TOP_BIT = uint64_t(1) << 63;
+	constexpr const uint64_t ONE_BITS = 0x3FF0000000000000;  // 1.0
+	constexpr const uint64_t CLASS_FINITE = 1;
+	constexpr const uint64_t CLASS_INF = 2;
+
+	auto dec = value;
+	if (DECIMAL_UNLIKELY(std::isnan(dec.mantissa))) {
+		return { UINT64_MAX, UINT64_MAX };
+	}
+	if (DECIMAL_UNLIKELY(dec.mantissa == 0.0)) {
+		return { TOP_BIT, 0 };
+	}
+
+	// magnitude key, as the 120 low bits of hi:lo
+	uint64_t hi;
+	uint64_t lo;
+	if (DECIMAL_UNLIKELY(std::isinf(dec.mantissa))) {
+		hi = CLASS_INF << 54;
+		lo = 0;
+	} else {
+		const auto abs = std::abs(dec.mantissa);
+		if (DECIMAL_UNLIKELY(abs < 1.0 || abs >= 10.0)) {
+			dec = decimal_core::normalize(dec);
+		}
+
+		uint64_t bits;
+		const auto m = std::abs(dec.mantissa);
+		std::memcpy(&bits, &m, sizeof(bits));
+		const auto mant = bits - ONE_BITS;
+		const auto exp = static_cast<uint64_t>(dec.exponent) ^ TOP_BIT;
+
+		hi = (CLASS_FINITE << 54) | (exp >> 10);
+		lo = (exp << 54) | mant;
+	}
+
+	if (dec.mantissa > 0) {
+		return { hi | TOP_BIT, lo };
+	}
+	return { ~hi & ~TOP_BIT, ~lo };
+}
+
+// big-endian, so comparing the bytes in order gives the same result
+inline auto write_key(const SortKey &key, uint8_t *out) -> void {
+	for (int i = 0; i < 8; i++) {
+		out[i] = static_cast<uint8_t>(key.hi >> (56 - i * 8));
+		out[8 + i] = static_cast<uint8_t>(key.lo >> (56 - i * 8));
+	}
+}
+
+struct Item {
+	SortKey key;
+	int64_t idx;
+};
+
+// below this, std::stable_sort beats setting up the radix passes
+constexpr const int64_t RADIX_MIN_SIZE = 256;
+
+// 11-bit digits: 12 passes for the whole key, and a 2048-entry histogram is
+// small enough to stay in L1 while scattering
+constexpr const int RADIX_BITS = 11;
+constexpr const int RADIX_BUCKETS = 1 << RADIX_BITS;
+constexpr const int RADIX_PASSES = (128 + RADIX_BITS - 1) / RADIX_BITS;
+
+inline auto key_digit(const SortKey &key, const int pass) -> uint32_t {
+	constexpr const uint64_t MASK = RADIX_BUCKETS - 1;
+	const auto bit = pass * RADIX_BITS;
+	if (bit >= 64) {
+		return static_cast<uint32_t>((key.hi >> (bit - 64)) & MASK);
+	}
+	if (bit + RADIX_BITS <= 64) {
+		return static_cast<uint32_t>((key.lo >> bit) & MASK);
+	}
+	return static_cast<uint32_t>(((key.lo >> bit) | (key.hi << (64 - bit))) & MASK);
+}
+
+// Stable LSD radix sort of `items` by key. The histograms for all passes are
+// counted in one go, and passes where every key has the same digit (like the
+// top bits of the exponent, usually) are skipped. `scratch` is resized to
+// match.
+inline auto radix_sort(std::vector<Item> &items, std::vector<Item> &scratch) -> void {
+	const auto n = static_cast<int64_t>(items.size());
+	if (n < RADIX_MIN_SIZE) {
+		std::stable_sort(items.begin(), items.end(), [](const Item &a, const Item &b) { return a.key < b.key; });
+		return;
+	}
+
+	std::vector<int64_t> counts(RADIX_PASSES * RADIX_BUCKETS, 0);
+	for (const auto &it : items) {
+		for (int pass = 0; pass < RADIX_PASSES; pass++) {
+			counts[pass * RADIX_BUCKETS + key_digit(it.key, pass)]++;
+		}
+	}
+
+	scratch.resize(n);
+	auto *src = items.data();
+	auto *dst = scratch.data();
+	for (int pass = 0; pass < RADIX_PASSES; pass++) {
+		auto *count = counts.data() + pass * RADIX_BUCKETS;
+		if (count[key_digit(src[0].key, pass)] == n) continue;
+
+		int64_t offset = 0;
+		for (int b = 0; b < RADIX_BUCKETS; b++) {
+			const auto c = count[b];
+			count[b] = offset;
+			offset += c;
+		}
+		for (int64_t i = 0; i < n; i++) {
+			dst[count[key_digit(src[i].key, pass)]++] = src[i];
+		}
+		std::swap(src, dst);
+	}
+
+	if (src != items.data()) {
+		std::memcpy(items.data(), src, n * sizeof(Item));
+	}
+}
+
+inline auto make_items(const DecimalData *values, const int64_t n, std::vector<Item> &items) -> void {
+	items.resize(n);
+	for (int64_t i = 0; i < n; i++) {
+		items[i] = { sort_key(values[i]), i };
+	}
+}
+
+// indices that would sort `values` ascending, ties keep their order
+inline auto argsort(const DecimalData *values, const int64_t n, int64_t *out) -> void {
+	std::vector<Item> items;
+	std::vector<Item> scratch;
+	make_items(values, n, items);
+	radix_sort(items, scratch);
+	for (int64_t i = 0; i < n; i++) {
+		out[i] = items[i].idx;
+	}
+}
+
+// `out` may alias `values`
+inline auto sort(const DecimalData *values, const int64_t n, DecimalData *out) -> void {
+	std::vector<Item> items;
+	std::vector<Item> scratch;
+	make_items(values, n, items);
+	radix_sort(items, scratch);
+
+	std::vector<DecimalData> sorted(n);
+	for (int64_t i = 0; i < n; i++) {
+		sorted[i] = values[items[i].idx];
+	}
+	std::memcpy(out, sorted.data(), n * sizeof(DecimalData));
+}
+
+// Indices of the `k` largest values, largest first, ties going to the lower
+// index. Only the top k get fully sorted. Returns how many were written,
+// min(k, n).
+inline auto top_k(const DecimalData *values, const int64_t n, const int64_t k, int64_t *out) -> int64_t {
+	const auto count = std::max<int64_t>(0, std::min(k, n));
+	if (count == 0) return 0;
+
+	std::vector<Item> items;
+	make_items(values, n, items);
+
+	const auto before = [](const Item &a, const Item &b) {
+		return b.key < a.key || (a.key == b.key && a.idx < b.idx);
+	};
+	if (count < n) {
+		std::nth_element(items.begin(), items.begin() + (count - 1), items.end(), before);
+	}
+	std::sort(items.begin(), items.begin() + count, before);
+
+	for (int64_t i = 0; i < count; i++) {
+		out[i] = items[i].idx;
+	}
+	return count;
+}
+
+// Where `value` would go in the ascending `values`: before any equal entries
+// (lower bound) or after them (upper bound).
+inline auto search(const DecimalData *values, const int64_t n, const DecimalData &value, const bool before) -> int64_t {
+	const auto key = sort_key(value);
+	int64_t lo = 0;
+	int64_t hi = n;
+	while (lo < hi) {
+		const auto mid = lo + (hi - lo) / 2;
+		const auto k = sort_key(values[mid]);
+		const auto go_right = before ? k < key : !(key < k);
+		if (go_right) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+} // namespace decimal_sort
@@ -0,0 +1,205 @@
+#pragma once
+
+// A graph of decimal values that depend on each other: sources, set from
+// outside, and derived values, each a decimal_formula::Program over other
+// nodes. Setting a source only marks what depends on it as dirty, and a
+// derived value is recomputed when it's read, after whatever dirty inputs it
+// has. When only a few sources change between reads, only the nodes below
+// them get recomputed, instead of the whole graph.
+//
+// A derived node can only refer to nodes that already exist, so there are no
+// cycles and node ids are a topological order: recomputing dirty nodes by
+// increasing id always has their inputs ready.
+//
+// Like decimal_core.hpp, nothing in here reports errors. The binding layer is
+// expected to check ids and compile the formulas before calling in.
+
+#include "decimal_core.hpp"
+#include "decimal_formula.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace decimal_stat_graph {
+
+struct Node {
+	// empty for a source
+	decimal_formula::Program program;
+
+	// the node ids the formula's variables stand for, and the nodes whose
+	// formulas use this one
+	std::vector<int64_t> inputs;
+	std::vector<int64_t> dependents;
+
+	// a derived node whose value is out of date
+	bool dirty = false;
+
+	// already visited by the update() running now, see Graph::epoch
+	uint64_t mark = 0;
+};
+
+struct Graph {
+	std::vector<Node> nodes;
+
+	// by node id, so a program can read its inputs straight from here
+	std::vector<DecimalData> values;
+
+	// Every dirty node, in no particular order. Can also hold nodes that were
+	// cleaned since, and the same node twice; update_all() sorts it out.
+	std::vector<int64_t> dirty;
+
+	// how many times a derived node was recomputed, over the graph's lifetime
+	int64_t evaluations = 0;
+
+	// scratch
+	uint64_t epoch = 0;
+	std::vector<int64_t> work;
+	std::vector<int64_t> pending;
+	std::vector<DecimalData> stack;
+};
+
+inline auto is_source(const Graph &g, const int64_t id) -> bool {
+	return g.nodes[id].program.code.empty();
+}
+
+inline auto clear(Graph &g) -> void {
+	g.nodes.clear();
+	g.values.clear();
+	g.dirty.clear();
+}
+
+inline auto add_source(Graph &g, const DecimalData &value) -> int64_t {
+	g.nodes.emplace_back();
+	g.values.push_back(value);
+	return static_cast<int64_t>(g.nodes.size() - 1);
+}
+
+// `program`'s variable i is node inputs[i], each an existing node. The new
+// node starts out dirty, so it's computed on the first read.
+inline auto add_derived(Graph &g, decimal_formula::Program program, const std::vector<int64_t> &inputs) -> int64_t {
+	const auto id = static_cast<int64_t>(g.nodes.size());
+
+	// the VAR instructions index `values` directly from now on
+	for (auto &ins : program.code) {
+		if (ins.op == decimal_formula::Op::VAR) {
+			ins.arg = static_cast<int32_t>(inputs[ins.arg]);
+		}
+	}
+
+	Node n;
+	n.program = std::move(program);
+	n.inputs = inputs;
+	n.dirty = true;
+	g.nodes.push_back(std::move(n));
+	g.values.push_back(decimal_core::DECIMAL_NAN);
+	g.dirty.push_back(id);
+
+	for (const auto input : inputs) {
+		g.nodes[input].dependents.push_back(id);
+	}
+	return id;
+}
+
+// Marks everything that depends on `id` as dirty. Stops at nodes that already
+// are: their dependents have to be dirty too.
+inline auto invalidate(Graph &g, const int64_t id) -> void {
+	g.work.assign(g.nodes[id].dependents.begin(), g.nodes[id].dependents.end());
+	while (!g.work.empty()) {
+		const auto next = g.work.back();
+		g.work.pop_back();
+
+		auto &n = g.nodes[next];
+		if (n.dirty) continue;
+		n.dirty = true;
+		g.dirty.push_back(next);
+		g.work.insert(g.work.end(), n.dependents.begin(), n.dependents.end());
+	}
+
+	// Reads clean nodes without taking them off the list, so it can fill up
+	// with stale entries if update_all() never runs.
+	if (g.dirty.size() > 2 * g.nodes.size()) {
+		g.dirty.erase(std::remove_if(g.dirty.begin(), g.dirty.end(), [&](const int64_t i) { return !g.nodes[i].dirty; }), g.dirty.end());
+	}
+}
+
+// `id` has to be a source. Setting it to the value it already has doesn't
+// invalidate anything.
+inline auto set_value(Graph &g, const int64_t id, const DecimalData &value) -> void {
+	auto &old = g.values[id];
+	if (old.mantissa == value.mantissa && old.exponent == value.exponent) return;
+
+	old = value;
+	invalidate(g, id);
+}
+
+// recomputes g.pending, which has to be sorted and hold every dirty input of
+// the nodes in it
+inline auto evaluate_pending(Graph &g) -> void {
+	for (const auto id : g.pending) {
+		auto &n = g.nodes[id];
+		g.values[id] = decimal_formula::run_one(n.program, g.values.data(), g.stack);
+		n.dirty = false;
+	}
+	g.evaluations += static_cast<int64_t>(g.pending.size());
+}
+
+// Makes the values of `ids` up to date, recomputing them and their dirty
+// inputs (but nothing else) in topological order.
+inline auto update(Graph &g, const int64_t *ids, const int64_t count) -> void {
+	g.epoch++;
+	g.pending.clear();
+	g.work.clear();
+
+	for (int64_t i = 0; i < count; i++) {
+		auto &n = g.nodes[ids[i]];
+		if (n.dirty && n.mark != g.epoch) {
+			n.mark = g.epoch;
+			g.work.push_back(ids[i]);
+		}
+	}
+	while (!g.work.empty()) {
+		const auto id = g.work.back();
+		g.work.pop_back();
+		g.pending.push_back(id);
+
+		for (const auto input : g.nodes[id].inputs) {
+			auto &n = g.nodes[input];
+			if (n.dirty && n.mark != g.epoch) {
+				n.mark = g.epoch;
+				g.work.push_back(input);
+			}
+		}
+	}
+
+	std::sort(g.pending.begin(), g.pending.end());
+	evaluate_pending(g);
+}
+
+// the value of `id`, recomputed first if it's dirty
+inline auto get(Graph &g, const int64_t id) -> const DecimalData & {
+	if (g.nodes[id].dirty) {
+		update(g, &id, 1);
+	}
+	return g.values[id];
+}
+
+// Makes every value up to date.
+inline auto update_all(Graph &g) -> void {
+	g.epoch++;
+	g.pending.clear();
+	for (const auto id : g.dirty) {
+		auto &n = g.nodes[id];
+		if (n.dirty && n.mark != g.epoch) {
+			n.mark = g.epoch;
+			g.pending.push_back(id);
+		}
+	}
+	g.dirty.clear();
+
+	std::sort(g.pending.begin(), g.pending.end());
+	evaluate_pending(g);
+}
+
+} // namespace decimal_stat_graph
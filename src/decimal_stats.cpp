@@ -0,0 +1,182 @@
+#include "decimal_stats.hpp"
+#include "godot_cpp/classes/engine.hpp"
+#include "godot_cpp/classes/performance.hpp"
+#include "godot_cpp/variant/array.hpp"
+#include "godot_cpp/variant/callable_method_pointer.hpp"
+#include <cstdint>
+#include <godot_cpp/core/class_db.hpp>
+
+using namespace godot;
+namespace counters = decimal_counters;
+
+// Monitors show the average per frame since they were last polled, which is
+// what's useful to look at in the profiler. The first two are the totals over
+// every method, then one per counter, then one per method.
+static constexpr const int64_t MONITOR_CALLS = 0;
+static constexpr const int64_t MONITOR_TIME = 1;
+static constexpr const int64_t MONITOR_COUNTERS = 2;
+static constexpr const int64_t MONITOR_METHODS = MONITOR_COUNTERS + counters::COUNTER_MAX;
+static constexpr const int64_t MONITOR_MAX = MONITOR_METHODS + counters::MAX_METHODS;
+
+static const char *const COUNTER_NAMES[counters::COUNTER_MAX] = {
+	"normalize",
+	"add_early_exits",
+	"nan_results",
+	"inf_results",
+};
+
+static const char *const COUNTER_MONITOR_NAMES[counters::COUNTER_MAX] = {
+	"Normalizations",
+	"Add Early Exits",
+	"NaN Results",
+	"Inf Results",
+};
+
+// only touched from the main thread, when the monitors get polled
+static uint64_t monitor_last_value[MONITOR_MAX];
+static uint64_t monitor_last_frame[MONITOR_MAX];
+static double monitor_last_result[MONITOR_MAX];
+
+static auto total_calls() -> uint64_t {
+	uint64_t total = 0;
+	for (int i = 0; i < counters::method_count; i++) {
+		total += counters::methods[i].calls.load(std::memory_order_relaxed);
+	}
+	return total;
+}
+
+static auto total_nanos() -> uint64_t {
+	uint64_t total = 0;
+	for (int i = 0; i < counters::method_count; i++) {
+		total += counters::methods[i].nanos.load(std::memory_order_relaxed);
+	}
+	return total;
+}
+
+static auto monitor_raw_value(const int64_t idx) -> uint64_t {
+	if (idx == MONITOR_CALLS) return total_calls();
+	if (idx == MONITOR_TIME) return total_nanos() / 1000;
+	if (idx < MONITOR_METHODS) return counters::get(static_cast<counters::Counter>(idx - MONITOR_COUNTERS));
+	return counters::methods[idx - MONITOR_METHODS].calls.load(std::memory_order_relaxed);
+}
+
+static auto monitor_name(const int64_t idx) -> StringName {
+	if (idx == MONITOR_CALLS) return "Decimal/Calls";
+	if (idx == MONITOR_TIME) return "Decimal/Call Time (usec)";
+	if (idx < MONITOR_METHODS) return String("Decimal/") + COUNTER_MONITOR_NAMES[idx - MONITOR_COUNTERS];
+	return String("Decimal Calls/") + counters::methods[idx - MONITOR_METHODS].name;
+}
+
+static auto monitor_count() -> int64_t {
+	return MONITOR_METHODS + counters::method_count;
+}
+
+auto DecimalStats::_bind_methods() -> void {
+	ClassDB::bind_static_method("DecimalStats", D_METHOD("is_available"), &DecimalStats::is_available);
+
+	ClassDB::bind_static_method("DecimalStats", D_METHOD("set_enabled", "enabled"), &DecimalStats::set_enabled);
+	ClassDB::bind_static_method("DecimalStats", D_METHOD("is_enabled"), &DecimalStats::is_enabled);
+
+	ClassDB::bind_static_method("DecimalStats", D_METHOD("set_timing_enabled", "enabled"), &DecimalStats::set_timing_enabled);
+	ClassDB::bind_static_method("DecimalStats", D_METHOD("is_timing_enabled"), &DecimalStats::is_timing_enabled);
+
+	ClassDB::bind_static_method("DecimalStats", D_METHOD("snapshot"), &DecimalStats::snapshot);
+	ClassDB::bind_static_method("DecimalStats", D_METHOD("reset"), &DecimalStats::reset);
+}
+
+auto DecimalStats::is_available() -> bool {
+#ifdef DECIMAL_STATS
+	return true;
+#else
+	return false;
+#endif
+}
+
+auto DecimalStats::set_enabled(const bool enabled) -> void {
+	counters::enabled.store(enabled, std::memory_order_relaxed);
+}
+
+auto DecimalStats::is_enabled() -> bool {
+	return is_available() && counters::is_enabled();
+}
+
+auto DecimalStats::set_timing_enabled(const bool enabled) -> void {
+	counters::timing.store(enabled, std::memory_order_relaxed);
+}
+
+auto DecimalStats::is_timing_enabled() -> bool {
+	return is_available() && counters::is_timing();
+}
+
+auto DecimalStats::snapshot() -> Dictionary {
+	Dictionary calls;
+	Dictionary time_usec;
+	for (int i = 0; i < counters::method_count; i++) {
+		const auto &method = counters::methods[i];
+		const auto n = method.calls.load(std::memory_order_relaxed);
+		if (n == 0) continue;
+
+		calls[method.name] = static_cast<int64_t>(n);
+		time_usec[method.name] = static_cast<int64_t>(method.nanos.load(std::memory_order_relaxed) / 1000);
+	}
+
+	Dictionary res;
+	res["calls"] = calls;
+	res["time_usec"] = time_usec;
+	res["total_calls"] = static_cast<int64_t>(total_calls());
+	for (int i = 0; i < counters::COUNTER_MAX; i++) {
+		res[COUNTER_NAMES[i]] = static_cast<int64_t>(counters::get(static_cast<counters::Counter>(i)));
+	}
+	return res;
+}
+
+auto DecimalStats::reset() -> void {
+	counters::reset();
+}
+
+auto DecimalStats::add_monitors() -> void {
+	if (!is_available()) return;
+
+	auto *perf = Performance::get_singleton();
+	const auto frame = Engine::get_singleton()->get_process_frames();
+	for (int64_t i = 0; i < monitor_count(); i++) {
+		monitor_last_value[i] = monitor_raw_value(i);
+		monitor_last_frame[i] = frame;
+		monitor_last_result[i] = 0.0;
+
+		const auto name = monitor_name(i);
+		if (!perf->has_custom_monitor(name)) {
+			perf->add_custom_monitor(name, callable_mp_static(&DecimalStats::get_monitor_value), Array::make(i));
+		}
+	}
+}
+
+auto DecimalStats::remove_monitors() -> void {
+	if (!is_available()) return;
+
+	auto *perf = Performance::get_singleton();
+	for (int64_t i = 0; i < monitor_count(); i++) {
+		const auto name = monitor_name(i);
+		if (perf->has_custom_monitor(name)) {
+			perf->remove_custom_monitor(name);
+		}
+	}
+}
+
+auto DecimalStats::get_monitor_value(const int64_t idx) -> double {
+	if (idx < 0 || idx >= monitor_count()) return 0.0;
+
+	// polled again within the same frame
+	const auto frame = Engine::get_singleton()->get_process_frames();
+	const auto frames = frame - monitor_last_frame[idx];
+	if (frames == 0) return monitor_last_result[idx];
+
+	// a reset() in between makes the counters go back down
+	const auto value = monitor_raw_value(idx);
+	const auto diff = value >= monitor_last_value[idx] ? value - monitor_last_value[idx] : value;
+
+	monitor_last_value[idx] = value;
+	monitor_last_frame[idx] = frame;
+	monitor_last_result[idx] = static_cast<double>(diff) / static_cast<double>(frames);
+	return monitor_last_result[idx];
+}
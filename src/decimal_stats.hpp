@@ -0,0 +1,115 @@
+#pragma once
+
+#include "godot_cpp/classes/object.hpp"
+#include "godot_cpp/classes/wrapped.hpp"
+#include "godot_cpp/variant/dictionary.hpp"
+#include "godot_cpp/variant/string.hpp"
+#include "godot_cpp/variant/vector4i.hpp"
+
+#include "decimal.hpp"
+#include "decimal_counters.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+using namespace godot;
+
+// Reading and resetting the counters of decimal_counters.hpp, and showing
+// them as custom monitors in the editor's profiler. Everything is there in
+// every build, but the counters only move in builds with DECIMAL_STATS.
+class DecimalStats : public Object {
+
+	GDCLASS(DecimalStats, Object)
+
+protected:
+	static auto _bind_methods() -> void;
+
+public:
+	static auto is_available() -> bool;
+
+	static auto set_enabled(const bool enabled) -> void;
+	static auto is_enabled() -> bool;
+
+	static auto set_timing_enabled(const bool enabled) -> void;
+	static auto is_timing_enabled() -> bool;
+
+	static auto snapshot() -> Dictionary;
+	static auto reset() -> void;
+
+	// called while the extension loads and unloads
+	static auto add_monitors() -> void;
+	static auto remove_monitors() -> void;
+
+	// what the monitors call, with the monitor's index
+	static auto get_monitor_value(const int64_t idx) -> double;
+};
+
+// Wraps a bound static method so every call is counted in its own slot,
+// timed when timing is on, and checked for NaN and infinite results. Used
+// through DECIMAL_COUNTED() when binding.
+template <auto F>
+struct DecimalCounted;
+
+template <typename R, typename... Args, R (*F)(Args...)>
+struct DecimalCounted<F> {
+	static inline int slot = -1;
+
+	static auto count_result(const Vector4i res) -> void {
+		count_result(to_decimal(res).mantissa);
+	}
+
+	static auto count_result(const double res) -> void {
+		if (unlikely(!std::isfinite(res))) {
+			decimal_counters::hit(std::isnan(res) ? decimal_counters::NAN_RESULT : decimal_counters::INF_RESULT);
+		}
+	}
+
+	template <typename T>
+	static auto count_result(const T &) -> void {}
+
+	struct Timer {
+		std::chrono::steady_clock::time_point start;
+		bool active = decimal_counters::is_timing();
+
+		Timer() {
+			if (active) start = std::chrono::steady_clock::now();
+		}
+
+		~Timer() {
+			if (!active) return;
+			const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+			decimal_counters::methods[slot].nanos.fetch_add(elapsed.count(), std::memory_order_relaxed);
+		}
+	};
+
+	static auto call(Args... args) -> R {
+		if (!decimal_counters::is_enabled() || slot < 0) {
+			return F(args...);
+		}
+		decimal_counters::methods[slot].calls.fetch_add(1, std::memory_order_relaxed);
+
+		const Timer timer;
+		if constexpr (std::is_void_v<R>) {
+			F(args...);
+		} else {
+			R res = F(args...);
+			count_result(res);
+			return res;
+		}
+	}
+
+	static auto bind(const char *name) -> R (*)(Args...) {
+		if (slot < 0) {
+			slot = decimal_counters::register_method(name);
+		}
+		return &call;
+	}
+};
+
+#ifdef DECIMAL_STATS
+	#define DECIMAL_COUNTED(cls, method) DecimalCounted<&cls::method>::bind(#method)
+#else
+	#define DECIMAL_COUNTED(cls, method) &cls::method
+#endif
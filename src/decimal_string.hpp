@@ -0,0 +1,713 @@
+#pragma once
+
+// Text conversion for decimals, without any Godot dependency. Everything writes
+// into a caller-provided buffer, so building a godot::String out of the result
+// is the only allocation. Parsing reads straight from the caller's characters
+// and doesn't allocate at all.
+//
+// Digits are generated with exact integer arithmetic. A mantissa in [1, 10) is
+// M * 2^-q for a 53-bit M, so M * 10^17 fits in 128 bits and every digit we
+// could ever print (plus the rounding interval around it) is exact. No fmod,
+// no repeated multiplying by 10, no drift.
+
+#include "decimal_core.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace decimal_string {
+
+// Plenty for a sign, 18 digits, a dot, "e-" and 19 exponent digits.
+constexpr const int64_t BUF_SIZE = 64;
+
+// Digits past this many decimal places after the leading one aren't tracked.
+constexpr const int64_t MAX_PLACES = 17;
+
+struct u128 {
+	uint64_t hi;
+	uint64_t lo;
+};
+
+inline auto mul_64x64(const uint64_t a, const uint64_t b) -> u128 {
+#if defined(__SIZEOF_INT128__)
+	const auto p = static_cast<unsigned __int128>(a) * b;
+	return { static_cast<uint64_t>(p >> 64), static_cast<uint64_t>(p) };
+#else
+	const uint64_t a_lo = a & 0xffffffff, a_hi = a >> 32;
+	const uint64_t b_lo = b & 0xffffffff, b_hi = b >> 32;
+
+	const uint64_t ll = a_lo * b_lo;
+	const uint64_t lh = a_lo * b_hi;
+	const uint64_t hl = a_hi * b_lo;
+	const uint64_t hh = a_hi * b_hi;
+
+	const uint64_t mid = (ll >> 32) + (lh & 0xffffffff) + (hl & 0xffffffff);
+	return { hh + (lh >> 32) + (hl >> 32) + (mid >> 32), (mid << 32) | (ll & 0xffffffff) };
+#endif
+}
+
+// v << s, for 0 < s < 64
+constexpr auto shl(const uint64_t v, const int s) -> u128 {
+	return { v >> (64 - s), v << s };
+}
+
+// v >> s, for 0 < s < 64, when the result is known to fit
+constexpr auto shr(const u128 v, const int s) -> uint64_t {
+	return (v.lo >> s) | (v.hi << (64 - s));
+}
+
+constexpr auto add(const u128 a, const u128 b) -> u128 {
+	return { a.hi + b.hi + (a.lo + b.lo < a.lo), a.lo + b.lo };
+}
+
+constexpr auto sub(const u128 a, const u128 b) -> u128 {
+	return { a.hi - b.hi - (a.lo < b.lo), a.lo - b.lo };
+}
+
+constexpr auto lt(const u128 a, const u128 b) -> bool {
+	return a.hi != b.hi ? a.hi < b.hi : a.lo < b.lo;
+}
+
+constexpr auto le(const u128 a, const u128 b) -> bool {
+	return !lt(b, a);
+}
+
+// n / d, for when the quotient is known to fit in 64 bits (n.hi < d)
+inline auto div_128x64(const u128 n, const uint64_t d, uint64_t &rem) -> uint64_t {
+#if defined(__SIZEOF_INT128__)
+	const auto num = (static_cast<unsigned __int128>(n.hi) << 64) | n.lo;
+	rem = static_cast<uint64_t>(num % d);
+	return static_cast<uint64_t>(num / d);
+#else
+	uint64_t hi = n.hi;
+	uint64_t lo = n.lo;
+	uint64_t q = 0;
+	for (int i = 0; i < 64; i++) {
+		const auto carry = hi >> 63;
+		hi = (hi << 1) | (lo >> 63);
+		lo <<= 1;
+		q <<= 1;
+		if (carry != 0 || hi >= d) {
+			hi -= d;
+			q |= 1;
+		}
+	}
+	rem = hi;
+	return q;
+#endif
+}
+
+constexpr const uint64_t POW10_U64[] = {
+	1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull,
+	100000000ull, 1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull,
+	10000000000000ull, 100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+	100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull,
+};
+
+// `count` significant digits, read as d.ddd * 10^exponent
+struct Digits {
+	uint64_t digits;
+	int64_t count;
+	int64_t exponent;
+	bool negative;
+};
+
+// The mantissa scaled by 10^17 and by 2^shift, along with the bounds of the
+// interval of values that would still round to it.
+struct Scaled {
+	u128 value;
+	u128 low;
+	u128 high;
+	uint64_t integral; // value >> shift
+	int shift;
+	bool inclusive;
+};
+
+// `abs` has to be in [1, 10)
+inline auto scale(const double abs) -> Scaled {
+	constexpr const uint64_t HIDDEN_BIT = uint64_t(1) << 52;
+
+	uint64_t bits;
+	memcpy(&bits, &abs, sizeof(bits));
+
+	const auto m2 = (bits & (HIDDEN_BIT - 1)) | HIDDEN_BIT;
+	const auto exp2 = static_cast<int>(bits >> 52) - 1023; // [0, 3]
+
+	// abs == m2 * 2^-(52 - exp2), and everything is scaled by 4 so that the
+	// half-ulp bounds are integers too
+	Scaled s;
+	s.shift = 52 - exp2 + 2;
+	s.value = mul_64x64(m2 * 4, POW10_U64[17]);
+	s.integral = shr(s.value, s.shift);
+
+	// the gap below is half as wide if we're sitting right on a power of 2
+	const auto below = (m2 == HIDDEN_BIT) ? POW10_U64[17] : 2 * POW10_U64[17];
+	s.low = sub(s.value, u128 { 0, below });
+	s.high = add(s.value, u128 { 0, 2 * POW10_U64[17] });
+
+	// round-to-even means ties go to an even mantissa, so its bounds are included
+	s.inclusive = (m2 % 2) == 0;
+	return s;
+}
+
+inline auto in_interval(const Scaled &s, const u128 v) -> bool {
+	return s.inclusive ?
+		le(s.low, v) && le(v, s.high) :
+		lt(s.low, v) && lt(v, s.high);
+}
+
+// Tries to find a `count` digit number that rounds back to the same double,
+// picking the closest one if there are two.
+inline auto try_digits(const Scaled &s, const int64_t count, uint64_t &out) -> bool {
+	const auto unit = POW10_U64[18 - count];
+	const auto below = s.integral / unit;
+
+	const auto v_below = shl(below * unit, s.shift);
+	const auto v_above = shl((below + 1) * unit, s.shift);
+
+	const auto ok_below = in_interval(s, v_below);
+	const auto ok_above = in_interval(s, v_above);
+
+	if (ok_below && ok_above) {
+		const auto d_below = sub(s.value, v_below);
+		const auto d_above = sub(v_above, s.value);
+		out = lt(d_below, d_above) ? below :
+		      lt(d_above, d_below) ? below + 1 :
+		      (below % 2 == 0) ? below : below + 1;
+		return true;
+	}
+
+	if (ok_below || ok_above) {
+		out = ok_below ? below : below + 1;
+		return true;
+	}
+	return false;
+}
+
+// Splits a finite, non-zero decimal into digits. The mantissa is expected to
+// be normalized; if it isn't, it gets normalized first.
+inline auto prepare(const DecimalData &dec) -> DecimalData {
+	const auto abs = std::abs(dec.mantissa);
+	if (DECIMAL_LIKELY(abs >= 1.0 && abs < 10.0)) {
+		return dec;
+	}
+	return decimal_core::normalize(dec);
+}
+
+// The fewest digits that still parse back to exactly the same mantissa.
+inline auto shortest_digits(const DecimalData &dec) -> Digits {
+	const auto d = prepare(dec);
+	const auto s = scale(std::abs(d.mantissa));
+
+	// the interval, as the range [first, last] of 18 digit integers inside it
+	const auto mask = (uint64_t(1) << s.shift) - 1;
+	const auto low_exact = (s.low.lo & mask) == 0;
+	const auto high_exact = (s.high.lo & mask) == 0;
+	const auto first = shr(s.low, s.shift) + ((low_exact && s.inclusive) ? 0 : 1);
+	const auto last = shr(s.high, s.shift) - ((high_exact && !s.inclusive) ? 1 : 0);
+
+	// keep dropping digits as long as some number that ends with that many
+	// zeros is still in there (there always is one with 17 digits)
+	auto below_first = first - 1;
+	auto upper = last;
+	int64_t dropped = 0;
+	while (upper / 10 > below_first / 10) {
+		upper /= 10;
+		below_first /= 10;
+		dropped++;
+	}
+
+	const auto count = 18 - dropped;
+	uint64_t found = 0;
+	try_digits(s, count, found);
+
+	return Digits { found, count, d.exponent, std::signbit(d.mantissa) };
+}
+
+// `places + 1` significant digits, rounded half away from zero
+inline auto fixed_digits(const DecimalData &dec, const int64_t places) -> Digits {
+	const auto d = prepare(dec);
+	const auto s = scale(std::abs(d.mantissa));
+
+	const auto count = places + 1;
+	const auto unit = POW10_U64[18 - count];
+	auto digits = s.integral / unit;
+
+	// unit << (shift - 1) is half a unit, at the same scale as the remainder
+	const auto rem = sub(s.value, shl(digits * unit, s.shift));
+	if (le(shl(unit, s.shift - 1), rem)) {
+		digits++;
+	}
+
+	auto exponent = d.exponent;
+	if (digits == POW10_U64[count]) {
+		// there's no next exponent at the very top, stay at 9.99...
+		if (DECIMAL_UNLIKELY(exponent == INT64_MAX)) {
+			digits--;
+		} else {
+			digits /= 10;
+			exponent++;
+		}
+	}
+
+	return Digits { digits, count, exponent, std::signbit(d.mantissa) };
+}
+
+// Writes `count` digits of `digits`, returns the number of chars written.
+inline auto write_digits(char *buf, uint64_t digits, const int64_t count) -> int64_t {
+	for (int64_t i = count - 1; i >= 0; i--) {
+		buf[i] = static_cast<char>('0' + digits % 10);
+		digits /= 10;
+	}
+	return count;
+}
+
+inline auto write_exponent(char *buf, const int64_t exponent) -> int64_t {
+	int64_t len = 0;
+	buf[len++] = 'e';
+	buf[len++] = exponent < 0 ? '-' : '+';
+
+	// goes through unsigned so that INT64_MIN doesn't overflow
+	auto abs = exponent < 0 ? 0 - static_cast<uint64_t>(exponent) : static_cast<uint64_t>(exponent);
+
+	char tmp[20];
+	int64_t n = 0;
+	do {
+		tmp[n++] = static_cast<char>('0' + abs % 10);
+		abs /= 10;
+	} while (abs != 0);
+
+	while (n > 0) {
+		buf[len++] = tmp[--n];
+	}
+	return len;
+}
+
+inline auto write_non_finite(char *buf, const double m) -> int64_t {
+	const char *str = std::isnan(m) ? "nan" : m < 0 ? "-inf" : "inf";
+	const auto len = static_cast<int64_t>(strlen(str));
+	memcpy(buf, str, len + 1);
+	return len;
+}
+
+// d.ddde+x
+inline auto write_exponential(char *buf, const Digits &d) -> int64_t {
+	int64_t len = 0;
+	if (d.negative) {
+		buf[len++] = '-';
+	}
+
+	char digits[20] = {};
+	write_digits(digits, d.digits, d.count);
+
+	buf[len++] = digits[0];
+	if (d.count > 1) {
+		buf[len++] = '.';
+		memcpy(buf + len, digits + 1, d.count - 1);
+		len += d.count - 1;
+	}
+
+	len += write_exponent(buf + len, d.exponent);
+	buf[len] = '\0';
+	return len;
+}
+
+// Scientific notation, like "1.2345e+67". With `places` == -1 it uses as few
+// digits as it takes to round-trip, otherwise exactly `places` digits after the
+// dot (clamped to [1, MAX_PLACES]). Returns the length, and null terminates.
+inline auto to_exponential(const DecimalData &dec, const int64_t places, char *buf) -> int64_t {
+	if (DECIMAL_UNLIKELY(!std::isfinite(dec.mantissa))) {
+		return write_non_finite(buf, dec.mantissa);
+	}
+
+	Digits d;
+	if (dec.mantissa == 0) {
+		d = Digits { 0, places == -1 ? 1 : 1 + std::min(std::max(places, int64_t(1)), MAX_PLACES), 0, std::signbit(dec.mantissa) };
+	} else {
+		d = places == -1 ?
+			shortest_digits(dec) :
+			fixed_digits(dec, std::min(std::max(places, int64_t(1)), MAX_PLACES));
+	}
+
+	return write_exponential(buf, d);
+}
+
+// Plain notation ("123.45", "0.001", "1.0") for exponents within
+// [MIN_DISPLAYABLE_EXP, MAX_DISPLAYABLE_EXP], shortest scientific notation
+// otherwise. Returns the length, and null terminates.
+inline auto to_string(const DecimalData &dec, char *buf) -> int64_t {
+	if (DECIMAL_UNLIKELY(!std::isfinite(dec.mantissa))) {
+		return write_non_finite(buf, dec.mantissa);
+	}
+
+	if (dec.mantissa == 0) {
+		const char *str = std::signbit(dec.mantissa) ? "-0.0" : "0.0";
+		const auto len = static_cast<int64_t>(strlen(str));
+		memcpy(buf, str, len + 1);
+		return len;
+	}
+
+	const auto d = shortest_digits(dec);
+	if (d.exponent > MAX_DISPLAYABLE_EXP || d.exponent < MIN_DISPLAYABLE_EXP) {
+		return write_exponential(buf, d);
+	}
+
+	char digits[20] = {};
+	write_digits(digits, d.digits, d.count);
+
+	int64_t len = 0;
+	if (d.negative) {
+		buf[len++] = '-';
+	}
+
+	if (d.exponent < 0) {
+		// 0.000ddd
+		buf[len++] = '0';
+		buf[len++] = '.';
+		for (int64_t i = 0; i < -d.exponent - 1; i++) {
+			buf[len++] = '0';
+		}
+		memcpy(buf + len, digits, d.count);
+		len += d.count;
+	} else {
+		// ddd[000].ddd, with at least one digit after the dot
+		const auto int_len = d.exponent + 1;
+		for (int64_t i = 0; i < int_len; i++) {
+			buf[len++] = i < d.count ? digits[i] : '0';
+		}
+		buf[len++] = '.';
+		if (d.count > int_len) {
+			memcpy(buf + len, digits + int_len, d.count - int_len);
+			len += d.count - int_len;
+		} else {
+			buf[len++] = '0';
+		}
+	}
+
+	buf[len] = '\0';
+	return len;
+}
+
+// Parsing
+
+enum class ParseError {
+	OK,
+	EMPTY,
+	UNEXPECTED_CHAR,
+	NO_DIGITS,
+	NO_EXPONENT_DIGITS,
+	EXPONENT_OUT_OF_RANGE,
+};
+
+struct ParseResult {
+	ParseError error;
+	int64_t position; // index of the offending character, or the length on success
+};
+
+inline auto get_parse_error_message(const ParseError error) -> const char * {
+	switch (error) {
+		case ParseError::OK: return "no error";
+		case ParseError::EMPTY: return "the string is empty";
+		case ParseError::UNEXPECTED_CHAR: return "unexpected character";
+		case ParseError::NO_DIGITS: return "no digits in the mantissa";
+		case ParseError::NO_EXPONENT_DIGITS: return "no digits in the exponent";
+		case ParseError::EXPONENT_OUT_OF_RANGE: return "exponent doesn't fit in 64 bits";
+	}
+	return "unknown error";
+}
+
+// More significant digits than this can't change the double we end up with,
+// they only decide which way a tie rounds.
+constexpr const int64_t MAX_PARSED_DIGITS = 19;
+
+template <typename Char>
+constexpr auto digit_value(const Char c) -> uint32_t {
+	// wraps around for anything below '0', so one compare covers both sides
+	return static_cast<uint32_t>(c) - '0';
+}
+
+// case-insensitive match against a lowercase ASCII word
+template <typename Char>
+inline auto match_word(const Char *str, const int64_t len, const char *word) -> bool {
+	const auto word_len = static_cast<int64_t>(strlen(word));
+	if (len != word_len) return false;
+
+	for (int64_t i = 0; i < len; i++) {
+		if ((static_cast<uint32_t>(str[i]) | 0x20) != static_cast<uint32_t>(word[i])) return false;
+	}
+	return true;
+}
+
+inline auto checked_add(const int64_t a, const int64_t b, int64_t &out) -> bool {
+	if ((b > 0 && a > INT64_MAX - b) || (b < 0 && a < INT64_MIN - b)) return false;
+	out = a + b;
+	return true;
+}
+
+// Compares the significant digits in str[first, end) (dots skipped), read as
+// d.ddd, against (2 * q + 1) / 2^(shift + 1), which is the point halfway
+// between q and q + 1 at that shift. That midpoint has at most 54 significant
+// digits, and each one can be made exactly in 64 bits.
+template <typename Char>
+inline auto cmp_midpoint(const Char *str, int64_t first, const int64_t end, const uint64_t q, const int shift) -> int {
+	const auto mid = 2 * q + 1;
+	const auto bits = shift + 1;
+	const auto mask = (uint64_t(1) << bits) - 1;
+
+	uint64_t digit = mid >> bits;
+	uint64_t frac = mid & mask;
+
+	for (;; first++) {
+		while (first < end && str[first] == '.') first++;
+		if (first >= end) {
+			// out of input digits, the rest are zeros
+			return (frac != 0 || digit != 0) ? -1 : 0;
+		}
+
+		const auto d = digit_value(str[first]);
+		if (d != digit) return d < digit ? -1 : 1;
+
+		frac *= 10;
+		digit = frac >> bits;
+		frac &= mask;
+
+		if (digit == 0 && frac == 0) {
+			// the midpoint ran out, see if anything non-zero is left
+			for (first++; first < end; first++) {
+				if (str[first] != '.' && str[first] != '0') return 1;
+			}
+			return 0;
+		}
+	}
+}
+
+// `digits` holds the first `count` significant digits of str[first, end),
+// read as d.ddd. `sticky` is set if any of the digits after them are non-zero.
+// Rounds to the nearest double, ties to even.
+template <typename Char>
+inline auto digits_to_mantissa(
+	const uint64_t digits, const int64_t count, const bool sticky,
+	const Char *str, const int64_t first, const int64_t end
+) -> double {
+	const auto p = POW10_U64[count - 1];
+
+	// both sides are exact as doubles, so a single division rounds correctly
+	if (DECIMAL_LIKELY(!sticky && digits <= (uint64_t(1) << 53))) {
+		return static_cast<double>(digits) / static_cast<double>(p);
+	}
+
+	// digits / p is in [1, 10), find which power of 2 it's above
+	int shift = 52;
+	if (digits >= p * 2) shift--;
+	if (digits >= p * 4) shift--;
+	if (digits >= p * 8) shift--;
+
+	uint64_t rem;
+	auto q = div_128x64(shl(digits, shift), p, rem);
+
+	// p is at most 10^18, so doubling the remainder can't overflow
+	bool up = rem * 2 > p || (rem * 2 == p && (sticky || (q & 1) != 0));
+
+	// The digits that got cut off are worth less than one unit of `digits`.
+	// If that's enough to cross the midpoint, only the full input can tell.
+	const auto unit = uint64_t(1) << shift;
+	if (DECIMAL_UNLIKELY(sticky && !up && (rem + unit) * 2 > p)) {
+		const auto c = cmp_midpoint(str, first, end, q, shift);
+		up = c > 0 || (c == 0 && (q & 1) != 0);
+	}
+
+	if (up) {
+		q++;
+	}
+
+	// q <= 2^53 here, so this is exact
+	return std::ldexp(static_cast<double>(q), -shift);
+}
+
+// Accepts "[+-]digits[.digits][(e|E)[+-]digits]" (either side of the dot can
+// be empty, but not both) along with "inf", "infinity" and "nan" in any case.
+// The whole range has to be consumed, so surrounding whitespace is an error.
+// `out` is only written on success.
+template <typename Char>
+inline auto parse(const Char *str, const int64_t len, DecimalData &out) -> ParseResult {
+	if (len <= 0) {
+		return { ParseError::EMPTY, 0 };
+	}
+
+	int64_t i = 0;
+	bool negative = false;
+	if (str[0] == '+' || str[0] == '-') {
+		negative = str[0] == '-';
+		i++;
+	}
+
+	if (i < len && digit_value(str[i]) > 9 && str[i] != '.') {
+		if (match_word(str + i, len - i, "inf") || match_word(str + i, len - i, "infinity")) {
+			out = negative ? decimal_core::DECIMAL_INF_NEG : decimal_core::DECIMAL_INF;
+			return { ParseError::OK, len };
+		}
+		if (match_word(str + i, len - i, "nan")) {
+			out = decimal_core::DECIMAL_NAN;
+			return { ParseError::OK, len };
+		}
+		return { ParseError::UNEXPECTED_CHAR, i };
+	}
+
+	uint64_t digits = 0;
+	int64_t count = 0;
+	int64_t first = -1;
+	bool sticky = false;
+	bool any_digits = false;
+
+	// value == digits * 10^shift_10, before the exponent part
+	int64_t shift_10 = 0;
+
+	for (; i < len && digit_value(str[i]) <= 9; i++) {
+		const auto d = digit_value(str[i]);
+		any_digits = true;
+		if (count < MAX_PARSED_DIGITS) {
+			if (d != 0 || count != 0) {
+				first = count == 0 ? i : first;
+				digits = digits * 10 + d;
+				count++;
+			}
+		} else {
+			sticky |= d != 0;
+			shift_10++;
+		}
+	}
+
+	if (i < len && str[i] == '.') {
+		for (i++; i < len && digit_value(str[i]) <= 9; i++) {
+			const auto d = digit_value(str[i]);
+			any_digits = true;
+			if (count < MAX_PARSED_DIGITS) {
+				if (d != 0 || count != 0) {
+					first = count == 0 ? i : first;
+					digits = digits * 10 + d;
+					count++;
+				}
+				shift_10--;
+			} else {
+				sticky |= d != 0;
+			}
+		}
+	}
+
+	if (!any_digits) {
+		return { ParseError::NO_DIGITS, i };
+	}
+
+	const auto mantissa_end = i;
+
+	int64_t exponent = 0;
+	if (i < len && (str[i] == 'e' || str[i] == 'E')) {
+		i++;
+		bool exp_negative = false;
+		if (i < len && (str[i] == '+' || str[i] == '-')) {
+			exp_negative = str[i] == '-';
+			i++;
+		}
+
+		if (i >= len || digit_value(str[i]) > 9) {
+			return { ParseError::NO_EXPONENT_DIGITS, i };
+		}
+
+		// the magnitude can go up to 2^63 for INT64_MIN
+		const auto limit = static_cast<uint64_t>(INT64_MAX) + (exp_negative ? 1 : 0);
+		uint64_t magnitude = 0;
+		for (; i < len && digit_value(str[i]) <= 9; i++) {
+			const auto d = digit_value(str[i]);
+			if (magnitude > (limit - d) / 10) {
+				return { ParseError::EXPONENT_OUT_OF_RANGE, i };
+			}
+			magnitude = magnitude * 10 + d;
+		}
+
+		exponent = exp_negative ? static_cast<int64_t>(0 - magnitude) : static_cast<int64_t>(magnitude);
+	}
+
+	if (i != len) {
+		return { ParseError::UNEXPECTED_CHAR, i };
+	}
+
+	if (digits == 0) {
+		out = DecimalData(negative ? -0.0 : 0.0, 0);
+		return { ParseError::OK, len };
+	}
+
+	if (!checked_add(exponent, shift_10 + count - 1, exponent)) {
+		return { ParseError::EXPONENT_OUT_OF_RANGE, len };
+	}
+
+	auto mantissa = digits_to_mantissa(digits, count, sticky, str, first, mantissa_end);
+	if (DECIMAL_UNLIKELY(mantissa >= 10.0)) {
+		if (!checked_add(exponent, 1, exponent)) {
+			return { ParseError::EXPONENT_OUT_OF_RANGE, len };
+		}
+		mantissa = 1.0;
+	}
+
+	out = DecimalData(negative ? -mantissa : mantissa, exponent);
+	return { ParseError::OK, len };
+}
+
+// Lists of values, as in a save file, are separated by whitespace and/or commas.
+template <typename Char>
+constexpr auto is_separator(const Char c) -> bool {
+	return c == ' ' || c == ',' || c == '\n' || c == '\r' || c == '\t';
+}
+
+inline auto count_tokens(const char *text, const int64_t len) -> int64_t {
+	int64_t count = 0;
+	bool in_token = false;
+	for (int64_t i = 0; i < len; i++) {
+		const auto sep = is_separator(text[i]);
+		count += (!sep && !in_token) ? 1 : 0;
+		in_token = !sep;
+	}
+	return count;
+}
+
+struct ListError {
+	int64_t index;   // which value failed first, -1 if none did
+	int64_t offset;  // where in the text that value starts
+	ParseResult result;
+	int64_t count;   // how many values failed in total
+};
+
+// Parses every value in `text` into `out`, which needs room for
+// count_tokens(text, len) values. Values that fail to parse become NaN.
+inline auto parse_list(const char *text, const int64_t len, DecimalData *out) -> ListError {
+	ListError err = { -1, 0, { ParseError::OK, 0 }, 0 };
+
+	int64_t n = 0;
+	int64_t i = 0;
+	while (i < len) {
+		if (is_separator(text[i])) {
+			i++;
+			continue;
+		}
+
+		const auto start = i;
+		while (i < len && !is_separator(text[i])) {
+			i++;
+		}
+
+		const auto res = parse(text + start, i - start, out[n]);
+		if (DECIMAL_UNLIKELY(res.error != ParseError::OK)) {
+			out[n] = decimal_core::DECIMAL_NAN;
+			if (err.count == 0) {
+				err.index = n;
+				err.offset = start;
+				err.result = res;
+			}
+			err.count++;
+		}
+		n++;
+	}
+	return err;
+}
+
+} // namespace decimal_string
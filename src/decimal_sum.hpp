@@ -0,0 +1,145 @@
+#pragma once
+
+// Sums many decimals without normalizing after every addition, and without
+// losing addends that are much smaller than the total.
+//
+// decimal_core::add() normalizes its result (one log10 per call), and drops
+// the smaller operand outright once the exponents are MAX_SIGNIFICANT_DIGITS
+// apart, so a million small incomes added to a large balance one by one don't
+// show up at all. The Accumulator keeps the running sum as a plain double at a
+// fixed reference exponent instead, with a Neumaier compensation term that
+// catches what rounding drops from each addition. Addends are only scaled by
+// a power of 10 from the lookup table to get there. The reference exponent
+// only moves when the sum drifts far enough that the double could run out of
+// range, and normalizing happens when the sum is read.
+
+#include "decimal_core.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace decimal_sum {
+
+// the sum is kept within [1e-DRIFT_LIMIT, 1e+DRIFT_LIMIT] of the reference
+// exponent, far enough from the double range that addends can't overflow it
+constexpr const int64_t DRIFT_LIMIT = 150;
+
+// a - b, saturated to the int64 range. Exponents can be anywhere in it, so
+// the plain difference can overflow (see decimal_core::add()).
+inline auto exponent_diff(const int64_t a, const int64_t b) -> int64_t {
+	constexpr const auto MAX = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+	if (a >= b) {
+		const auto diff = static_cast<uint64_t>(a) - static_cast<uint64_t>(b);
+		return diff > MAX ? std::numeric_limits<int64_t>::max() : static_cast<int64_t>(diff);
+	}
+	const auto diff = static_cast<uint64_t>(b) - static_cast<uint64_t>(a);
+	return diff > MAX ? std::numeric_limits<int64_t>::min() : -static_cast<int64_t>(diff);
+}
+
+class Accumulator {
+	double sum = 0.0;
+	double compensation = 0.0;
+	int64_t exponent = 0;
+
+	// infinities and NaN are summed separately, so they can't poison the
+	// compensation
+	double special = 0.0;
+
+	// moves the reference exponent, keeping sum * 10^exponent the same
+	auto rebase(const int64_t new_exponent) -> void {
+		auto shift = exponent_diff(exponent, new_exponent);
+		exponent = new_exponent;
+		if (shift < -POW10_OFFSET) {
+			sum = 0.0;
+			compensation = 0.0;
+			return;
+		}
+		// a subnormal sum can need more than the largest power in the table
+		if (shift > 300) {
+			sum *= 1e300;
+			compensation *= 1e300;
+			shift -= 300;
+		}
+		const auto scale = decimal_core::pow10(shift);
+		sum *= scale;
+		compensation *= scale;
+	}
+
+	// back near 10^0 once the sum has drifted too far either way
+	auto recenter() -> void {
+		const auto total = sum + compensation;
+		if (total == 0.0) {
+			sum = 0.0;
+			compensation = 0.0;
+			return;
+		}
+		rebase(decimal_core::normalize(DecimalData(total, exponent)).exponent);
+	}
+
+public:
+	auto reset(const DecimalData &start = decimal_core::DECIMAL_ZERO) -> void {
+		sum = 0.0;
+		compensation = 0.0;
+		exponent = 0;
+		special = 0.0;
+		add(start);
+	}
+
+	auto add(const DecimalData &dec) -> void {
+		namespace core = decimal_core;
+
+		if (DECIMAL_UNLIKELY(!std::isfinite(dec.mantissa))) {
+			special += dec.mantissa;
+			return;
+		}
+		if (dec.mantissa == 0.0) return;
+
+		// an empty sum takes the exponent of whatever comes first
+		if (sum == 0.0 && compensation == 0.0) {
+			exponent = dec.exponent;
+		}
+
+		auto shift = exponent_diff(dec.exponent, exponent);
+		if (DECIMAL_UNLIKELY(shift > DRIFT_LIMIT)) {
+			rebase(dec.exponent);
+			shift = 0;
+		}
+		// too small to matter even to the compensation
+		if (DECIMAL_UNLIKELY(shift < -POW10_OFFSET)) return;
+
+		const auto x = dec.mantissa * core::pow10(shift);
+
+		// Neumaier: whichever operand is smaller loses bits to rounding,
+		// and exactly those bits go into the compensation
+		const auto t = sum + x;
+		if (std::abs(sum) >= std::abs(x)) {
+			compensation += (sum - t) + x;
+		} else {
+			compensation += (x - t) + sum;
+		}
+		sum = t;
+
+		const auto magnitude = std::abs(sum);
+		if (DECIMAL_UNLIKELY(magnitude > 1e150 || magnitude < 1e-150)) {
+			recenter();
+		}
+	}
+
+	auto add_many(const DecimalData *values, const int64_t count) -> void {
+		for (int64_t i = 0; i < count; i++) {
+			add(values[i]);
+		}
+	}
+
+	auto read() const -> DecimalData {
+		namespace core = decimal_core;
+
+		if (DECIMAL_UNLIKELY(special != 0.0)) {
+			return core::from_float(special);
+		}
+		return core::normalize(DecimalData(sum + compensation, exponent));
+	}
+};
+
+} // namespace decimal_sum
@@ -0,0 +1,84 @@
+#include "price_table.hpp"
+#include "godot_cpp/core/error_macros.hpp"
+#include "godot_cpp/core/object.hpp"
+#include <cstdint>
+#include <godot_cpp/core/class_db.hpp>
+
+using namespace godot;
+namespace price_table = decimal_price_table;
+namespace core = decimal_core;
+
+// 24 bytes an entry, so this is 384 MiB when filled all the way
+constexpr const int64_t MAX_LIMIT = 1 << 24;
+
+auto PriceTable::_bind_methods() -> void {
+	ClassDB::bind_static_method("PriceTable", D_METHOD("create_geometric", "price_start", "price_ratio", "limit"), &PriceTable::create_geometric, DEFVAL(1000));
+	ClassDB::bind_static_method("PriceTable", D_METHOD("create_arithmetic", "price_start", "price_add", "limit"), &PriceTable::create_arithmetic, DEFVAL(1000));
+
+	ClassDB::bind_method(D_METHOD("get_limit"), &PriceTable::get_limit);
+	ClassDB::bind_method(D_METHOD("get_filled"), &PriceTable::get_filled);
+	ClassDB::bind_method(D_METHOD("fill", "owned"), &PriceTable::fill);
+
+	ClassDB::bind_method(D_METHOD("price_of", "owned"), &PriceTable::price_of);
+	ClassDB::bind_method(D_METHOD("cost_of", "num_items", "owned"), &PriceTable::cost_of);
+	ClassDB::bind_method(D_METHOD("max_affordable", "res_available", "owned"), &PriceTable::max_affordable);
+}
+
+auto PriceTable::make(const char *fn, const decimal_curves::Curve &curve, const int64_t limit) -> Ref<PriceTable> {
+	ERR_FAIL_COND_V_MSG(limit < 0 || limit > MAX_LIMIT, Ref<PriceTable>(),
+		String("PriceTable.") + fn + "() - limit has to be between 0 and " + String::num_int64(MAX_LIMIT) + "."
+	);
+	ERR_FAIL_COND_V_MSG(core::sign(curve.price_start) != 1, Ref<PriceTable>(), String("PriceTable.") + fn + "() - price_start has to be positive.");
+
+	Ref<PriceTable> res;
+	res.instantiate();
+	res->table = price_table::make(curve, limit);
+	return res;
+}
+
+auto PriceTable::create_geometric(const Vector4i price_start, const Vector4i price_ratio, const int64_t limit) -> Ref<PriceTable> {
+	const auto ratio = to_decimal(price_ratio);
+	// With a ratio below 1, the prices shrink away to nothing next to the
+	// totals, and the differences between totals come out as rounding noise.
+	ERR_FAIL_COND_V_MSG(!(core::sign(ratio) == 1 && core::ge(ratio, core::DECIMAL_ONE)), Ref<PriceTable>(),
+		"PriceTable.create_geometric() - price_ratio has to be at least 1."
+	);
+
+	return make("create_geometric", decimal_curves::make_geometric(to_decimal(price_start), ratio), limit);
+}
+
+auto PriceTable::create_arithmetic(const Vector4i price_start, const Vector4i price_add, const int64_t limit) -> Ref<PriceTable> {
+	const auto add = to_decimal(price_add);
+	ERR_FAIL_COND_V_MSG(core::sign(add) == -1 || !core::is_finite(add), Ref<PriceTable>(), "PriceTable.create_arithmetic() - price_add cannot be negative.");
+
+	return make("create_arithmetic", decimal_curves::make_arithmetic(to_decimal(price_start), add), limit);
+}
+
+auto PriceTable::get_limit() const -> int64_t {
+	return table.limit;
+}
+
+auto PriceTable::get_filled() const -> int64_t {
+	return price_table::filled(table);
+}
+
+auto PriceTable::fill(const int64_t owned) -> void {
+	ERR_FAIL_COND_MSG(owned < 0, "PriceTable.fill() - owned cannot be negative.");
+	price_table::fill(table, owned < table.limit ? owned : table.limit);
+}
+
+auto PriceTable::price_of(const int64_t owned) const -> Vector4i {
+	ERR_FAIL_COND_V_MSG(owned < 0, Vector4i(), "PriceTable.price_of() - owned cannot be negative.");
+	return to_vector4i(price_table::price(table.curve, owned));
+}
+
+auto PriceTable::cost_of(const int64_t num_items, const int64_t owned) -> Vector4i {
+	ERR_FAIL_COND_V_MSG(num_items < 0, Vector4i(), "PriceTable.cost_of() - num_items cannot be negative.");
+	ERR_FAIL_COND_V_MSG(owned < 0, Vector4i(), "PriceTable.cost_of() - owned cannot be negative.");
+	return to_vector4i(price_table::cost(table, num_items, owned));
+}
+
+auto PriceTable::max_affordable(const Vector4i res_available, const int64_t owned) -> int64_t {
+	ERR_FAIL_COND_V_MSG(owned < 0, 0, "PriceTable.max_affordable() - owned cannot be negative.");
+	return price_table::afford(table, to_decimal(res_available), owned);
+}
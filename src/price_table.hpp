@@ -0,0 +1,39 @@
+#pragma once
+
+#include "godot_cpp/classes/ref_counted.hpp"
+#include "godot_cpp/variant/vector4i.hpp"
+
+#include "decimal.hpp"
+#include "decimal_price_table.hpp"
+
+#include <cstdint>
+
+using namespace godot;
+
+// One price curve with its cumulative costs written down, for answering the
+// "buy 1/10/100/max" buttons of a building every frame without any pow_num().
+// See decimal_price_table.hpp.
+class PriceTable : public RefCounted {
+
+	GDCLASS(PriceTable, RefCounted)
+
+protected:
+	static auto _bind_methods() -> void;
+
+private:
+	decimal_price_table::Table table;
+
+	static auto make(const char *fn, const decimal_curves::Curve &curve, const int64_t limit) -> Ref<PriceTable>;
+
+public:
+	static auto create_geometric(const Vector4i price_start, const Vector4i price_ratio, const int64_t limit = 1000) -> Ref<PriceTable>;
+	static auto create_arithmetic(const Vector4i price_start, const Vector4i price_add, const int64_t limit = 1000) -> Ref<PriceTable>;
+
+	auto get_limit() const -> int64_t;
+	auto get_filled() const -> int64_t;
+	auto fill(const int64_t owned) -> void;
+
+	auto price_of(const int64_t owned) const -> Vector4i;
+	auto cost_of(const int64_t num_items, const int64_t owned) -> Vector4i;
+	auto max_affordable(const Vector4i res_available, const int64_t owned) -> int64_t;
+};
@@ -5,7 +5,21 @@
 #include <godot_cpp/core/defs.hpp>
 #include <godot_cpp/godot.hpp>
 
+#include "cost_curve_set.hpp"
 #include "decimal.hpp"
+#include "decimal_accumulator.hpp"
+#include "decimal_array.hpp"
+#include "decimal_array_precision.hpp"
+#include "decimal_compact_array.hpp"
+#include "decimal_expression.hpp"
+#include "decimal_formatter.hpp"
+#include "decimal_ledger.hpp"
+#include "decimal_offline_progress.hpp"
+#include "decimal_purchase_planner.hpp"
+#include "decimal_simd.hpp"
+#include "decimal_stats.hpp"
+#include "price_table.hpp"
+#include "stat_graph.hpp"
 
 using namespace godot;
 
@@ -13,13 +27,34 @@ void initialize_gdextension_types(ModuleInitializationLevel p_level) {
 	if (p_level != MODULE_INITIALIZATION_LEVEL_SCENE) {
 		return;
 	}
+	// pick the widest batch kernels this CPU can run, once, before anything uses them
+	decimal_simd::init(decimal_simd::detect());
+
 	GDREGISTER_CLASS(Decimal);
+	GDREGISTER_CLASS(DecimalArray);
+	GDREGISTER_CLASS(DecimalFormatter);
+	GDREGISTER_CLASS(DecimalLedger);
+	GDREGISTER_CLASS(DecimalOfflineProgress);
+	GDREGISTER_CLASS(DecimalPurchasePlanner);
+	GDREGISTER_CLASS(CostCurveSet);
+	GDREGISTER_CLASS(DecimalExpression);
+	GDREGISTER_CLASS(DecimalAccumulator);
+	GDREGISTER_CLASS(DecimalStats);
+	GDREGISTER_CLASS(DecimalArray32);
+	GDREGISTER_CLASS(DecimalArray128);
+	GDREGISTER_CLASS(DecimalCompactArray);
+	GDREGISTER_CLASS(PriceTable);
+	GDREGISTER_CLASS(StatGraph);
+
+	// after Decimal, whose methods get a monitor each
+	DecimalStats::add_monitors();
 }
 
 void uninitialize_gdextension_types(ModuleInitializationLevel p_level) {
 	if (p_level != MODULE_INITIALIZATION_LEVEL_SCENE) {
 		return;
 	}
+	DecimalStats::remove_monitors();
 }
 
 extern "C" GDExtensionBool GDE_EXPORT library_init(
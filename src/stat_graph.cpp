@@ -0,0 +1,176 @@
+#include "stat_graph.hpp"
+#include "godot_cpp/core/error_macros.hpp"
+#include "godot_cpp/core/object.hpp"
+#include <cstdint>
+#include <godot_cpp/core/class_db.hpp>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace godot;
+namespace stat_graph = decimal_stat_graph;
+
+auto StatGraph::_bind_methods() -> void {
+	ClassDB::bind_method(D_METHOD("add_source", "name", "value"), &StatGraph::add_source, DEFVAL(Vector4i()));
+	ClassDB::bind_method(D_METHOD("add_formula", "name", "formula"), &StatGraph::add_formula);
+	ClassDB::bind_method(D_METHOD("get_error_text"), &StatGraph::get_error_text);
+
+	ClassDB::bind_method(D_METHOD("find", "name"), &StatGraph::find);
+	ClassDB::bind_method(D_METHOD("size"), &StatGraph::size);
+	ClassDB::bind_method(D_METHOD("clear"), &StatGraph::clear);
+
+	ClassDB::bind_method(D_METHOD("is_source", "idx"), &StatGraph::is_source);
+	ClassDB::bind_method(D_METHOD("is_dirty", "idx"), &StatGraph::is_dirty);
+	ClassDB::bind_method(D_METHOD("get_evaluation_count"), &StatGraph::get_evaluation_count);
+
+	ClassDB::bind_method(D_METHOD("set_value", "idx", "value"), &StatGraph::set_value);
+	ClassDB::bind_method(D_METHOD("set_values", "indices", "values"), &StatGraph::set_values);
+
+	ClassDB::bind_method(D_METHOD("get_value", "idx"), &StatGraph::get_value);
+	ClassDB::bind_method(D_METHOD("get_values", "indices", "out"), &StatGraph::get_values);
+	ClassDB::bind_method(D_METHOD("update"), &StatGraph::update);
+}
+
+auto StatGraph::check_name(const char *fn, const StringName &name) const -> bool {
+	// a valid name is a formula that's nothing but that one variable
+	const auto text = String(name).utf8();
+	const auto words = decimal_formula::variable_names(text.get_data(), text.length());
+	const auto valid = words.size() == 1 && words[0] == std::string(text.get_data(), text.length());
+
+	ERR_FAIL_COND_V_MSG(!valid, false,
+		String("StatGraph.") + fn + "() - \"" + String(name) + "\" is not a valid name, it has to work as a variable in a formula."
+	);
+	ERR_FAIL_COND_V_MSG(name_to_index.has(name), false,
+		String("StatGraph.") + fn + "() - there's already a node named \"" + String(name) + "\"."
+	);
+	// the compiled formulas refer to nodes by int32
+	ERR_FAIL_COND_V_MSG(size() >= std::numeric_limits<int32_t>::max(), false,
+		String("StatGraph.") + fn + "() - the graph is full."
+	);
+	return true;
+}
+
+auto StatGraph::add_source(const StringName &name, const Vector4i value) -> int64_t {
+	if (!check_name("add_source", name)) return -1;
+
+	const auto idx = stat_graph::add_source(graph, to_decimal(value));
+	name_to_index.insert(name, idx);
+	return idx;
+}
+
+auto StatGraph::add_formula(const StringName &name, const String &formula) -> int64_t {
+	if (!check_name("add_formula", name)) return -1;
+
+	// Only the names that are nodes go to the compiler, anything else is
+	// reported as an unknown variable.
+	const auto text = formula.utf8();
+	std::vector<std::string> names;
+	std::vector<int64_t> inputs;
+	for (auto &word : decimal_formula::variable_names(text.get_data(), text.length())) {
+		const auto *idx = name_to_index.getptr(StringName(String::utf8(word.c_str())));
+		if (idx) {
+			names.push_back(std::move(word));
+			inputs.push_back(*idx);
+		}
+	}
+
+	decimal_formula::Program program;
+	const auto err = decimal_formula::compile(text.get_data(), text.length(), names, program);
+	if (err.message != nullptr) {
+		error_text = String(err.message) + " (at position " + String::num_int64(err.position) + ")";
+		ERR_FAIL_V_MSG(-1, "StatGraph.add_formula() - can't compile the formula of \"" + String(name) + "\": " + error_text);
+	}
+	error_text = String();
+
+	const auto idx = stat_graph::add_derived(graph, std::move(program), inputs);
+	name_to_index.insert(name, idx);
+	return idx;
+}
+
+auto StatGraph::get_error_text() const -> String {
+	return error_text;
+}
+
+auto StatGraph::find(const StringName &name) const -> int64_t {
+	const auto *idx = name_to_index.getptr(name);
+	return idx ? *idx : -1;
+}
+
+auto StatGraph::size() const -> int64_t {
+	return static_cast<int64_t>(graph.nodes.size());
+}
+
+auto StatGraph::clear() -> void {
+	stat_graph::clear(graph);
+	name_to_index.clear();
+	error_text = String();
+}
+
+auto StatGraph::is_source(const int64_t idx) const -> bool {
+	ERR_FAIL_INDEX_V_MSG(idx, size(), false, "StatGraph.is_source() - index out of bounds.");
+	return stat_graph::is_source(graph, idx);
+}
+
+auto StatGraph::is_dirty(const int64_t idx) const -> bool {
+	ERR_FAIL_INDEX_V_MSG(idx, size(), false, "StatGraph.is_dirty() - index out of bounds.");
+	return graph.nodes[idx].dirty;
+}
+
+auto StatGraph::get_evaluation_count() const -> int64_t {
+	return graph.evaluations;
+}
+
+auto StatGraph::set_value(const int64_t idx, const Vector4i value) -> void {
+	ERR_FAIL_INDEX_MSG(idx, size(), "StatGraph.set_value() - index out of bounds.");
+	ERR_FAIL_COND_MSG(!stat_graph::is_source(graph, idx), "StatGraph.set_value() - only sources can be set, node " + String::num_int64(idx) + " has a formula.");
+	stat_graph::set_value(graph, idx, to_decimal(value));
+}
+
+auto StatGraph::set_values(const PackedInt64Array &indices, const Ref<DecimalArray> &values) -> void {
+	ERR_FAIL_COND_MSG(values.is_null(), "StatGraph.set_values() - `values` cannot be null.");
+	ERR_FAIL_COND_MSG(values->size() != indices.size(),
+		"StatGraph.set_values() - got " + String::num_int64(indices.size()) + " indices, but " + String::num_int64(values->size()) + " values."
+	);
+
+	// checked up front, so a bad index doesn't leave half the values set
+	const auto *ids = indices.ptr();
+	for (int64_t i = 0; i < indices.size(); i++) {
+		ERR_FAIL_INDEX_MSG(ids[i], size(), "StatGraph.set_values() - index " + String::num_int64(ids[i]) + " out of bounds.");
+		ERR_FAIL_COND_MSG(!stat_graph::is_source(graph, ids[i]), "StatGraph.set_values() - only sources can be set, node " + String::num_int64(ids[i]) + " has a formula.");
+	}
+
+	const auto *src = values->ptr();
+	for (int64_t i = 0; i < indices.size(); i++) {
+		stat_graph::set_value(graph, ids[i], src[i]);
+	}
+}
+
+auto StatGraph::get_value(const int64_t idx) -> Vector4i {
+	ERR_FAIL_INDEX_V_MSG(idx, size(), Vector4i(), "StatGraph.get_value() - index out of bounds.");
+	return to_vector4i(stat_graph::get(graph, idx));
+}
+
+auto StatGraph::get_values(const PackedInt64Array &indices, const Ref<DecimalArray> &out) -> void {
+	ERR_FAIL_COND_MSG(out.is_null(), "StatGraph.get_values() - `out` cannot be null.");
+
+	const auto *ids = indices.ptr();
+	for (int64_t i = 0; i < indices.size(); i++) {
+		ERR_FAIL_INDEX_MSG(ids[i], size(), "StatGraph.get_values() - index " + String::num_int64(ids[i]) + " out of bounds.");
+	}
+
+	// everything that's needed in one go, so shared inputs are only
+	// recomputed once
+	stat_graph::update(graph, ids, indices.size());
+
+	if (out->size() != indices.size()) {
+		out->resize(indices.size());
+	}
+	auto *dst = out->ptrw();
+	for (int64_t i = 0; i < indices.size(); i++) {
+		dst[i] = graph.values[ids[i]];
+	}
+}
+
+auto StatGraph::update() -> void {
+	stat_graph::update_all(graph);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "godot_cpp/classes/ref_counted.hpp"
+#include "godot_cpp/templates/hash_map.hpp"
+#include "godot_cpp/variant/packed_int64_array.hpp"
+#include "godot_cpp/variant/string.hpp"
+#include "godot_cpp/variant/string_name.hpp"
+#include "godot_cpp/variant/vector4i.hpp"
+
+#include "decimal_array.hpp"
+#include "decimal_stat_graph.hpp"
+
+#include <cstdint>
+
+using namespace godot;
+
+// Stats that are worked out from other stats (multipliers, costs, caps), kept
+// as a graph so only the ones below a changed input get recomputed, and only
+// when they're read. See decimal_stat_graph.hpp.
+class StatGraph : public RefCounted {
+
+	GDCLASS(StatGraph, RefCounted)
+
+protected:
+	static auto _bind_methods() -> void;
+
+private:
+	decimal_stat_graph::Graph graph;
+	HashMap<StringName, int64_t> name_to_index;
+	String error_text;
+
+	auto check_name(const char *fn, const StringName &name) const -> bool;
+
+public:
+	auto add_source(const StringName &name, const Vector4i value) -> int64_t;
+	auto add_formula(const StringName &name, const String &formula) -> int64_t;
+	auto get_error_text() const -> String;
+
+	auto find(const StringName &name) const -> int64_t;
+	auto size() const -> int64_t;
+	auto clear() -> void;
+
+	auto is_source(const int64_t idx) const -> bool;
+	auto is_dirty(const int64_t idx) const -> bool;
+	auto get_evaluation_count() const -> int64_t;
+
+	auto set_value(const int64_t idx, const Vector4i value) -> void;
+	auto set_values(const PackedInt64Array &indices, const Ref<DecimalArray> &values) -> void;
+
+	auto get_value(const int64_t idx) -> Vector4i;
+	auto get_values(const PackedInt64Array &indices, const Ref<DecimalArray> &out) -> void;
+	auto update() -> void;
+};
@@ -1168,3 +1168,1161 @@ func do_tests():
 		EPSILON
 	))
 
+
+	# ==========================================
+	# 18. BATCH ARRAY TESTS
+	# ==========================================
+	print("Testing batch array operations...")
+
+	var arr_a := DecimalArray.from_array([one, two, Decimal.from_parts(3, 100), negative_four])
+	var arr_b := DecimalArray.from_array([two, five, Decimal.from_parts(2, 50), one])
+	var arr_out := DecimalArray.create(0)
+
+	t.assert_equal(arr_a.size(), 4)
+	t.assert_true(Decimal.eq(arr_a.get_at(2), Decimal.from_parts(3, 100)))
+
+	DecimalArray.add(arr_a, arr_b, arr_out)
+	t.assert_equal(arr_out.size(), 4)
+	for i in arr_out.size():
+		t.assert_true(Decimal.eq(arr_out.get_at(i), Decimal.add(arr_a.get_at(i), arr_b.get_at(i))))
+
+	DecimalArray.mul(arr_a, arr_b, arr_out)
+	for i in arr_out.size():
+		t.assert_true(Decimal.eq(arr_out.get_at(i), Decimal.mul(arr_a.get_at(i), arr_b.get_at(i))))
+
+	DecimalArray.div(arr_a, arr_b, arr_out)
+	for i in arr_out.size():
+		t.assert_true(Decimal.eq(arr_out.get_at(i), Decimal.div(arr_a.get_at(i), arr_b.get_at(i))))
+
+	DecimalArray.pow_num(arr_b, 3, arr_out)
+	for i in arr_out.size():
+		t.assert_true(Decimal.eq(arr_out.get_at(i), Decimal.pow_num(arr_b.get_at(i), 3)))
+
+	# output aliasing one of the inputs
+	var arr_alias := DecimalArray.from_array([one, two, three])
+	DecimalArray.mul_num(arr_alias, 10, arr_alias)
+	t.assert_true(Decimal.eq(arr_alias.get_at(2), Decimal.from_float(30)))
+
+	var arr_grow := DecimalArray.create(2)
+	arr_grow.resize(3)
+	t.assert_true(Decimal.eq(arr_grow.get_at(2), zero))
+	arr_grow.append(five)
+	t.assert_equal(arr_grow.size(), 4)
+	t.assert_equal(arr_grow.get_data().size(), 64)
+
+	# The SIMD kernels against the scalar ops, bit for bit. The first 16
+	# elements are plain normalized values, so whole chunks go through the
+	# vector path. The rest mix in zeros, subnormals, infinities, NaN and
+	# exponents far apart, which send their chunks to the scalar fallback, and
+	# the length leaves a partial chunk at the end. (set_data() is used so the
+	# inputs don't get normalized on the way in.)
+	var odd_mantissas := [1.5, 0.0, -0.0, 5e-324, -2.5e-310, INF, -INF, NAN, -7.25, 9.999999999999998, 12345.678, 0.03, 3.0, -1.0, 2.0, 9.5, 1.25, -4.0]
+	var odd_exponents := [0, 3, -9223372036854775807 - 1, 9223372036854775807, 300, -300, 5, -5, 1000000000000000000, -1000000000000000000, 1, 0, 17, 2, -1]
+	var simd_count := 53
+	var simd_a_bytes := PackedByteArray()
+	var simd_b_bytes := PackedByteArray()
+	simd_a_bytes.resize(16 * simd_count)
+	simd_b_bytes.resize(16 * simd_count)
+	for i in simd_count:
+		if i < 16:
+			simd_a_bytes.encode_double(16 * i, 1.0 + i * 0.5)
+			simd_a_bytes.encode_s64(16 * i + 8, i * 3 - 20)
+			simd_b_bytes.encode_double(16 * i, -(9.5 - i * 0.5))
+			simd_b_bytes.encode_s64(16 * i + 8, 7 - i)
+		else:
+			simd_a_bytes.encode_double(16 * i, odd_mantissas[i % 18])
+			simd_a_bytes.encode_s64(16 * i + 8, odd_exponents[i % 15])
+			simd_b_bytes.encode_double(16 * i, odd_mantissas[(i * 7 + 3) % 18])
+			simd_b_bytes.encode_s64(16 * i + 8, odd_exponents[(i * 5 + 2) % 15])
+	var simd_a := DecimalArray.create(simd_count)
+	var simd_b := DecimalArray.create(simd_count)
+	simd_a.set_data(simd_a_bytes)
+	simd_b.set_data(simd_b_bytes)
+
+	var simd_bad := 0
+	DecimalArray.add(simd_a, simd_b, arr_out)
+	for i in simd_count:
+		if arr_out.get_at(i) != Decimal.add(simd_a.get_at(i), simd_b.get_at(i)):
+			simd_bad += 1
+	DecimalArray.sub(simd_a, simd_b, arr_out)
+	for i in simd_count:
+		if arr_out.get_at(i) != Decimal.sub(simd_a.get_at(i), simd_b.get_at(i)):
+			simd_bad += 1
+	DecimalArray.mul(simd_a, simd_b, arr_out)
+	for i in simd_count:
+		if arr_out.get_at(i) != Decimal.mul(simd_a.get_at(i), simd_b.get_at(i)):
+			simd_bad += 1
+	DecimalArray.mul_num(simd_a, 1.5, arr_out)
+	for i in simd_count:
+		if arr_out.get_at(i) != Decimal.mul_num(simd_a.get_at(i), 1.5):
+			simd_bad += 1
+	DecimalArray.normalize(simd_a, arr_out)
+	for i in simd_count:
+		if arr_out.get_at(i) != Decimal.normalize(simd_a.get_at(i)):
+			simd_bad += 1
+	t.assert_equal(arr_out.size(), simd_count)
+	t.assert_equal(simd_bad, 0)
+
+
+	# ==========================================
+	# 19. NORMALIZATION RANGE TESTS
+	# ==========================================
+	print("Testing normalization across the double range...")
+
+	# powers of 10 are exact up to 1e22, so these have to come out exact too
+	for j in range(-22, 23):
+		var p := Decimal.from_float(pow(10.0, j))
+		t.assert_equal(Decimal.get_mantissa(p), 1.0)
+		t.assert_equal(Decimal.get_exponent(p), j)
+
+	for j in range(-307, 309):
+		var x := 7.5 * pow(10.0, j - 1)
+		var d := Decimal.from_float(x)
+		t.assert_true(absf(Decimal.get_mantissa(d)) >= 1.0 and absf(Decimal.get_mantissa(d)) < 10.0)
+		t.assert_equal(Decimal.get_exponent(d), j - 1)
+		t.assert_true(absf(Decimal.into_float(d) / x - 1.0) < 1e-15)
+
+	# no rounding noise from scaling by an inexact 0.1
+	t.assert_equal(Decimal.get_mantissa(Decimal.from_float(30)), 3.0)
+	t.assert_equal(Decimal.get_mantissa(Decimal.from_float(0.3)), 3.0)
+	t.assert_equal(Decimal.get_mantissa(Decimal.mul(five, Decimal.from_float(6))), 3.0)
+
+	# subnormals
+	var tiny := Decimal.from_float(5e-324)
+	t.assert_equal(Decimal.get_exponent(tiny), -324)
+	t.assert_true(Decimal.get_mantissa(tiny) >= 4.9 and Decimal.get_mantissa(tiny) < 5.0)
+
+	t.assert_false(Decimal.is_finite(Decimal.from_float(INF)))
+	t.assert_equal(Decimal.get_mantissa(Decimal.from_float(-INF)), -INF)
+
+	# exponents this far apart overflow when subtracted
+	var huge := Decimal.from_parts(1, 9223372036854775807)
+	var minuscule := Decimal.from_parts(1, -9223372036854775807 - 1)
+	t.assert_true(Decimal.eq(Decimal.add(huge, minuscule), huge))
+	t.assert_true(Decimal.eq(Decimal.add(minuscule, huge), huge))
+
+	# same for the accumulator's reference exponent
+	var far_acc := DecimalAccumulator.new()
+	far_acc.add(Decimal.from_parts(1, -10))
+	far_acc.add(Decimal.from_parts(1, 9223372036854775807 - 5))
+	t.assert_true(Decimal.eq(far_acc.read(), Decimal.from_parts(1, 9223372036854775807 - 5)))
+	far_acc.add(minuscule)
+	t.assert_true(Decimal.eq(far_acc.read(), Decimal.from_parts(1, 9223372036854775807 - 5)))
+	far_acc.reset(minuscule)
+	far_acc.add(huge)
+	t.assert_true(Decimal.eq(far_acc.read(), huge))
+
+
+	# ==========================================
+	# 20. STRING FORMATTING TESTS
+	# ==========================================
+	print("Testing string formatting...")
+
+	t.assert_equal(Decimal.to_string(Decimal.from_float(123.45)), "123.45")
+	t.assert_equal(Decimal.to_string(Decimal.from_float(0.1)), "0.1")
+	t.assert_equal(Decimal.to_string(Decimal.from_float(0.001)), "0.001")
+	t.assert_equal(Decimal.to_string(Decimal.from_float(1e9)), "1000000000.0")
+	t.assert_equal(Decimal.to_string(Decimal.from_float(1e10)), "1e+10")
+	t.assert_equal(Decimal.to_string(Decimal.pow10_num(1337)), "1e+1337")
+	t.assert_equal(Decimal.to_string(Decimal.from_float(INF)), "inf")
+	t.assert_equal(Decimal.to_string(Decimal.from_float(-INF)), "-inf")
+
+	var third := Decimal.div(one, Decimal.from_float(3))
+	t.assert_equal(Decimal.to_exponential(third), "3.333333333333333e-1")
+	t.assert_equal(Decimal.to_exponential(Decimal.from_float(123456789), 2), "1.23e+8")
+	t.assert_equal(Decimal.to_exponential(Decimal.from_float(999900), 2), "1.00e+6")
+	t.assert_equal(Decimal.to_exponential(Decimal.from_float(-2.5), 3), "-2.500e+0")
+	t.assert_equal(Decimal.to_exponential(zero, 3), "0.000e+0")
+	t.assert_equal(Decimal.to_exponential(Decimal.from_parts(1, -9223372036854775807 - 1)), "1e-9223372036854775808")
+
+	# shortest output still reads back as the exact same mantissa
+	for j in range(1, 2000):
+		var m := Decimal.get_mantissa(Decimal.from_float(j * 1.1))
+		var text := Decimal.to_exponential(Decimal.from_parts(m, 0))
+		t.assert_equal(text.to_float(), m)
+
+
+	# ==========================================
+	# 21. STRING PARSING TESTS
+	# ==========================================
+	print("Testing string parsing...")
+
+	var parsed := Decimal.from_string("1.2345e+1000000")
+	t.assert_equal(Decimal.get_mantissa(parsed), 1.2345)
+	t.assert_equal(Decimal.get_exponent(parsed), 1000000)
+
+	t.assert_true(Decimal.eq(Decimal.from_string("123.45"), Decimal.from_float(123.45)))
+	t.assert_true(Decimal.eq(Decimal.from_string("-0.001"), Decimal.from_float(-0.001)))
+	t.assert_true(Decimal.eq(Decimal.from_string("+.5e1"), five))
+	t.assert_true(Decimal.eq(Decimal.from_string("0"), zero))
+	t.assert_true(Decimal.eq(Decimal.from_string("3.e+200"), Decimal.from_parts(3, 200)))
+	t.assert_true(Decimal.eq(Decimal.from_string("12345e-4"), Decimal.from_float(1.2345)))
+	t.assert_equal(Decimal.get_exponent(Decimal.from_string("1e-9223372036854775808")), -9223372036854775807 - 1)
+
+	# more digits than a double holds still round correctly
+	t.assert_equal(Decimal.get_mantissa(Decimal.from_string("9.99999999999999999999")), 1.0)
+	t.assert_equal(Decimal.get_exponent(Decimal.from_string("9.99999999999999999999")), 1)
+
+	t.assert_equal(Decimal.get_mantissa(Decimal.from_string("inf")), INF)
+	t.assert_equal(Decimal.get_mantissa(Decimal.from_string("-Infinity")), -INF)
+	t.assert_true(is_nan(Decimal.get_mantissa(Decimal.from_string("nan"))))
+
+	t.assert_true(Decimal.is_valid_string("1e5"))
+	t.assert_false(Decimal.is_valid_string(""))
+	t.assert_false(Decimal.is_valid_string("1e"))
+	t.assert_false(Decimal.is_valid_string("1.2.3"))
+	t.assert_false(Decimal.is_valid_string(" 1"))
+	t.assert_false(Decimal.is_valid_string("1e9223372036854775808"))
+
+	# whatever gets printed reads back as the same value
+	for j in range(1, 2000):
+		var value := Decimal.from_parts_normalize(j * 1.1, j * 1000003 - 1000000000)
+		t.assert_true(Decimal.eq(Decimal.from_string(Decimal.to_string(value)), value))
+
+	var from_strings := DecimalArray.from_strings(PackedStringArray(["1", "2.5e10", "-3e-5"]))
+	t.assert_equal(from_strings.size(), 3)
+	t.assert_true(Decimal.eq(from_strings.get_at(1), Decimal.from_parts(2.5, 10)))
+
+	var from_utf8 := DecimalArray.from_utf8("1.5e10, 2\n-3e-5\t\t,,inf".to_utf8_buffer())
+	t.assert_equal(from_utf8.size(), 4)
+	t.assert_true(Decimal.eq(from_utf8.get_at(0), Decimal.from_parts(1.5, 10)))
+	t.assert_true(Decimal.eq(from_utf8.get_at(1), two))
+	t.assert_true(Decimal.eq(from_utf8.get_at(2), Decimal.from_parts(-3, -5)))
+	t.assert_false(Decimal.is_finite(from_utf8.get_at(3)))
+
+
+	# ==========================================
+	# 22. BINARY PACKING TESTS
+	# ==========================================
+	print("Testing binary packing...")
+
+	var to_pack := DecimalArray.from_array([
+		zero, one, negative_one, Decimal.from_parts(1.2345, 1000000),
+		Decimal.from_parts(9.99, -9223372036854775807 - 1), Decimal.from_float(INF),
+	])
+
+	var packed_raw := Decimal.pack(to_pack)
+	t.assert_equal(packed_raw.size(), 16 + 16 * to_pack.size())
+	t.assert_equal(packed_raw.slice(0, 4).get_string_from_ascii(), "DECM")
+	t.assert_equal(packed_raw[4], 1)
+	t.assert_equal(packed_raw[5], 0)
+	t.assert_equal(packed_raw.decode_u64(8), to_pack.size())
+	t.assert_equal(Decimal.unpack(packed_raw).get_data(), to_pack.get_data())
+
+	var packed_compact := Decimal.pack(to_pack, true)
+	t.assert_equal(packed_compact[5], 1)
+	t.assert_equal(Decimal.unpack(packed_compact).get_data(), to_pack.get_data())
+
+	# sorted data packs down a lot
+	var sorted := DecimalArray.create(1000)
+	for j in range(1000):
+		sorted.set_at(j, Decimal.from_float(j * 25))
+	var packed_sorted := Decimal.pack(sorted, true)
+	t.assert_true(packed_sorted.size() < Decimal.pack(sorted).size() / 2)
+	t.assert_equal(Decimal.unpack(packed_sorted).get_data(), sorted.get_data())
+
+	t.assert_equal(Decimal.unpack(Decimal.pack(DecimalArray.create(0))).size(), 0)
+	t.assert_equal(Decimal.unpack(packed_raw.slice(0, 20)), null)
+
+
+	# ==========================================
+	# 23. DISPLAY FORMATTER TESTS
+	# ==========================================
+	print("Testing the display formatter...")
+
+	var formatter := DecimalFormatter.new()
+	t.assert_equal(formatter.notation, DecimalFormatter.NOTATION_SUFFIX)
+	t.assert_equal(formatter.format(zero), "0.00")
+	t.assert_equal(formatter.format(Decimal.from_float(12.345)), "12.35")
+	t.assert_equal(formatter.format(Decimal.from_float(999.994)), "999.99")
+	t.assert_equal(formatter.format(Decimal.from_float(999.996)), "1.00K")
+	t.assert_equal(formatter.format(Decimal.from_float(-1234567)), "-1.23M")
+	t.assert_equal(formatter.format(Decimal.from_float(1.5e16)), "15.00aa")
+	t.assert_equal(formatter.format(Decimal.from_parts(9.999, 2039)), "999.90zy")
+	t.assert_equal(formatter.format(Decimal.from_parts(1, 3000)), "1.00e+3000")
+	t.assert_equal(formatter.format(Decimal.from_float(0.05)), "0.05")
+	t.assert_equal(formatter.format(Decimal.from_float(0.004)), "4.00e-3")
+	t.assert_equal(formatter.format(Decimal.from_float(0.0096)), "0.01")
+	t.assert_equal(formatter.format(Decimal.from_float(0.0094)), "9.40e-3")
+	t.assert_equal(formatter.format(Decimal.from_float(INF)), "inf")
+
+	formatter.notation = DecimalFormatter.NOTATION_SCIENTIFIC
+	t.assert_equal(formatter.format(Decimal.from_float(1234.5)), "1.23e+3")
+
+	formatter.notation = DecimalFormatter.NOTATION_ENGINEERING
+	t.assert_equal(formatter.format(Decimal.from_float(1.5e16)), "15.00e+15")
+	t.assert_equal(formatter.format(Decimal.from_parts(3.7, -1000)), "370.00e-1002")
+
+	formatter.notation = DecimalFormatter.NOTATION_LOGARITHMIC
+	t.assert_equal(formatter.format(Decimal.from_float(1e15)), "e15.00")
+	t.assert_equal(formatter.format(Decimal.from_float(-1234567)), "-e6.09")
+	t.assert_equal(formatter.format(Decimal.from_float(0.004)), "e-2.40")
+
+	formatter.places = 0
+	formatter.notation = DecimalFormatter.NOTATION_SUFFIX
+	t.assert_equal(formatter.format(Decimal.from_float(1234.5)), "1K")
+	t.assert_equal(formatter.format(Decimal.from_float(0.96)), "1")
+	formatter.places = 100
+	t.assert_equal(formatter.places, 17)
+
+	# the same value again is a cache hit, other settings are not
+	formatter.places = 2
+	formatter.clear_cache()
+	var cached_value := Decimal.from_parts(4.2, 100)
+	var first_text := formatter.format(cached_value)
+	t.assert_equal(formatter.format(cached_value), first_text)
+	t.assert_equal(formatter.get_cache_hits(), 1)
+	t.assert_equal(formatter.get_cache_misses(), 1)
+	formatter.places = 3
+	t.assert_true(formatter.format(cached_value) != first_text)
+	t.assert_equal(formatter.get_cache_misses(), 2)
+
+	var formatted := formatter.format_array(DecimalArray.from_array([one, Decimal.from_float(2500), cached_value]))
+	t.assert_equal(formatted.size(), 3)
+	t.assert_equal(formatted[0], "1.000")
+	t.assert_equal(formatted[1], "2.500K")
+
+
+	# ==========================================
+	# 24. RESOURCE LEDGER TESTS
+	# ==========================================
+	print("Testing the resource ledger...")
+
+	var ledger := DecimalLedger.new()
+	var gold_idx := ledger.add_entry(&"gold", Decimal.from_float(100), Decimal.from_float(10))
+	var gems_idx := ledger.add_entry(&"gems", zero, Decimal.from_parts(1, 300))
+	var mana_idx := ledger.add_entry(&"mana")
+	t.assert_equal(ledger.size(), 3)
+	t.assert_equal(ledger.find(&"gems"), gems_idx)
+	t.assert_equal(ledger.find(&"nothing"), -1)
+	t.assert_true(ledger.has(&"mana"))
+	t.assert_equal(ledger.get_entry_name(gold_idx), &"gold")
+
+	ledger.advance(0.5)
+	t.assert_true(Decimal.eq(ledger.get_amount(gold_idx), Decimal.from_float(105)))
+	t.assert_true(Decimal.eq(ledger.get_amount_named(&"gems"), Decimal.from_parts(5, 299)))
+	t.assert_true(Decimal.eq(ledger.get_amount(mana_idx), zero))
+
+	# same result as doing it one resource at a time
+	var by_hand := Decimal.add(ledger.get_amount(gold_idx), Decimal.mul_num(ledger.get_rate(gold_idx), 0.25))
+	ledger.advance(0.25)
+	t.assert_true(Decimal.eq(ledger.get_amount(gold_idx), by_hand))
+
+	# caps are applied after every advance
+	ledger.set_rate_named(&"mana", Decimal.from_float(50))
+	ledger.set_max(mana_idx, Decimal.from_float(120))
+	ledger.advance(2)
+	t.assert_true(Decimal.eq(ledger.get_amount(mana_idx), Decimal.from_float(100)))
+	ledger.advance(2)
+	t.assert_true(Decimal.eq(ledger.get_amount(mana_idx), Decimal.from_float(120)))
+
+	ledger.set_rate(mana_idx, Decimal.from_float(-1000))
+	ledger.set_min(mana_idx, zero)
+	ledger.advance(1)
+	t.assert_true(Decimal.eq(ledger.get_amount(mana_idx), zero))
+	ledger.clear_min(mana_idx)
+	ledger.advance(1)
+	t.assert_true(Decimal.eq(ledger.get_amount(mana_idx), Decimal.from_float(-1000)))
+
+	# whole-array copies
+	var ledger_rates := DecimalArray.create(0)
+	ledger.get_rates(ledger_rates)
+	t.assert_equal(ledger_rates.size(), 3)
+	DecimalArray.mul_num(ledger_rates, 2, ledger_rates)
+	ledger.set_rates(ledger_rates)
+	t.assert_true(Decimal.eq(ledger.get_rate(gold_idx), Decimal.from_float(20)))
+
+	var ledger_amounts := DecimalArray.create(0)
+	ledger.get_amounts(ledger_amounts)
+	t.assert_true(Decimal.eq(ledger_amounts.get_at(gems_idx), ledger.get_amount(gems_idx)))
+
+	# enough entries to cross advance()'s block size
+	var big_ledger := DecimalLedger.new()
+	for i in 1000:
+		big_ledger.add_entry(StringName("r%d" % i), Decimal.from_float(i), Decimal.from_float(i * 2))
+	big_ledger.advance(1.5)
+	t.assert_true(Decimal.eq(big_ledger.get_amount(999), Decimal.from_float(999 * 4)))
+	t.assert_true(Decimal.eq(big_ledger.get_amount_named(&"r300"), Decimal.from_float(1200)))
+	big_ledger.clear()
+	t.assert_equal(big_ledger.size(), 0)
+
+
+	# ==========================================
+	# 25. OFFLINE PROGRESS TESTS
+	# ==========================================
+	print("Testing offline progress...")
+
+	var offline := DecimalOfflineProgress.new()
+	var off_gold := offline.add_resource(&"gold", Decimal.from_float(100))
+	var off_miners := offline.add_resource(&"miners", five)
+	var off_wave := offline.add_resource(&"wave")
+	var off_boom := offline.add_resource(&"boom")
+	t.assert_equal(offline.size(), 4)
+	t.assert_equal(offline.find(&"miners"), off_miners)
+
+	offline.set_constant_rate(off_miners, one)
+	offline.add_producer(off_gold, off_miners, two)
+	offline.set_polynomial_rate(off_wave, DecimalArray.from_array([zero, two]))
+	offline.set_exponential_rate(off_boom, one, 2.0)
+
+	var offline_out := DecimalArray.create(0)
+	offline.simulate(10, offline_out)
+	t.assert_equal(offline_out.size(), 4)
+	# miners = 5 + t, so gold = 100 + 10t + t^2
+	t.assert_true(Decimal.eq_tolerance_rel(offline_out.get_at(off_miners), Decimal.from_float(15), Decimal.from_parts(1, -12)))
+	t.assert_true(Decimal.eq_tolerance_rel(offline_out.get_at(off_gold), Decimal.from_float(300), Decimal.from_parts(1, -12)))
+	t.assert_true(Decimal.eq_tolerance_rel(offline_out.get_at(off_wave), Decimal.from_float(100), Decimal.from_parts(1, -12)))
+	t.assert_true(Decimal.eq_tolerance_rel(offline_out.get_at(off_boom), Decimal.from_float((pow(2, 10) - 1) / log(2)), Decimal.from_parts(1, -12)))
+
+	# simulating doesn't change the starting amounts
+	t.assert_true(Decimal.eq(offline.get_amount(off_gold), Decimal.from_float(100)))
+	offline.simulate(0, offline_out)
+	t.assert_true(Decimal.eq(offline_out.get_at(off_gold), Decimal.from_float(100)))
+
+	# 30 days of doubling every second doesn't fit in a double, but fits here
+	offline.simulate(2592000, offline_out)
+	t.assert_true(Decimal.is_finite(offline_out.get_at(off_boom)))
+	t.assert_true(Decimal.gt(offline_out.get_at(off_boom), Decimal.from_parts(1, 780000)))
+
+	# gold already (indirectly) depends on miners
+	offline.add_producer(off_miners, off_gold, one)
+	offline.simulate(10, offline_out)
+	t.assert_true(Decimal.eq_tolerance_rel(offline_out.get_at(off_miners), Decimal.from_float(15), Decimal.from_parts(1, -12)))
+
+	# a 10 tier chain, tier k has T^k / k! * 1e-3^(k - 1) after T seconds, the
+	# deep tiers' coefficients are far below 1 and mustn't be rounded away
+	var chain := DecimalOfflineProgress.new()
+	var chain_per_unit := Decimal.from_parts(1, -3)
+	for i in 10:
+		chain.add_resource(StringName("tier%d" % i))
+		if i > 0:
+			chain.add_producer(i, i - 1, chain_per_unit)
+	chain.set_constant_rate(0, one)
+	chain.simulate(2592000, offline_out)
+	var chain_expected := Decimal.from_float(1000)
+	for i in 10:
+		chain_expected = Decimal.mul_num(Decimal.mul(chain_expected, chain_per_unit), 2592000.0 / (i + 1))
+		t.assert_true(Decimal.eq_tolerance_rel(offline_out.get_at(i), chain_expected, Decimal.from_parts(1, -12)))
+
+
+	# ==========================================
+	# 26. PURCHASE PLANNER TESTS
+	# ==========================================
+	print("Testing the purchase planner...")
+
+	var planner := DecimalPurchasePlanner.new()
+	var cheap := planner.add_geometric(Decimal.from_float(10), two, one)
+	var pricey := planner.add_arithmetic(Decimal.from_float(100), Decimal.from_float(50), Decimal.from_float(20))
+	t.assert_equal(planner.size(), 2)
+
+	# scores go 20 vs 105, then 30 vs 55, then 53.3 vs 38.3 (too expensive, so
+	# it's dropped), and the 4th cheap one doesn't fit anymore
+	var bought := planner.plan(Decimal.from_float(100), one)
+	t.assert_equal(bought, PackedInt64Array([cheap, cheap, cheap]))
+	t.assert_true(Decimal.eq(planner.get_planned_cost(), Decimal.from_float(70)))
+	t.assert_true(Decimal.eq(planner.get_planned_rps(), Decimal.from_float(4)))
+
+	# planning doesn't buy anything by itself
+	t.assert_equal(planner.get_owned(cheap), 0)
+	t.assert_true(Decimal.eq(planner.get_cost(cheap), Decimal.from_float(10)))
+
+	planner.set_owned(cheap, 3)
+	t.assert_true(Decimal.eq(planner.get_cost(cheap), Decimal.from_float(80)))
+	t.assert_equal(planner.plan(Decimal.from_float(100), Decimal.from_float(4)), PackedInt64Array([pricey]))
+	t.assert_equal(planner.plan(Decimal.from_float(1000), Decimal.from_float(4), 2).size(), 2)
+
+	# upgrades that add nothing are never picked
+	planner.set_delta_rps(pricey, zero)
+	t.assert_equal(planner.plan(Decimal.from_float(100), Decimal.from_float(4)), PackedInt64Array([cheap]))
+
+
+	# ==========================================
+	# 27. COST CURVE SET TESTS
+	# ==========================================
+	print("Testing cost curve sets...")
+
+	var curves := CostCurveSet.new()
+	var curve_ratio := Decimal.from_float(1.15)
+	var curve_add := Decimal.from_float(5)
+	curves.add_geometric(Decimal.from_float(10), curve_ratio)
+	curves.add_arithmetic(Decimal.from_float(10), curve_add)
+	curves.add_geometric(Decimal.from_parts(1, 10), two)
+	t.assert_equal(curves.size(), 3)
+
+	var curve_owned := PackedInt64Array([0, 12, 40])
+	var curve_budget := Decimal.from_parts(2.5, 15)
+	var affordable := curves.max_affordable(curve_budget, curve_owned)
+	t.assert_equal(affordable.size(), 3)
+	# same answers as the one-at-a-time helpers
+	t.assert_equal(affordable[0], Decimal.afford_geometric_series(curve_budget, Decimal.from_float(10), curve_ratio, 0))
+	t.assert_equal(affordable[1], int(Decimal.into_float(Decimal.afford_arithmetic_series(curve_budget, Decimal.from_float(10), curve_add, Decimal.from_float(12)))))
+	t.assert_equal(affordable[2], Decimal.afford_geometric_series(curve_budget, Decimal.from_parts(1, 10), two, 40))
+
+	var curve_costs := DecimalArray.create(0)
+	curves.cost_of(PackedInt64Array([1, 3, 2]), curve_owned, curve_costs)
+	t.assert_equal(curve_costs.size(), 3)
+	t.assert_true(Decimal.eq(curve_costs.get_at(0), Decimal.sum_geometric_series(1, Decimal.from_float(10), curve_ratio, 0)))
+	t.assert_true(Decimal.eq(curve_costs.get_at(1), Decimal.sum_arithmetic_series(three, Decimal.from_float(10), curve_add, Decimal.from_float(12))))
+	t.assert_true(Decimal.eq(curve_costs.get_at(2), Decimal.sum_geometric_series(2, Decimal.from_parts(1, 10), two, 40)))
+
+	# what "buy max" would cost, which has to fit in the budget
+	curves.cost_of(affordable, curve_owned, curve_costs)
+	for i in curve_costs.size():
+		t.assert_true(Decimal.le(curve_costs.get_at(i), curve_budget))
+
+	# mismatched sizes are rejected
+	t.assert_equal(curves.max_affordable(curve_budget, PackedInt64Array([0])).size(), 0)
+
+
+	# ==========================================
+	# 28. POW / EXP TESTS
+	# ==========================================
+	print("Testing pow and exp...")
+
+	# small integer powers are exact
+	t.assert_true(Decimal.eq(Decimal.pow(two, ten), Decimal.from_float(1024)))
+	t.assert_true(Decimal.eq(Decimal.pow(Decimal.from_float(-2), three), Decimal.from_float(-8)))
+	t.assert_true(Decimal.eq_tolerance_rel(Decimal.pow(three, Decimal.from_float(-2)), Decimal.div(one, Decimal.from_float(9)), Decimal.from_parts(1, -15)))
+	t.assert_true(Decimal.eq(Decimal.pow_base(2, ten), Decimal.from_float(1024)))
+	t.assert_true(Decimal.eq(Decimal.pow(Decimal.from_float(123.456), zero), one))
+	t.assert_true(Decimal.eq(Decimal.pow(zero, three), zero))
+
+	# same as pow_num for exponents that fit in a float
+	var pow_epsilon := Decimal.from_parts(1, -12)
+	t.assert_true(Decimal.eq_tolerance_rel(Decimal.pow(Decimal.from_float(1.5), Decimal.from_float(12.34)), Decimal.pow_num(Decimal.from_float(1.5), 12.34), pow_epsilon))
+	t.assert_true(Decimal.eq_tolerance_rel(Decimal.pow(Decimal.from_parts(4, 100), Decimal.from_float(0.5)), Decimal.from_parts(2, 50), pow_epsilon))
+
+	# powers of ten keep the exponent exact
+	var pow_huge := Decimal.pow(ten, Decimal.from_parts(1, 18))
+	t.assert_equal(Decimal.get_exponent(pow_huge), 1000000000000000000)
+	t.assert_equal(Decimal.get_mantissa(pow_huge), 1.0)
+
+	# exponents that don't fit in a float
+	var pow_giant := Decimal.pow(Decimal.from_float(1.01), Decimal.from_parts(1, 15))
+	t.assert_true(Decimal.is_finite(pow_giant))
+	t.assert_true(abs(Decimal.log10(pow_giant) - 1e15 * log(1.01) / log(10)) < 1.0)
+
+	# past the exponent limits, results saturate instead of wrapping around
+	t.assert_false(Decimal.is_finite(Decimal.pow(ten, Decimal.from_parts(1, 19))))
+	t.assert_true(Decimal.eq(Decimal.pow(ten, Decimal.from_parts(-1, 19)), zero))
+	t.assert_false(Decimal.is_finite(Decimal.pow(two, Decimal.from_parts(1, 100))))
+	t.assert_true(Decimal.eq(Decimal.pow(Decimal.from_float(0.5), Decimal.from_parts(1, 100)), zero))
+	# but only past them, x^1 is x even right next to them
+	var pow_top := Decimal.from_parts(2, 9223372036854775807)
+	var pow_bottom := Decimal.from_parts(5, -9223372036854775807 - 1)
+	t.assert_true(Decimal.eq(Decimal.pow(pow_top, one), pow_top))
+	t.assert_true(Decimal.eq(Decimal.pow(pow_bottom, one), pow_bottom))
+	t.assert_true(Decimal.eq(Decimal.pow(Decimal.from_parts(1, 9223372036854775807), one), Decimal.from_parts(1, 9223372036854775807)))
+
+	# negative bases need integer exponents
+	t.assert_true(is_nan(Decimal.get_mantissa(Decimal.pow(Decimal.from_float(-2), Decimal.from_float(0.5)))))
+
+	t.assert_true(Decimal.eq_tolerance_rel(Decimal.exp(one), Decimal.from_float(exp(1.0)), pow_epsilon))
+	t.assert_true(Decimal.eq_tolerance_rel(Decimal.exp(Decimal.from_float(-3)), Decimal.from_float(exp(-3.0)), pow_epsilon))
+	t.assert_equal(Decimal.get_exponent(Decimal.exp(Decimal.from_float(1000))), 434)
+	t.assert_false(Decimal.is_finite(Decimal.exp(Decimal.from_parts(1, 20))))
+
+
+	# ==========================================
+	# 29. EXPRESSION TESTS
+	# ==========================================
+	print("Testing compiled expressions...")
+
+	var expr := DecimalExpression.new()
+	t.assert_false(expr.is_compiled())
+	t.assert_equal(expr.compile("1 + 2 * 3"), OK)
+	t.assert_true(expr.is_compiled())
+	t.assert_true(Decimal.eq(expr.evaluate(), Decimal.from_float(7)))
+
+	# precedence and associativity
+	expr.compile("-2^2 + 2^3^2 + 2^-1")
+	t.assert_true(Decimal.eq(expr.evaluate(), Decimal.from_float(-4 + 512 + 0.5)))
+
+	t.assert_equal(expr.compile("base * 1.15^owned * (1 + prestige)^0.5", ["base", "owned", "prestige"]), OK)
+	var expr_base := Decimal.from_float(10)
+	var expr_want := Decimal.mul(Decimal.mul(expr_base, Decimal.pow(Decimal.from_float(1.15), Decimal.from_float(20))), Decimal.pow_num(Decimal.from_float(4), 0.5))
+	t.assert_true(Decimal.eq_tolerance_rel(expr.evaluate([expr_base, 20, 3.0]), expr_want, Decimal.from_parts(1, -14)))
+
+	# functions, and numbers past the float range
+	expr.compile("max(x, 1e500) / min(2, 3) + log10(1e1000) + floor(2.5) + abs(-1)", ["x"])
+	t.assert_true(Decimal.eq_tolerance_rel(expr.evaluate([one]), Decimal.from_parts(5, 499), Decimal.from_parts(1, -14)))
+
+	# batches give the same results as evaluating row by row
+	expr.compile("a * b + c", ["a", "b", "c"])
+	var expr_a := DecimalArray.from_array([one, two, Decimal.from_parts(1, 100)])
+	var expr_b := DecimalArray.from_array([three, ten, Decimal.from_parts(1, 100)])
+	var expr_c := DecimalArray.from_array([one, zero, one])
+	var expr_out := DecimalArray.create(0)
+	expr.evaluate_batch([expr_a, expr_b, expr_c], expr_out)
+	t.assert_equal(expr_out.size(), 3)
+	for i in expr_out.size():
+		t.assert_equal(expr_out.get_at(i), expr.evaluate([expr_a.get_at(i), expr_b.get_at(i), expr_c.get_at(i)]))
+	t.assert_true(Decimal.eq(expr_out.get_at(0), Decimal.from_float(4)))
+	t.assert_true(Decimal.eq(expr_out.get_at(1), Decimal.from_float(20)))
+
+	# long chains are only limited by memory, not by how deep they nest
+	var expr_chain := "x" + "+x".repeat(99999)
+	t.assert_equal(expr.compile(expr_chain, ["x"]), OK)
+	t.assert_true(Decimal.eq(expr.evaluate([one]), Decimal.from_float(100000)))
+
+	# errors
+	t.assert_equal(expr.compile("1 +"), ERR_PARSE_ERROR)
+	t.assert_false(expr.is_compiled())
+	t.assert_true(expr.get_error_text().length() > 0)
+	t.assert_equal(expr.compile("foo(1)"), ERR_PARSE_ERROR)
+	t.assert_equal(expr.compile("x * 2"), ERR_PARSE_ERROR)
+	t.assert_equal(expr.compile("min(1)"), ERR_PARSE_ERROR)
+	t.assert_equal(expr.compile("(1"), ERR_PARSE_ERROR)
+	t.assert_equal(expr.compile("x * 2", ["x"]), OK)
+	t.assert_equal(expr.get_error_text(), "")
+
+
+	# ==========================================
+	# 30. ACCUMULATOR TESTS
+	# ==========================================
+	print("Testing the accumulator...")
+
+	var acc := DecimalAccumulator.new()
+	t.assert_true(Decimal.eq(acc.read(), zero))
+	acc.add(two)
+	acc.add(three)
+	acc.sub(one)
+	t.assert_true(Decimal.eq(acc.read(), Decimal.from_float(4)))
+
+	# small addends that Decimal.add() would drop still add up
+	var acc_big := Decimal.from_parts(1, 20)
+	acc.reset(acc_big)
+	var acc_plain := acc_big
+	for i in 100000:
+		acc.add(one)
+		acc_plain = Decimal.add(acc_plain, one)
+	t.assert_true(Decimal.eq(acc_plain, acc_big))
+	t.assert_true(Decimal.eq_tolerance_rel(acc.read(), Decimal.from_parts(1.000000000000001, 20), Decimal.from_parts(1, -15)))
+	t.assert_true(Decimal.gt(acc.read(), acc_big))
+
+	# add_many matches adding one by one
+	var acc_values := DecimalArray.from_array([Decimal.from_float(0.1), Decimal.from_parts(1, 300), Decimal.from_float(0.2), Decimal.from_parts(-1, 300)])
+	acc.reset()
+	acc.add_many(acc_values)
+	t.assert_true(Decimal.eq_tolerance_rel(acc.read(), Decimal.from_float(0.3), Decimal.from_parts(1, -15)))
+
+	# infinities and NaN still come through
+	acc.add(Decimal.from_float(INF))
+	t.assert_false(Decimal.is_finite(acc.read()))
+	acc.add(Decimal.from_float(-INF))
+	t.assert_true(is_nan(Decimal.get_mantissa(acc.read())))
+	acc.reset()
+	t.assert_true(Decimal.eq(acc.read(), zero))
+
+
+	# ==========================================
+	# 31. THREADED BATCH TESTS
+	# ==========================================
+	print("Testing threaded batch operations...")
+
+	var default_threshold := DecimalArray.get_parallel_threshold()
+	t.assert_equal(default_threshold, 65536)
+
+	var par_size := 20000
+	var par_a := DecimalArray.create(par_size)
+	var par_b := DecimalArray.create(par_size)
+	for i in par_size:
+		par_a.set_at(i, Decimal.from_parts(1.0 + (i % 9), i % 300 - 150))
+		par_b.set_at(i, Decimal.from_parts(9.0 - (i % 7), (i * 7) % 300 - 150))
+
+	var par_expr := DecimalExpression.new()
+	par_expr.compile("a * b + a^1.5", ["a", "b"])
+
+	# single-threaded reference
+	DecimalArray.set_parallel_threshold(0)
+	var serial_add := DecimalArray.create(0)
+	var serial_pow := DecimalArray.create(0)
+	var serial_expr := DecimalArray.create(0)
+	DecimalArray.add(par_a, par_b, serial_add)
+	DecimalArray.pow_num(par_a, 1.5, serial_pow)
+	par_expr.evaluate_batch([par_a, par_b], serial_expr)
+
+	# split into chunks on the worker pool, which has to give the exact same bytes
+	DecimalArray.set_parallel_threshold(1000)
+	var threaded_add := DecimalArray.create(0)
+	var threaded_pow := DecimalArray.create(0)
+	var threaded_expr := DecimalArray.create(0)
+	DecimalArray.add(par_a, par_b, threaded_add)
+	DecimalArray.pow_num(par_a, 1.5, threaded_pow)
+	par_expr.evaluate_batch([par_a, par_b], threaded_expr)
+	t.assert_equal(threaded_add.get_data(), serial_add.get_data())
+	t.assert_equal(threaded_pow.get_data(), serial_pow.get_data())
+	t.assert_equal(threaded_expr.get_data(), serial_expr.get_data())
+
+	# in place works too
+	var par_copy := DecimalArray.create(0)
+	par_copy.set_data(par_a.get_data())
+	DecimalArray.add(par_copy, par_b, par_copy)
+	t.assert_equal(par_copy.get_data(), serial_add.get_data())
+
+	DecimalArray.set_parallel_threshold(default_threshold)
+
+
+	# ==========================================
+	# 32. SORT TESTS
+	# ==========================================
+	print("Testing sorting...")
+
+	# sort keys compare byte by byte like the values do
+	var key_order := [
+		Decimal.from_float(-INF),
+		Decimal.from_string("-1e1000"),
+		Decimal.from_float(-5.0),
+		Decimal.from_float(-0.001),
+		zero,
+		Decimal.from_string("1e-1000"),
+		Decimal.from_float(2.5),
+		Decimal.from_float(3.0),
+		Decimal.from_string("1e1000"),
+		Decimal.from_float(INF),
+		Decimal.from_float(NAN),
+	]
+	for i in key_order.size() - 1:
+		var k1 := Decimal.sort_key(key_order[i])
+		var k2 := Decimal.sort_key(key_order[i + 1])
+		t.assert_equal(k1.size(), 16)
+		t.assert_true(k1.hex_encode() < k2.hex_encode())
+	t.assert_equal(Decimal.sort_key(Decimal.from_float(-0.0)), Decimal.sort_key(zero))
+	t.assert_equal(Decimal.sort_key(Decimal.from_parts(25.0, 0)), Decimal.sort_key(Decimal.from_float(25.0)))
+
+	var scores := DecimalArray.from_array([
+		Decimal.from_float(30.0),
+		Decimal.from_string("1e500"),
+		Decimal.from_float(-2.0),
+		Decimal.from_float(30.0),
+		Decimal.from_float(0.5),
+		Decimal.from_string("-1e300"),
+	])
+	t.assert_equal(DecimalArray.argsort(scores), PackedInt64Array([5, 2, 4, 0, 3, 1]))
+	t.assert_equal(DecimalArray.top_k(scores, 3), PackedInt64Array([1, 0, 3]))
+	t.assert_equal(DecimalArray.top_k(scores, 100).size(), 6)
+	t.assert_equal(DecimalArray.top_k(scores, 0).size(), 0)
+
+	var sorted_scores := DecimalArray.create(0)
+	DecimalArray.sort(scores, sorted_scores)
+	t.assert_true(Decimal.eq(sorted_scores.get_at(0), Decimal.from_string("-1e300")))
+	t.assert_true(Decimal.eq(sorted_scores.get_at(5), Decimal.from_string("1e500")))
+
+	t.assert_equal(DecimalArray.binary_search(sorted_scores, Decimal.from_float(30.0)), 3)
+	t.assert_equal(DecimalArray.binary_search(sorted_scores, Decimal.from_float(30.0), false), 5)
+	t.assert_equal(DecimalArray.binary_search(sorted_scores, Decimal.from_float(1.0)), 3)
+	t.assert_equal(DecimalArray.binary_search(sorted_scores, Decimal.from_float(-INF)), 0)
+	t.assert_equal(DecimalArray.binary_search(sorted_scores, Decimal.from_string("1e1000")), 6)
+
+	# large enough for the radix passes, has to match a comparison sort
+	var many := DecimalArray.create(2000)
+	for i in many.size():
+		many.set_at(i, Decimal.from_parts(1.0 + ((i * 37) % 900) / 100.0, (i * 13) % 41 - 20))
+	var many_sorted := DecimalArray.create(0)
+	DecimalArray.sort(many, many_sorted)
+	var sorted_ok := true
+	for i in many_sorted.size() - 1:
+		if Decimal.gt(many_sorted.get_at(i), many_sorted.get_at(i + 1)):
+			sorted_ok = false
+	t.assert_true(sorted_ok)
+	var many_order := DecimalArray.argsort(many)
+	t.assert_true(Decimal.eq(many.get_at(many_order[0]), many_sorted.get_at(0)))
+	t.assert_true(Decimal.eq(many.get_at(many_order[1999]), many_sorted.get_at(1999)))
+	DecimalArray.sort(many, many)
+	t.assert_equal(many.get_data(), many_sorted.get_data())
+
+
+	# ==========================================
+	# 33. MASK TESTS
+	# ==========================================
+	print("Testing comparison masks...")
+
+	var mask_values := DecimalArray.create(0)
+	var mask_goals := DecimalArray.create(0)
+	for i in 21:
+		mask_values.append(Decimal.from_float(i * 10.0 - 50.0))
+		mask_goals.append(Decimal.from_float(100.0 - i * 7.0))
+	mask_values.set_at(3, Decimal.from_float(NAN))
+	mask_goals.set_at(4, Decimal.from_float(-INF))
+
+	# bit for bit the same as calling Decimal.ge() on every element
+	var ge_bits := DecimalArray.ge_mask(mask_values, mask_goals)
+	var ge_scalar_bits := DecimalArray.ge_scalar_mask(mask_values, Decimal.from_float(25.0))
+	var le_scalar_bits := DecimalArray.le_scalar_mask(mask_values, Decimal.from_float(25.0))
+	t.assert_equal(ge_bits.size(), 3)
+	var masks_match := true
+	var ge_count := 0
+	for i in mask_values.size():
+		var ge_bit := ge_bits[i >> 3] & (1 << (i & 7)) != 0
+		if ge_bit != Decimal.ge(mask_values.get_at(i), mask_goals.get_at(i)):
+			masks_match = false
+		if (ge_scalar_bits[i >> 3] & (1 << (i & 7)) != 0) != Decimal.ge(mask_values.get_at(i), Decimal.from_float(25.0)):
+			masks_match = false
+		if (le_scalar_bits[i >> 3] & (1 << (i & 7)) != 0) != Decimal.le(mask_values.get_at(i), Decimal.from_float(25.0)):
+			masks_match = false
+		if ge_bit:
+			ge_count += 1
+	t.assert_true(masks_match)
+
+	# the unused bits of the last byte stay clear
+	t.assert_equal(ge_scalar_bits[2] >> 5, 0)
+
+	t.assert_equal(DecimalArray.mask_count(ge_bits), ge_count)
+	t.assert_equal(DecimalArray.mask_count(PackedByteArray([0xFF, 0x01, 0x80])), 10)
+	t.assert_equal(DecimalArray.mask_find(PackedByteArray([0x00, 0x14])), 10)
+	t.assert_equal(DecimalArray.mask_find(PackedByteArray([0x00, 0x14]), 11), 12)
+	t.assert_equal(DecimalArray.mask_find(PackedByteArray([0x00, 0x14]), 13), -1)
+	t.assert_equal(DecimalArray.mask_find(PackedByteArray()), -1)
+	t.assert_equal(DecimalArray.ge_mask(DecimalArray.create(0), DecimalArray.create(0)).size(), 0)
+
+
+	# ==========================================
+	# 34. STATS TESTS
+	# ==========================================
+	print("Testing stats counters...")
+
+	DecimalStats.reset()
+	if DecimalStats.is_available():
+		t.assert_true(DecimalStats.is_enabled())
+		Decimal.add(Decimal.from_float(1.0), Decimal.from_float(1e30))
+		Decimal.add(Decimal.from_float(2.0), Decimal.from_float(3.0))
+		Decimal.div(Decimal.from_float(1.0), Decimal.from_float(0.0))
+		var stats := DecimalStats.snapshot()
+		t.assert_equal(stats["calls"]["add"], 2)
+		t.assert_true(stats["total_calls"] >= 3)
+		t.assert_true(stats["add_early_exits"] >= 1)
+		t.assert_true(stats["normalize"] >= 1)
+
+		# paused counters stay where they are
+		DecimalStats.set_enabled(false)
+		Decimal.add(Decimal.from_float(2.0), Decimal.from_float(3.0))
+		t.assert_equal(DecimalStats.snapshot()["calls"]["add"], 2)
+		DecimalStats.set_enabled(true)
+
+		DecimalStats.reset()
+		t.assert_equal(DecimalStats.snapshot()["total_calls"], 0)
+	else:
+		t.assert_true(not DecimalStats.is_enabled())
+		Decimal.add(Decimal.from_float(2.0), Decimal.from_float(3.0))
+		var stats := DecimalStats.snapshot()
+		t.assert_equal(stats["total_calls"], 0)
+		t.assert_equal(stats["calls"].size(), 0)
+
+
+	# ==========================================
+	# 35. PRECISION TESTS
+	# ==========================================
+	print("Testing alternate precisions...")
+
+	var prec_values := DecimalArray.create(0)
+	prec_values.append(Decimal.from_float(1.5))
+	prec_values.append(Decimal.from_float(-2.25e40))
+	prec_values.append(Decimal.from_string("3e1000000"))
+	prec_values.append(Decimal.from_float(0.0))
+
+	# simple values make it through both ways unchanged
+	var prec32 := DecimalArray32.from_decimals(prec_values)
+	var prec128 := DecimalArray128.from_decimals(prec_values)
+	t.assert_equal(prec32.size(), 4)
+	t.assert_equal(prec128.size(), 4)
+	for i in prec_values.size():
+		t.assert_true(Decimal.eq(prec32.get_at(i), prec_values.get_at(i)))
+		t.assert_true(Decimal.eq(prec128.get_at(i), prec_values.get_at(i)))
+	t.assert_equal(prec32.get_data().size(), 4 * 16)
+	t.assert_equal(prec128.get_data().size(), 4 * 24)
+
+	# the float mantissa keeps about 7 digits
+	prec32.set_at(0, Decimal.from_float(1.23456789))
+	t.assert_true(Decimal.eq_tolerance_rel(prec32.get_at(0), Decimal.from_float(1.23456789), Decimal.from_float(1e-7)))
+	t.assert_true(Decimal.ne(prec32.get_at(0), Decimal.from_float(1.23456789)))
+
+	var prec_out := DecimalArray128.create(0)
+	DecimalArray128.mul(prec128, prec128, prec_out)
+	t.assert_true(Decimal.eq(prec_out.get_at(1), Decimal.from_float(5.0625e80)))
+	DecimalArray128.div(prec128, prec128, prec_out)
+	t.assert_true(Decimal.eq(prec_out.get_at(0), Decimal.from_float(1.0)))
+
+	# a million small additions that regular decimals round away one by one
+	var prec_balance := DecimalArray.create(1)
+	prec_balance.fill(Decimal.from_float(1e15))
+	var prec_income := DecimalArray.create(1)
+	prec_income.fill(Decimal.from_float(1.1))
+	var prec_balance128 := DecimalArray128.from_decimals(prec_balance)
+	var prec_income128 := DecimalArray128.from_decimals(prec_income)
+	for i in 1000:
+		DecimalArray.add(prec_balance, prec_income, prec_balance)
+		DecimalArray128.add(prec_balance128, prec_income128, prec_balance128)
+	t.assert_true(Decimal.eq(prec_balance.get_at(0), Decimal.from_float(1e15)))
+	t.assert_true(Decimal.eq_tolerance_rel(prec_balance128.get_at(0), Decimal.from_float(1e15 + 1100.0), Decimal.from_float(1e-15)))
+
+	var prec_sum_values := DecimalArray.create(1000)
+	prec_sum_values.fill(Decimal.from_float(0.1))
+	t.assert_true(Decimal.eq_tolerance_rel(DecimalArray128.sum(DecimalArray128.from_decimals(prec_sum_values)), Decimal.from_float(100.0), Decimal.from_float(1e-15)))
+	t.assert_true(Decimal.eq_tolerance_rel(DecimalArray32.sum(DecimalArray32.from_decimals(prec_sum_values)), Decimal.from_float(100.0), Decimal.from_float(1e-4)))
+
+	# adding to a zero keeps every digit of the other side
+	var prec_small := DecimalArray.from_array([Decimal.from_float(1.2345678e-5)])
+	var prec_zeros := DecimalArray.create(1)
+	var prec_small32 := DecimalArray32.from_decimals(prec_small)
+	var prec_out32 := DecimalArray32.create(0)
+	DecimalArray32.add(DecimalArray32.from_decimals(prec_zeros), prec_small32, prec_out32)
+	t.assert_equal(prec_out32.get_at(0), prec_small32.get_at(0))
+	var prec_small128 := DecimalArray128.from_decimals(prec_small)
+	DecimalArray128.add(prec_small128, DecimalArray128.from_decimals(prec_zeros), prec_out)
+	t.assert_equal(prec_out.get_at(0), prec_small128.get_at(0))
+	t.assert_equal(DecimalArray32.sum(prec_small32), prec_small32.get_at(0))
+	t.assert_equal(DecimalArray128.sum(prec_small128), prec_small128.get_at(0))
+
+
+	# ==========================================
+	# 36. COMPACT TESTS
+	# ==========================================
+	print("Testing compact arrays...")
+
+	var compact_values := DecimalArray.create(0)
+	compact_values.append(Decimal.from_float(1.5))
+	compact_values.append(Decimal.from_float(-2.25e40))
+	compact_values.append(Decimal.from_string("3e1000000"))
+	compact_values.append(Decimal.from_float(0.0))
+	compact_values.append(Decimal.from_float(1.23456789))
+	compact_values.append(Decimal.from_string("3e3000000000"))
+	compact_values.append(Decimal.from_string("-3e-3000000000"))
+
+	var compact8 := DecimalCompactArray.from_decimals(compact_values)
+	var compact12 := DecimalCompactArray.from_decimals(compact_values, DecimalCompactArray.FORMAT_12)
+	t.assert_equal(compact8.get_format(), DecimalCompactArray.FORMAT_8)
+	t.assert_equal(compact12.get_format(), DecimalCompactArray.FORMAT_12)
+	t.assert_equal(compact8.size(), 7)
+	t.assert_equal(compact8.get_data().size(), 7 * 8)
+	t.assert_equal(compact12.get_data().size(), 7 * 12)
+
+	# only what doesn't fit in the format changes
+	t.assert_equal(DecimalCompactArray.count_inexact(compact_values, DecimalCompactArray.FORMAT_12), 2)
+	t.assert_equal(DecimalCompactArray.count_inexact(compact_values, DecimalCompactArray.FORMAT_8), 3)
+	for i in 5:
+		t.assert_true(Decimal.eq(compact12.get_at(i), compact_values.get_at(i)))
+		t.assert_true(Decimal.eq_tolerance_rel(compact8.get_at(i), compact_values.get_at(i), Decimal.from_float(1e-7)))
+	t.assert_true(not Decimal.is_finite(compact12.get_at(5)))
+	t.assert_true(Decimal.get_mantissa(compact12.get_at(5)) > 0.0)
+	t.assert_true(Decimal.eq(compact12.get_at(6), Decimal.from_float(0.0)))
+
+	var compact_back := compact12.to_decimals()
+	t.assert_equal(compact_back.size(), 7)
+	t.assert_true(Decimal.eq(compact_back.get_at(2), Decimal.from_string("3e1000000")))
+
+	# scans give the same answers as on regular decimals
+	var compact_x := Decimal.from_float(1.5)
+	var compact_mask := DecimalCompactArray.ge_scalar_mask(compact12, compact_x)
+	for i in 5:
+		t.assert_equal(compact_mask[i >> 3] & (1 << (i & 7)) != 0, Decimal.ge(compact_values.get_at(i), compact_x))
+	compact_mask = DecimalCompactArray.le_scalar_mask(compact8, compact_x)
+	t.assert_equal(DecimalArray.mask_count(compact_mask), 5)
+	t.assert_equal(DecimalCompactArray.max_index(compact12), 5)
+	t.assert_equal(DecimalCompactArray.max_index(DecimalCompactArray.create(0)), -1)
+
+	var compact_sum_values := DecimalArray.create(1000)
+	compact_sum_values.fill(Decimal.from_float(0.1))
+	var compact_sum := DecimalCompactArray.from_decimals(compact_sum_values, DecimalCompactArray.FORMAT_12)
+	t.assert_true(Decimal.eq_tolerance_rel(DecimalCompactArray.sum(compact_sum), Decimal.from_float(100.0), Decimal.from_float(1e-15)))
+
+	var compact_out := DecimalCompactArray.create(0)
+	DecimalCompactArray.mul_num(compact_sum, 3.0, compact_out)
+	DecimalCompactArray.add(compact_out, compact_sum, compact_out)
+	t.assert_equal(compact_out.get_format(), DecimalCompactArray.FORMAT_12)
+	t.assert_true(Decimal.eq_tolerance_rel(compact_out.get_at(999), Decimal.from_float(0.4), Decimal.from_float(1e-15)))
+	DecimalCompactArray.sub(compact_out, compact_sum, compact_out)
+	DecimalCompactArray.mul(compact_out, compact_sum, compact_out)
+	t.assert_true(Decimal.eq_tolerance_rel(compact_out.get_at(0), Decimal.from_float(0.03), Decimal.from_float(1e-15)))
+
+
+	# ==========================================
+	# 37. POW10 / LOG10 ACCURACY TESTS
+	# ==========================================
+	print("Testing pow10 and log10 accuracy...")
+
+	# Fast math builds swap libm out for decimal_fastmath.hpp, which promises
+	# to stay within 1 ulp of the exact result. Either way, pow10_num() and
+	# log10() have to agree with libm to a few ulps over the whole mantissa
+	# range (libm itself, and the division in the log10 reference, add some).
+	const ULP := 2.220446049250313e-16
+	var pow10_bad := 0
+	var log10_bad := 0
+	for i in 20000:
+		var f := (i + 0.5) / 20000.0
+
+		# pow10_num() of x, with x + 7 and x - 3 (the reference inputs) exact
+		var x := f - 7.0
+		var p := Decimal.pow10_num(x)
+		var ref := pow(10.0, x + 7.0)
+		if Decimal.get_exponent(p) != -7 or absf(Decimal.get_mantissa(p) - ref) > 2.0 * ULP * ref:
+			pow10_bad += 1
+		x = f + 3.0
+		p = Decimal.pow10_num(x)
+		ref = pow(10.0, x - 3.0)
+		if Decimal.get_exponent(p) != 3 or absf(Decimal.get_mantissa(p) - ref) > 2.0 * ULP * ref:
+			pow10_bad += 1
+
+		var m := 1.0 + 9.0 * f
+		ref = log(m) / log(10.0)
+		if absf(Decimal.log10(Decimal.from_float(m)) - ref) > 4.0 * ULP * ref:
+			log10_bad += 1
+	t.assert_equal(pow10_bad, 0)
+	t.assert_equal(log10_bad, 0)
+
+	# the ends of the ranges
+	t.assert_true(Decimal.eq(Decimal.pow10_num(-1e-300), Decimal.from_float(1.0)))
+	t.assert_true(Decimal.eq(Decimal.pow10_num(5.0), Decimal.from_float(1e5)))
+	t.assert_true(Decimal.eq(Decimal.pow10_num(-3.0), Decimal.from_parts(1, -3)))
+	t.assert_equal(Decimal.log10(Decimal.from_float(1.0)), 0.0)
+	t.assert_equal(Decimal.log10(Decimal.from_parts(1, 42)), 42.0)
+	t.assert_true(Decimal.log10(Decimal.from_float(9.999999999999998)) < 1.0)
+	t.assert_true(is_nan(Decimal.log10(Decimal.from_float(-5.0))))
+
+
+	# ==========================================
+	# 38. PRICE TABLE TESTS
+	# ==========================================
+	print("Testing price tables...")
+
+	var table_start := Decimal.from_float(10)
+	var table_ratio := Decimal.from_float(1.15)
+	var table := PriceTable.create_geometric(table_start, table_ratio, 1000)
+	t.assert_equal(table.get_limit(), 1000)
+	t.assert_equal(table.get_filled(), 0)
+	t.assert_true(Decimal.eq_tolerance_rel(table.price_of(3), Decimal.mul(table_start, Decimal.pow_num(table_ratio, 3)), Decimal.from_float(1e-15)))
+
+	# only as much of the table as the queries need gets filled
+	var table_cost := table.cost_of(37, 5)
+	t.assert_equal(table.get_filled(), 128)
+	t.assert_true(Decimal.eq_tolerance_rel(table_cost, Decimal.sum_geometric_series(37, table_start, table_ratio, 5), Decimal.from_float(1e-14)))
+	table.fill(600)
+	t.assert_equal(table.get_filled(), 640)
+	table.fill(5000)
+	t.assert_equal(table.get_filled(), 1000)
+
+	# a few items on top of a lot already bought, no digits lost
+	t.assert_true(Decimal.eq_tolerance_rel(table.cost_of(1, 900), table.price_of(900), Decimal.from_float(1e-15)))
+
+	# exact counts right at the boundary
+	t.assert_equal(table.max_affordable(table_cost, 5), 37)
+	t.assert_equal(table.max_affordable(Decimal.add(table_cost, Decimal.mul_num(table.price_of(42), 0.5)), 5), 37)
+	t.assert_equal(table.max_affordable(Decimal.from_float(0), 5), 0)
+
+	# past the end of the table, the closed forms take over
+	var short_table := PriceTable.create_geometric(table_start, table_ratio, 50)
+	t.assert_equal(short_table.max_affordable(Decimal.from_parts(1, 30), 0), Decimal.afford_geometric_series(Decimal.from_parts(1, 30), table_start, table_ratio, 0))
+	t.assert_true(Decimal.eq(short_table.cost_of(10, 60), Decimal.sum_geometric_series(10, table_start, table_ratio, 60)))
+
+	# flat prices
+	var flat_table := PriceTable.create_geometric(Decimal.from_float(5), Decimal.from_float(1), 100)
+	t.assert_true(Decimal.eq(flat_table.cost_of(10, 3), Decimal.from_float(50)))
+	t.assert_equal(flat_table.max_affordable(Decimal.from_float(52), 0), 10)
+	# which have no closed form to fall back to past the table
+	var short_flat := PriceTable.create_geometric(Decimal.from_float(5), Decimal.from_float(1), 10)
+	t.assert_true(Decimal.eq(short_flat.cost_of(5, 20), Decimal.from_float(25)))
+	t.assert_equal(short_flat.max_affordable(Decimal.from_float(500), 0), 100)
+	t.assert_equal(short_flat.max_affordable(Decimal.from_float(500), 20), 100)
+	var flat_arith := PriceTable.create_arithmetic(Decimal.from_float(5), zero, 10)
+	t.assert_true(Decimal.eq(flat_arith.cost_of(5, 20), Decimal.from_float(25)))
+	t.assert_equal(flat_arith.max_affordable(Decimal.from_float(500), 0), 100)
+	t.assert_equal(flat_arith.max_affordable(Decimal.from_float(500), 20), 100)
+
+	# prices far below 1
+	var tiny_table := PriceTable.create_geometric(Decimal.from_parts(1.23, -40), Decimal.from_float(1.07))
+	t.assert_true(Decimal.eq_tolerance_rel(tiny_table.cost_of(1, 0), Decimal.from_parts(1.23, -40), Decimal.from_float(1e-15)))
+	t.assert_equal(tiny_table.max_affordable(Decimal.from_parts(1, -39), 0), 6)
+
+	# decaying prices would vanish into the totals, so they aren't taken
+	t.assert_true(PriceTable.create_geometric(Decimal.from_float(1), Decimal.from_float(0.5)) == null)
+	t.assert_true(PriceTable.create_geometric(Decimal.from_float(1), Decimal.from_float(0.93)) == null)
+	t.assert_true(PriceTable.create_geometric(Decimal.from_float(1), Decimal.from_float(-2)) == null)
+
+	# arithmetic prices
+	var arith_table := PriceTable.create_arithmetic(Decimal.from_float(10), Decimal.from_float(5))
+	var arith_cost := Decimal.sum_arithmetic_series(Decimal.from_float(6), Decimal.from_float(10), Decimal.from_float(5), Decimal.from_float(4))
+	t.assert_true(Decimal.eq_tolerance_rel(arith_table.cost_of(6, 4), arith_cost, Decimal.from_float(1e-15)))
+	t.assert_equal(arith_table.max_affordable(Decimal.from_float(255), 4), 6)
+	t.assert_equal(arith_table.max_affordable(Decimal.from_float(254), 4), 5)
+
+	# prices running off to infinity end the table early
+	var steep_table := PriceTable.create_geometric(Decimal.from_float(5), Decimal.from_parts(1, 1000000000000000000), 100)
+	t.assert_equal(steep_table.max_affordable(Decimal.from_parts(1, 9200000000000000000), 0), 10)
+	t.assert_equal(steep_table.get_limit(), 10)
+	t.assert_false(Decimal.is_finite(steep_table.cost_of(100, 0)))
+
+
+	# ==========================================
+	# 39. STAT GRAPH TESTS
+	# ==========================================
+	print("Testing stat graphs...")
+
+	var stats := StatGraph.new()
+	var stat_owned := stats.add_source("owned", Decimal.from_float(3))
+	var stat_base := stats.add_source("base", Decimal.from_float(10))
+	var stat_mult := stats.add_source("mult", Decimal.from_float(2))
+	var stat_income := stats.add_formula("income", "base * mult * owned")
+	var stat_cost := stats.add_formula("cost", "base * 1.15^owned")
+	var stat_total := stats.add_formula("total", "income + cost + income")
+	t.assert_equal(stats.size(), 6)
+	t.assert_equal(stats.find("cost"), stat_cost)
+	t.assert_equal(stats.find("nope"), -1)
+	t.assert_true(stats.is_source(stat_base))
+	t.assert_false(stats.is_source(stat_income))
+
+	# nothing is computed until it's read
+	t.assert_true(stats.is_dirty(stat_total))
+	t.assert_equal(stats.get_evaluation_count(), 0)
+	var stat_expected := Decimal.add(Decimal.from_float(120), Decimal.mul(Decimal.from_float(10), Decimal.pow_num(Decimal.from_float(1.15), 3)))
+	t.assert_true(Decimal.eq_tolerance_rel(stats.get_value(stat_total), stat_expected, Decimal.from_float(1e-15)))
+	t.assert_equal(stats.get_evaluation_count(), 3)
+	stats.get_value(stat_total)
+	t.assert_equal(stats.get_evaluation_count(), 3)
+
+	# only what depends on a changed source gets recomputed
+	stats.set_value(stat_mult, Decimal.from_float(4))
+	t.assert_true(stats.is_dirty(stat_income))
+	t.assert_false(stats.is_dirty(stat_cost))
+	t.assert_true(stats.is_dirty(stat_total))
+	t.assert_true(Decimal.eq(stats.get_value(stat_income), Decimal.from_float(120)))
+	t.assert_equal(stats.get_evaluation_count(), 4)
+	t.assert_true(stats.is_dirty(stat_total))
+	stats.update()
+	t.assert_false(stats.is_dirty(stat_total))
+	t.assert_equal(stats.get_evaluation_count(), 5)
+
+	# setting the same value again changes nothing
+	stats.set_value(stat_mult, Decimal.from_float(4))
+	t.assert_false(stats.is_dirty(stat_total))
+
+	# batch reads and writes
+	stats.set_values(PackedInt64Array([stat_owned, stat_base]), DecimalArray.from_array([Decimal.from_float(1), Decimal.from_float(5)]))
+	var stat_out := DecimalArray.create(0)
+	stats.get_values(PackedInt64Array([stat_income, stat_cost, stat_owned]), stat_out)
+	t.assert_equal(stat_out.size(), 3)
+	t.assert_true(Decimal.eq(stat_out.get_at(0), Decimal.from_float(20)))
+	t.assert_true(Decimal.eq_tolerance_rel(stat_out.get_at(1), Decimal.from_float(5.75), Decimal.from_float(1e-15)))
+	t.assert_true(Decimal.eq(stat_out.get_at(2), Decimal.from_float(1)))
+	t.assert_equal(stats.get_evaluation_count(), 7)
+
+	# bad names and formulas
+	t.assert_equal(stats.add_source("owned"), -1)
+	t.assert_equal(stats.add_source("two words"), -1)
+	t.assert_equal(stats.add_formula("broken", "income * later"), -1)
+	t.assert_true(stats.get_error_text().begins_with("Unknown variable."))
+	t.assert_equal(stats.add_formula("broken", "(income"), -1)
+	t.assert_equal(stats.size(), 6)
+	stats.set_value(stat_income, Decimal.from_float(1))
+	t.assert_true(Decimal.eq(stats.get_value(stat_income), Decimal.from_float(20)))
+
+	# a long chain is still worked out in order (every step rounds, hence the
+	# looser tolerance)
+	var chain := StatGraph.new()
+	chain.add_source("n0", Decimal.from_float(1))
+	for i in 1000:
+		chain.add_formula("n%d" % (i + 1), "n%d * 2" % i)
+	t.assert_true(Decimal.eq_tolerance_rel(chain.get_value(1000), Decimal.from_parts(1.0715086071862673, 301), Decimal.from_float(1e-13)))
+	chain.set_value(0, Decimal.from_float(3))
+	t.assert_true(Decimal.eq_tolerance_rel(chain.get_value(1000), Decimal.from_parts(3.2145258215588019, 301), Decimal.from_float(1e-13)))
+	t.assert_equal(chain.get_evaluation_count(), 2000)
+	chain.clear()
+	t.assert_equal(chain.size(), 0)